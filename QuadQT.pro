@@ -5,6 +5,8 @@ CONFIG(release, debug|release) {
     # Release 모드일 때 적용될 설정
     DESTDIR     = $$OUT_PWD/release
     OBJECTS_DIR = $$OUT_PWD/release/.obj
+    # qDebug/qCDebug 는 릴리스 빌드에서 컴파일되지 않음 (경고 이상만 남김)
+    DEFINES    += QT_NO_DEBUG_OUTPUT
 } else {
     # Debug 모드일 때 적용될 설정
     DESTDIR     = $$OUT_PWD/debug
@@ -16,9 +18,11 @@ CONFIG(release, debug|release) {
 
 
 
-QT       += core gui network widgets mqtt multimedia multimediawidgets
+QT       += core gui network widgets mqtt multimedia multimediawidgets concurrent
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 CONFIG += c++17
+# 릴리스에서도 로그 위치(파일:줄)를 남겨 위치별 로그 속도 제한에 사용
+DEFINES += QT_MESSAGELOGCONTEXT
 
 # Qt의 내장 SSL 지원 사용 (OpenSSL 라이브러리 직접 링크 제거)
 # Windows에서는 Qt가 OpenSSL을 동적으로 로드합니다
@@ -38,27 +42,57 @@ LIBS += -LC:/opencv/OpenCV-MinGW-Build/x64/mingw/lib \
     -lopencv_imgproc455 \
     -lopencv_highgui455
 
+# 진단 페이지의 프로세스 메모리 조회 (GetProcessMemoryInfo)
+win32: LIBS += -lpsapi
+
 # ====== SOURCES (.cpp) ======
 SOURCES += \
     main.cpp \
     src/login/custommessagebox.cpp \
     src/login/loginpage.cpp \
     src/login/networkmanager.cpp \
+    src/mainwindow/diagnosticspage.cpp \
     src/mainwindow/displaysettingbox.cpp \
     src/mainwindow/compareimageview.cpp \
+    src/mainwindow/evidenceexport.cpp \
     src/mainwindow/filenameutils.cpp \
     src/mainwindow/getimageview.cpp \
+    src/mainwindow/historyexport.cpp \
+    src/mainwindow/historyquery.cpp \
+    src/mainwindow/historystore.cpp \
+    src/mainwindow/historystreamparser.cpp \
     src/mainwindow/historyview.cpp \
+    src/mainwindow/historywire.cpp \
+    src/mainwindow/iconcache.cpp \
+    src/mainwindow/imagedecoder.cpp \
+    src/mainwindow/imagediff.cpp \
+    src/mainwindow/imagefetchpool.cpp \
+    src/mainwindow/imageinspector.cpp \
+    src/mainwindow/latencypanel.cpp \
+    src/mainwindow/latencytracker.cpp \
+    src/mainwindow/logging.cpp \
     src/mainwindow/mainwindow.cpp \
+    src/mainwindow/metricsregistry.cpp \
+    src/mainwindow/mqttevent.cpp \
     src/mainwindow/mqttmanager.cpp \
-    src/mainwindow/notificationitem.cpp \
+    src/mainwindow/notificationdelegate.cpp \
+    src/mainwindow/notificationmodel.cpp \
     src/mainwindow/notificationpanel.cpp \
     src/mainwindow/overlaywidget.cpp \
+    src/mainwindow/pdfreport.cpp \
+    src/mainwindow/platesearchindex.cpp \
     src/mainwindow/procsettingbox.cpp \
     src/mainwindow/rtspthread.cpp \
+    src/mainwindow/stallwatchdog.cpp \
+    src/mainwindow/startuptrace.cpp \
     src/mainwindow/tcphistoryhandler.cpp \
     src/mainwindow/tcpimagehandler.cpp \
-    src/mainwindow/topbarwidget.cpp
+    src/mainwindow/tlscontext.cpp \
+    src/mainwindow/topbarwidget.cpp \
+    src/mainwindow/topicrouter.cpp \
+    src/mainwindow/viewerutils.cpp \
+    src/mainwindow/wirecompression.cpp \
+    src/mainwindow/ziparchivewriter.cpp
 
 # ====== HEADERS (.h) ======
 HEADERS += \
@@ -66,20 +100,49 @@ HEADERS += \
     include/login/loginpage.h \
     include/login/networkmanager.h \
     include/mainwindow/compareimageview.h \
+    include/mainwindow/diagnosticspage.h \
     include/mainwindow/displaysettingbox.h \
+    include/mainwindow/evidenceexport.h \
     include/mainwindow/filenameutils.h \
     include/mainwindow/getimageview.h \
+    include/mainwindow/historydecoder.h \
+    include/mainwindow/historyexport.h \
+    include/mainwindow/historyquery.h \
+    include/mainwindow/historystore.h \
+    include/mainwindow/historystreamparser.h \
     include/mainwindow/historyview.h \
+    include/mainwindow/historywire.h \
+    include/mainwindow/iconcache.h \
+    include/mainwindow/imagedecoder.h \
+    include/mainwindow/imagediff.h \
+    include/mainwindow/imagefetchpool.h \
+    include/mainwindow/imageinspector.h \
+    include/mainwindow/latencypanel.h \
+    include/mainwindow/latencytracker.h \
+    include/mainwindow/logging.h \
     include/mainwindow/mainwindow.h \
+    include/mainwindow/metricsregistry.h \
+    include/mainwindow/mqttevent.h \
     include/mainwindow/mqttmanager.h \
-    include/mainwindow/notificationitem.h \
+    include/mainwindow/notificationdelegate.h \
+    include/mainwindow/notificationmodel.h \
     include/mainwindow/notificationpanel.h \
     include/mainwindow/overlaywidget.h \
+    include/mainwindow/pdfreport.h \
+    include/mainwindow/platesearchindex.h \
     include/mainwindow/procsettingbox.h \
     include/mainwindow/rtspthread.h \
+    include/mainwindow/spscqueue.h \
+    include/mainwindow/stallwatchdog.h \
+    include/mainwindow/startuptrace.h \
     include/mainwindow/tcphistoryhandler.h \
     include/mainwindow/tcpimagehandler.h \
-    include/mainwindow/topbarwidget.h
+    include/mainwindow/tlscontext.h \
+    include/mainwindow/topbarwidget.h \
+    include/mainwindow/topicrouter.h \
+    include/mainwindow/viewerutils.h \
+    include/mainwindow/wirecompression.h \
+    include/mainwindow/ziparchivewriter.h
 
 # ====== FORMS (.ui) ======
 FORMS += \
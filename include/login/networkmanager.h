@@ -16,6 +16,8 @@
 #include <QFile>
 #include <QDir>
 #include <QCoreApplication>
+#include "mainwindow/wirecompression.h"
+#include "mainwindow/metricsregistry.h"
 
 class NetworkManager : public QObject
 {
@@ -84,20 +86,37 @@ private slots:
     void onTimeout();
     void onSslErrors(const QList<QSslError> &errors);
     void onEncrypted();
+    void onHelloTimeout();
 
 private:
     void loadConfig();
     QJsonObject parseResponse(const QString &response);
     QString findCertificateFile(const QString &filename);
     QString findConfigFile();
+    void sendHello();
+    static bool isHelloReply(const QJsonObject &response);
 
     QSslSocket *m_socket;
     QTimer *m_timeoutTimer;
+    QTimer *m_helloTimer;       // HELLO 응답 대기
     QString m_serverIp;
     int m_serverPort;
     int m_timeout;
     QString m_pendingCommand;
-    QString m_responseBuffer;
+    QByteArray m_responseBuffer;
+
+    // 응답 압축 협상
+    WireFrameReader m_wireReader;
+    int m_compressMinBytes;
+    bool m_helloPending;        // HELLO 응답 대기 중 (시간 초과 전)
+    bool m_helloUnanswered;     // HELLO 응답을 아직 보지 못함 (시간 초과 뒤에도 유지)
+    qint64 m_helloStartUs = 0;
+    static constexpr int HelloTimeoutMs = 2000;
+
+    // 응답 시간 측정 (응답을 기다리는 명령은 한 번에 하나)
+    MetricsRegistry::Timing m_commandTiming = MetricsRegistry::TcpOther;
+    qint64 m_commandStartUs = 0;
+    qint64 m_handshakeStartUs = 0;
     
     // SSL 관련 멤버 변수
     bool m_sslEnabled;
@@ -12,8 +12,13 @@
 #include <QPdfWriter>
 #include <QPageSize>
 #include <QPainter>
+#include <QPointer>
+#include <QTableWidgetItem>
+#include <QCache>
+#include "imagediff.h"
 
 class OverlayWidget;
+class ImageInspector;
 
 class CompareImageView : public QDialog {
     Q_OBJECT
@@ -23,8 +28,13 @@ public:
 
     void setStartImageData(const QByteArray& data);
     void setEndImageData(const QByteArray& data);
+    /// 다른 레코드 표시 (위젯은 그대로 두고 내용만 교체)
+    void rebind(const QString& event, const QString& plate, const QString& datetime,
+                const QString& startFilename, const QString& endFilename);
 
 signals:
+    /// 키보드로 이전(-1)/다음(+1) 레코드 요청
+    void navigateRequested(int step);
     void downloadRequested();
     void printRequested();
 
@@ -32,14 +42,24 @@ private slots:
     void downloadStartImage();
     void downloadEndImage();
     void printToPdf();
+    void toggleDiff(bool on);
 
 protected:
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void showEvent(QShowEvent* event) override;
     void hideEvent(QHideEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private:
+    void openInspector(bool end);
+    void updateDiff();
+    void refreshEndLabel();
+
+    QTableWidgetItem* leftPlateValItem_;
+    QTableWidgetItem* leftTimeValItem_;
+    QTableWidgetItem* rightPlateValItem_;
+    QTableWidgetItem* rightTimeValItem_;
     QLabel* startImageLabel_;
     QLabel* endImageLabel_;
     QLabel* startFilenameLabel_;
@@ -47,20 +67,34 @@ private:
     QPushButton* downloadButton1_;
     QPushButton* downloadButton2_;
     QPushButton* printButton_;
+    QPushButton* diffButton_;
     QPushButton* closeButton_;
     
     QString startFilename_;
     QString endFilename_;
     QString eventType_;       // 이벤트 타입 저장
+    QString plate_;           // PDF 보고서용
+    QString datetime_;
     QByteArray startImageData_;
     QByteArray endImageData_;
+    int startDecodeSeq_ = 0;  // 마지막으로 요청한 디코딩 번호
+    int endDecodeSeq_ = 0;
+    QPixmap endPixmap_;       // 1분 경과 축소 이미지 (차이 보기 해제 시 복원용)
+
+    // 차이 보기: 이미지 쌍(시작|종료 파일명)별 결과 캐시
+    QCache<QString, ImageDiff::Result> diffCache_;
+    int diffSeq_ = 0;
     
     // 창 드래그를 위한 변수
     QPoint dragPosition_;
     bool dragging_;
     
     // 오버레이 효과
-    OverlayWidget* overlay_;
+    QPointer<OverlayWidget> overlay_;
+
+    // 원본 해상도 확대 보기 (이미지 더블클릭 시 생성)
+    QPointer<ImageInspector> inspector_;
+    bool inspectorShowsEnd_ = false;
     
     // 파일명에서 시간 파싱하는 함수
     QString parseEndFilenameTimestamp(const QString& filename);
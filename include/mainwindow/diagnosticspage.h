@@ -0,0 +1,75 @@
+// diagnosticspage.h
+#ifndef DIAGNOSTICSPAGE_H
+#define DIAGNOSTICSPAGE_H
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QTimer>
+#include "metricsregistry.h"
+
+class QPlainTextEdit;
+class QTableWidget;
+class LatencyPanel;
+class MqttManager;
+
+/// 성능 진단 페이지 (F12).
+/// 보이는 동안에만 MetricsRegistry 수집을 켜고 1초마다 값을 갱신한다.
+/// 페이지를 닫으면 수집이 꺼져 각 측정 지점은 플래그 확인만 한다.
+class DiagnosticsPage : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPage(QWidget *parent = nullptr);
+    ~DiagnosticsPage();
+
+    /// MQTT 재연결 통계를 읽을 관리자 (수집 여부와 무관하게 누적된 값)
+    void setMqttManager(const MqttManager *manager) { mqttManager_ = manager; }
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refresh();
+    void probeEventLoop();
+
+private:
+    enum Row {
+        RtspFpsRow,
+        RtspDroppedRow,
+        RtspReadFailuresRow,
+        ImageCacheRow,
+        MqttRateRow,
+        MqttDroppedRow,
+        MqttLastReconnectRow,
+        MqttRecoveredRow,
+        WireTrafficRow,
+        WireCompressionRow,
+        MemoryRow,
+        CpuRow,
+        FixedRowCount       // 이후 행은 MetricsRegistry::Timing 순서
+    };
+
+    static constexpr int RefreshIntervalMs = 1000;
+    static constexpr int LagProbeIntervalMs = 100;
+
+    void setValue(int row, const QString &text);
+    void refreshStallReport();
+
+    QTableWidget   *table_;
+    QPlainTextEdit *stallReport_;
+    LatencyPanel   *latencyPanel_;
+    const MqttManager *mqttManager_ = nullptr;
+    QTimer          refreshTimer_;
+    QTimer          lagTimer_;
+    QElapsedTimer   lagClock_;
+
+    // 초당 값 계산용 직전 값
+    MetricsRegistry::Snapshot     lastSnapshot_;
+    MetricsRegistry::ProcessUsage lastUsage_;
+    QElapsedTimer                 lastRefresh_;
+    quint64                       lastStallCount_ = ~quint64(0);
+};
+
+#endif // DIAGNOSTICSPAGE_H
@@ -0,0 +1,63 @@
+// evidenceexport.h
+#ifndef EVIDENCEEXPORT_H
+#define EVIDENCEEXPORT_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QThread>
+#include "historystore.h"
+
+class ImageFetchPool;
+class ZipArchiveWriter;
+
+/// 단속 증거 패키지 내보내기.
+/// 레코드가 참조하는 이미지(촬영/정차 시작/1분 경과)를 ImageFetchPool 로 받아
+/// 전용 쓰기 스레드에서 ZIP 에 바로 추가하고, 마지막에 manifest.csv 를 넣는다.
+/// 쓰기가 밀리면 이미지 요청을 잠시 멈춰 메모리에 쌓이는 이미지 수를 제한한다.
+class EvidenceExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EvidenceExporter(QObject *parent = nullptr);
+    ~EvidenceExporter();
+
+    void start(const QString &zipPath, const QList<HistoryRecord> &records,
+               const QString &host, quint16 port);
+    void cancel();
+    bool isRunning() const { return running_; }
+
+signals:
+    void progressChanged(int done, int total, double imagesPerSecond);
+    void finished(const QString &path, int images, int failedImages, double imagesPerSecond);
+    void failed(const QString &error);
+    void canceled();
+
+private:
+    void onImageFetched(const QString &path, const QByteArray &data);
+    void onImageFailed(const QString &path, const QString &error);
+    void onEntryWritten(int job, bool ok, const QString &error);
+    void checkComplete();
+    void finishArchive();
+    void stopWriter();
+
+    ImageFetchPool          *pool_;
+    QThread                  writerThread_;
+    QObject                 *writerContext_;      // 쓰기 스레드에서 실행할 작업의 문맥
+    ZipArchiveWriter        *zip_ = nullptr;      // 쓰기 스레드에서만 접근
+    QList<HistoryRecord>     records_;
+    QHash<QString, QString>  entryNames_;         // 서버 경로 → ZIP 안의 이름
+    QSet<QString>            failedPaths_;
+    QString                  path_;
+    int                      total_ = 0;
+    int                      written_ = 0;
+    int                      backlog_ = 0;        // 쓰기 대기 중인 이미지 수
+    int                      job_ = 0;            // 이전 작업의 늦은 완료 통지를 걸러내기 위한 번호
+    bool                     running_ = false;
+    QElapsedTimer            elapsed_;
+};
+
+#endif // EVIDENCEEXPORT_H
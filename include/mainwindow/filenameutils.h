@@ -2,8 +2,31 @@
 #define FILENAMEUTILS_H
 
 #include <QString>
+#include <QStringView>
+#include <QDate>
+
+/// 파일명에 들어 있는 촬영 시각. 정규식 없이 한 번 훑어서 찾는다
+struct FilenameTimestamp
+{
+    int  year = 0, month = 0, day = 0;
+    int  hour = 0, minute = 0, second = 0;
+    bool valid = false;
+
+    QString toDisplayString() const;   // "yyyy-MM-dd hh:mm:ss"
+    QString toCompactString() const;   // "yyyyMMdd_hhmmss"
+};
+
+// 앞쪽 타임스탬프 (YYYYMMDD_HHMMSS) 중 처음 나오는 것
+FilenameTimestamp findCompactTimestamp(QStringView text);
+// 뒷쪽 타임스탬프 (YYYY-MM-DD_HH-MM-SS) 중 처음 나오는 것
+FilenameTimestamp findDashedTimestamp(QStringView text);
+// 과속감지(preferDashed)면 뒷쪽 우선, 없으면 앞쪽 타임스탬프
+FilenameTimestamp timestampFromFilename(QStringView text, bool preferDashed);
 
 // 파일명 변환 함수 (이벤트 타입 정보 포함)
 QString convertFilename(const QString& originalPath, const QString& eventType = "");
 
-#endif // FILENAMEUTILS_H
\ No newline at end of file
+// 파일명에서 날짜 추출 (YYYY-MM-DD 우선, 없으면 YYYYMMDD). 여러 스레드에서 호출 가능
+QDate dateFromFilename(const QString& filename);
+
+#endif // FILENAMEUTILS_H
@@ -12,8 +12,11 @@
 #include <QPdfWriter>
 #include <QPageSize>
 #include <QPainter>
+#include <QPointer>
+#include <QTableWidget>
 
 class OverlayWidget;
+class ImageInspector;
 
 class GetImageView : public QDialog {
     Q_OBJECT
@@ -22,8 +25,13 @@ public:
                  const QString& filename, QWidget* parent=nullptr);
 
     void setImageData(const QByteArray& data);
+    /// 다른 레코드 표시 (위젯은 그대로 두고 내용만 교체)
+    void rebind(const QString& event, const QString& plate, const QString& datetime,
+                const QString& filename);
 
 signals:
+    /// 키보드로 이전(-1)/다음(+1) 레코드 요청
+    void navigateRequested(int step);
     void downloadRequested();
     void printRequested();
 
@@ -36,8 +44,13 @@ protected:
     void mouseMoveEvent(QMouseEvent* event) override;
     void showEvent(QShowEvent* event) override;
     void hideEvent(QHideEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private:
+    void setInfoRow(int row, const QString& key, const QString& value);
+    void openInspector();
+
+    QTableWidget* infoTable_;
     QLabel* eventLabel_;
     QLabel* plateLabel_;
     QLabel* dateLabel_;
@@ -47,12 +60,19 @@ private:
     QPushButton* printButton_;
     QPushButton* closeButton_;
     QByteArray imageData_;    // 이미지 데이터 저장
+    int decodeSeq_ = 0;       // 마지막으로 요청한 디코딩 번호
     QString eventType_;       // 이벤트 타입 저장
+    QString plate_;           // PDF 보고서용
+    QString datetime_;
+    QString filename_;
     
     // 창 드래그를 위한 변수
     QPoint dragPosition_;
     bool dragging_;
     
     // 오버레이 효과
-    OverlayWidget* overlay_;
+    QPointer<OverlayWidget> overlay_;
+
+    // 원본 해상도 확대 보기 (이미지 더블클릭 시 생성)
+    QPointer<ImageInspector> inspector_;
 };
@@ -0,0 +1,32 @@
+// historydecoder.h
+#ifndef HISTORYDECODER_H
+#define HISTORYDECODER_H
+
+#include <QString>
+#include <QList>
+#include <QJsonObject>
+#include "historystore.h"
+
+/// GET_HISTORY* 응답 디코더 공통 인터페이스 (JSON / 바이너리 wire 형식)
+class HistoryDecoder
+{
+public:
+    virtual ~HistoryDecoder() = default;
+
+    virtual void reset() = 0;
+
+    /// 이어서 디코딩. 응답 하나가 끝나거나 오류가 나면 그 지점까지 소비한 바이트 수를 반환
+    virtual qsizetype feed(const char *data, qsizetype size) = 0;
+
+    virtual bool isComplete() const = 0;
+    virtual bool hasError() const = 0;
+    virtual QString errorString() const = 0;
+
+    /// 지금까지 완성된 레코드를 꺼낸다 (호출 후 비워짐)
+    virtual QList<HistoryRecord> takeRecords() = 0;
+    /// 레코드를 제외한 응답 필드 (status, code, message ...)
+    virtual QJsonObject header() const = 0;
+    virtual int recordCount() const = 0;
+};
+
+#endif // HISTORYDECODER_H
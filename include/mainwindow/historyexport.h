@@ -0,0 +1,87 @@
+// historyexport.h
+#ifndef HISTORYEXPORT_H
+#define HISTORYEXPORT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QFutureWatcher>
+#include <QPromise>
+#include <memory>
+#include "historystore.h"
+#include "historyquery.h"
+
+class QSaveFile;
+class TcpHistoryHandler;
+
+/// 히스토리 CSV 내보내기 (UTF-8 BOM + CRLF, Excel 에서 바로 열림).
+/// 레코드를 청크 단위로 변환해 곧바로 파일에 쓰므로 행 수와 관계없이
+/// 쓰기 버퍼 크기만큼의 메모리만 사용한다. 파일은 QSaveFile 로 쓰여
+/// 취소/실패 시 기존 파일이 그대로 남는다.
+///
+/// startFromServer 는 메모리에 없는 레코드까지 내보낸다. 전용 연결로 GET_HISTORY 를
+/// offset/limit 로 ServerPageRows 씩 받아 조건에 맞는 행만 쓰고 버리며,
+/// 한 페이지의 쓰기가 끝나야 다음 페이지를 요청하므로 메모리는 한 페이지 분량이다.
+class HistoryExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HistoryExporter(QObject *parent = nullptr);
+    ~HistoryExporter();
+
+    /// records 는 암시적 공유 복사라 호출 비용이 거의 없다
+    void start(const QString &path, const QList<HistoryRecord> &records);
+    /// 서버의 email 히스토리 전체에서 filter(유형/날짜)와 번호판 검색어(plateText,
+    /// 부분 일치 + OCR 오인식 허용)에 맞는 행을 서버 순서(최신 순)로 내보낸다.
+    /// 전체 행 수를 미리 알 수 없어 progressChanged 의 total 은 0 이다
+    void startFromServer(const QString &path, const QString &host, quint16 port,
+                         const QString &email, const HistoryQuery &filter, const QString &plateText);
+    void cancel();
+    bool isRunning() const { return watcher_.isRunning() || paging_; }
+
+    static constexpr int ServerPageRows = 1000;
+
+    /// 동기 실행 (작업 스레드에서 호출). 실패하면 오류 메시지, 성공/취소는 빈 문자열
+    static QString write(const QString &path, const QList<HistoryRecord> &records,
+                         QPromise<QString> *promise = nullptr);
+
+    /// RFC 4180 필드 (쉼표/따옴표/줄바꿈이 있으면 따옴표로 감싸고 " 는 "" 로)
+    static void appendField(QByteArray &out, const QString &field);
+    static void appendRow(QByteArray &out, const HistoryRecord &rec);
+
+signals:
+    void progressChanged(int written, int total);
+    void finished(const QString &path, int rows);
+    void failed(const QString &error);
+    void canceled();
+
+private:
+    void requestNextPage();
+    void onPageRecords(const QList<HistoryRecord> &records);
+    void onPageFinished(const QJsonObject &header, int recordCount);
+    void onPageWritten();
+    void failPaging(const QString &error);
+    void finishPaging();
+
+    QFutureWatcher<QString> watcher_;
+    QString path_;
+    int     total_ = 0;
+
+    // 서버 페이지 내보내기 (GUI 스레드에서 받고, 쓰기만 작업 스레드)
+    TcpHistoryHandler         *source_ = nullptr;   // 전용 연결 (처음 쓸 때 만든다)
+    QFutureWatcher<QString>    pageWatcher_;
+    std::unique_ptr<QSaveFile> file_;
+    HistoryQuery               filter_;
+    QString                    plateText_;
+    QString                    email_;
+    QList<HistoryRecord>       page_;               // 받는 중인 페이지에서 조건에 맞는 행
+    QString                    pageError_;          // 쓰기 중에 난 오류 (쓰기가 끝나면 처리)
+    int                        offset_ = 0;
+    bool                       lastPage_ = false;
+    bool                       paging_ = false;
+    bool                       pageCanceled_ = false;
+};
+
+#endif // HISTORYEXPORT_H
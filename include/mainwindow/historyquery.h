@@ -0,0 +1,57 @@
+// historyquery.h
+#ifndef HISTORYQUERY_H
+#define HISTORYQUERY_H
+
+#include <QObject>
+#include <QDate>
+#include <QList>
+#include <QSet>
+#include <QFutureWatcher>
+#include <QPromise>
+#include "historystore.h"
+
+/// 히스토리 조회 조건 (유형 + 날짜 범위 + 번호판 검색 결과 + 정렬)
+struct HistoryQuery
+{
+    enum SortKey { SortByDate, SortByType, SortBySpeed, SortByPlate };
+
+    int           eventType = -1;              // -1: 전체
+    QDate         startDate;                   // 유효하지 않으면 제한 없음
+    QDate         endDate;
+    bool          filterByPlate = false;
+    QSet<int>     plateIds;                    // 번호판 색인 검색 결과 (filterByPlate 일 때)
+    SortKey       sortKey = SortByDate;
+    Qt::SortOrder order   = Qt::DescendingOrder;
+
+    bool matches(const HistoryRecord &rec) const;
+
+    /// 동기 실행 (작업 스레드에서 호출). promise 가 취소되면 빈 결과
+    static QList<HistoryRecord> evaluate(const QList<HistoryRecord> &records,
+                                         const HistoryQuery &query,
+                                         QPromise<QList<HistoryRecord>> *promise = nullptr);
+};
+
+/// 레코드 스냅샷에 대한 필터/정렬을 스레드 풀에서 실행하고 결과를 GUI 스레드로 전달.
+/// 새 조회를 시작하면 진행 중인 조회는 취소되고 그 결과는 버려진다.
+class HistoryQueryEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HistoryQueryEngine(QObject *parent = nullptr);
+    ~HistoryQueryEngine();
+
+    /// records 는 암시적 공유 복사라 호출 비용이 거의 없다
+    void run(const QList<HistoryRecord> &records, const HistoryQuery &query);
+    void cancel();
+    bool isRunning() const { return watcher_.isRunning(); }
+
+signals:
+    /// 마지막으로 시작한 조회의 결과
+    void resultsReady(const QList<HistoryRecord> &results);
+
+private:
+    QFutureWatcher<QList<HistoryRecord>> watcher_;
+};
+
+#endif // HISTORYQUERY_H
@@ -0,0 +1,69 @@
+// historystore.h
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include <QString>
+#include <QDate>
+#include <QList>
+#include <QHash>
+#include <QJsonObject>
+#include "platesearchindex.h"
+
+/// 히스토리 한 건 (서버 JSON / MQTT 이벤트 공통 표현)
+struct HistoryRecord
+{
+    int     id = 0;
+    int     eventType = -1;      // 0: 주정차, 1: 과속, 2: 보행자
+    QString date;
+    QString imagePath;
+    QString plateNumber;
+    double  speed = 0.0;
+    bool    hasSpeed = false;    // 서버가 null 을 보내면 false
+    QString startSnapshot;
+    QString endSnapshot;
+
+    // 수집 시 한 번 계산해 두는 값 (필터/렌더링 중에는 파일명을 다시 파싱하지 않는다)
+    QDate   fileDate;            // imagePath 의 날짜 (기간 필터용)
+    QString displayTime;         // 날짜 열 표시값 (파일명 시각, 없으면 date)
+    QString startTime;           // startSnapshot 의 시각 (비교 창 표시용)
+
+    /// 파일명 기반 파생 필드 계산. 디코더가 레코드를 완성할 때 호출한다
+    void precompute();
+
+    /// GET_HISTORY* 응답의 data[] 원소 변환
+    static HistoryRecord fromJson(const QJsonObject &obj);
+    /// MQTT 알림 payload 변환 (event/timestamp 키 사용)
+    static HistoryRecord fromMqttPayload(const QJsonObject &obj);
+};
+
+/// 최신 순(0번이 가장 최근)으로 정렬된 히스토리 저장소.
+/// 앞쪽 삽입(실시간 이벤트)과 뒤쪽 추가(서버 응답) 모두 O(1) 이고
+/// id 조회도 위치 재계산 없이 O(1) 로 동작한다. 번호판 색인도 함께 갱신된다.
+class HistoryStore
+{
+public:
+    void reset(const QList<HistoryRecord> &records);
+    void clear();
+
+    /// 새 이벤트를 맨 앞에 추가. 같은 id 가 이미 있으면 false
+    bool prepend(const HistoryRecord &record);
+    /// 서버 응답 레코드를 맨 뒤에 추가. 같은 id 가 이미 있으면 false
+    bool append(const HistoryRecord &record);
+
+    bool contains(int id) const { return keyById_.contains(id); }
+    const HistoryRecord *find(int id) const;
+
+    const QList<HistoryRecord> &records() const { return records_; }
+    PlateSearchIndex &plateIndex() { return plateIndex_; }
+    int  size() const { return int(records_.size()); }
+    bool isEmpty() const { return records_.isEmpty(); }
+
+private:
+    QList<HistoryRecord> records_;
+    // id → 논리 키. 실제 위치 = 키 - frontKey_ (prepend 시 frontKey_ 만 감소)
+    QHash<int, qsizetype> keyById_;
+    qsizetype frontKey_ = 0;
+    PlateSearchIndex plateIndex_;
+};
+
+#endif // HISTORYSTORE_H
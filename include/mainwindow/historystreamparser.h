@@ -0,0 +1,62 @@
+// historystreamparser.h
+#ifndef HISTORYSTREAMPARSER_H
+#define HISTORYSTREAMPARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QList>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QVarLengthArray>
+#include "historydecoder.h"
+
+/// GET_HISTORY* 응답을 도착하는 바이트 단위로 파싱하는 증분(SAX 방식) 파서.
+/// 전체 응답이나 DOM 을 만들지 않고 data[] 의 각 원소를 바로 HistoryRecord 로
+/// 변환하며, 내부에는 현재 토큰(문자열/숫자) 하나만 보관한다.
+class HistoryStreamParser : public HistoryDecoder
+{
+public:
+    HistoryStreamParser();
+
+    void reset() override;
+    qsizetype feed(const char *data, qsizetype size) override;
+
+    bool isComplete() const override { return complete_; }
+    bool hasError() const override { return !error_.isEmpty(); }
+    QString errorString() const override { return error_; }
+
+    QList<HistoryRecord> takeRecords() override;
+    /// data 를 제외한 최상위 필드 (status, code, message ...)
+    QJsonObject header() const override { return header_; }
+    int recordCount() const override { return recordCount_; }
+
+private:
+    enum class State { Value, String, Literal };
+
+    void openContainer(char c);
+    void closeContainer(char c);
+    void finishString();
+    void finishLiteral();
+    void setKey(const QString &key);
+    void onScalar(const QJsonValue &value);
+    void assignField(const QString &key, const QJsonValue &value);
+    bool inRecord() const;
+    static QString unescape(const QByteArray &raw);
+
+    State                    state_;
+    QByteArray               token_;        // 현재 문자열/리터럴 (이스케이프 포함 원본)
+    bool                     escape_;
+    bool                     expectKey_;
+    QVarLengthArray<char, 8> stack_;        // '{' / '[' 중첩
+    bool                     inData_;       // 최상위 "data" 배열 내부 여부
+    QString                  topKey_;
+    QString                  fieldKey_;
+    HistoryRecord            current_;
+    QList<HistoryRecord>     pending_;
+    QJsonObject              header_;
+    int                      recordCount_;
+    bool                     complete_;
+    QString                  error_;
+};
+
+#endif // HISTORYSTREAMPARSER_H
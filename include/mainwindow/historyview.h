@@ -10,7 +10,13 @@
 #include <QTableWidget>
 #include <QActionGroup>
 #include <QCheckBox>
+#include <QLineEdit>
 #include "tcphistoryhandler.h"
+#include "historystore.h"
+#include "historyquery.h"
+#include "historyexport.h"
+#include "evidenceexport.h"
+#include "pdfreport.h"
 #include <QSet>
 #include <QMap>
 #include <QJsonObject>
@@ -18,12 +24,19 @@
 #include "getimageview.h"
 #include "compareimageview.h"
 #include "tcpimagehandler.h"
+#include "mqttevent.h"
 #include <QByteArray>
+#include <QCache>
+class QProgressDialog;
 class HistoryView : public QWidget {
     Q_OBJECT
 public:
     explicit HistoryView(QWidget *parent = nullptr);
 
+public slots:
+    // MQTT 실시간 이벤트를 히스토리에 바로 반영 (네트워크 스레드에서 해석 완료)
+    void handleMqttEvents(const QList<MqttEvent> &events);
+
 protected:
     void resizeEvent(QResizeEvent *event) override;
     bool eventFilter(QObject *obj, QEvent *event) override;
@@ -34,8 +47,15 @@ private slots:
     void dateSelected();
 private slots:
     void exportCsv();
+    void exportEvidence();
+    void exportReport();
     // 서버 응답
     void onHistoryData(const QJsonObject &resp);
+    void onHistoryRecords(const QList<HistoryRecord> &records, bool firstBatch);
+    void onHistoryFinished(const QJsonObject &header, int recordCount);
+    // 작업 스레드 필터/정렬 결과
+    void onFilterResults(const QList<HistoryRecord> &results);
+    void onSortSectionClicked(int column);
     void onHistoryError(const QString &err);
 
     // 페이지 전환
@@ -45,6 +65,7 @@ private slots:
     // (기존 슬롯 아래에)
     void onImageCellClicked(int row, int column);
     void onImageDataReady(const QString& imagePath, const QByteArray& data);
+    void navigateViewer(int step);
     void updateTypeColumnBackground();
 private:
     QLabel*          titleLabel;
@@ -71,6 +92,7 @@ private:
     QPushButton    *prevButton;
     QLabel         *pageLabel;
     QPushButton    *nextButton;
+    QLineEdit      *plateSearchEdit_;
 
     // TCP handler
     TcpHistoryHandler *tcpHandler_;
@@ -83,33 +105,61 @@ private:
     static constexpr int PAGE_SIZE = 16;
     
     // 클라이언트 사이드 필터링을 위한 전체 데이터 저장
-    QJsonArray allHistoryData;
+    HistoryStore         historyStore_;
+    QList<HistoryRecord> filteredRecords_;    // 현재 필터/정렬 결과
+    HistoryQueryEngine  *queryEngine_;
+    HistoryQuery::SortKey sortKey_   = HistoryQuery::SortByDate;
+    Qt::SortOrder        sortOrder_  = Qt::DescendingOrder;
+    bool                 streamDeferred_ = false;   // 수신 중인 응답을 완료 후 한 번에 조회
+    HistoryQuery         filterQuery_;      // 마지막 필터 패스의 조건 (실시간/수신 레코드 대조용)
+    QString              filterPlateText_;  // 그 조건의 번호판 검색어
+    HistoryExporter     *exporter_;
+    QProgressDialog     *exportProgress_ = nullptr;
+    EvidenceExporter    *evidenceExporter_ = nullptr;
+    QProgressDialog     *evidenceProgress_ = nullptr;
+    PdfReportExporter   *reportExporter_ = nullptr;
+    QProgressDialog     *reportProgress_ = nullptr;
 
     void requestPage();
     void setupPaginationUI();
+    void applyScaledStyles();   // 창 크기에 따른 폰트/스타일시트/아이콘 (크기가 바뀔 때만)
+    HistoryQuery currentQuery();
+    void rebuildFilterQuery();
+    bool matchesFilters(const HistoryRecord &rec);
+    bool canUpdateIncrementally() const;
+    void applyFilters();
+    QList<HistoryRecord> exportRecords() const;
+    void refreshTable();
+    void populateRow(int row, const HistoryRecord &rec);
+    void updatePaginationControls();
+    void syncHeaderCheck();
+    void addLiveRecord(const HistoryRecord &rec);
 private:
     QSet<int>            selectedRecordIds;  // 선택된 레코드 ID 저장
-    QMap<int, QJsonObject> recordDataMap;     // ID → JSON 데이터 맵
 private:
     // ...기존 변수들...
     TcpImageHandler*   tcpImageHandler_;
     GetImageView*      currentImageView_;
     CompareImageView*  currentCompareView_;
+    QString            pendingImagePath_;
     QString            pendingStartImagePath_;
     QString            pendingEndImagePath_;
     QByteArray         startImageData_;
     QByteArray         endImageData_;
+    int                viewerRecordId_ = -1;   // 뷰어에 표시 중인 레코드
+    QCache<QString, QByteArray> imageCache_;   // 최근 이미지 (비용: KB)
+    QString configPath_;                       // findConfigFile 결과 (찾은 뒤에는 다시 검색하지 않음)
+    QSize   styledSize_;                       // applyScaledStyles 를 마지막으로 적용한 크기
 private:
-    QString parseTimestampFromPath(const QString& path, const QString& eventType = "");
+    const HistoryRecord *recordAtRow(int row) const;
+    static bool hasSnapshotPair(const HistoryRecord &rec);
+    void openImageViewer(const HistoryRecord &rec, const QString &path);
+    void openCompareViewer(const HistoryRecord &rec);
+    void requestViewerImage(const QString &path);
     QString findConfigFile();
     void loadDummyData(); // 더미 데이터 로드 함수
     QJsonObject createDummyHistoryResponse(); // 더미 히스토리 응답 생성
-    
-    // 파일명에서 날짜 추출하는 함수
-    QDate extractDateFromFilename(const QString& filename);
-    
-    // 클라이언트 사이드 날짜 필터링 함수
-    bool isDateInRange(const QDate& date, const QString& startDateStr, const QString& endDateStr);
+
 };
 
 #endif // HISTORYVIEW_H
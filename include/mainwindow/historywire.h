@@ -0,0 +1,67 @@
+// historywire.h
+#ifndef HISTORYWIRE_H
+#define HISTORYWIRE_H
+
+#include <QByteArray>
+#include <QStringList>
+#include "historydecoder.h"
+
+/// GET_HISTORY* 응답의 바이너리 wire 형식 ("bin1").
+/// 연결 직후 클라이언트가 "HELLO wire=bin1" 로 지원을 알리고, 서버가
+/// {"wire":"bin1"} 로 응답한 세션에서만 사용한다 (그 외에는 JSON).
+///
+///   frame := 0xB1 'H' item*
+///   item  := 0x01 dictId:varint len:varint utf8      (경로 접두어 사전 등록)
+///          | 0x02 len:varint row                     (레코드 한 건)
+///          | 0x03 code:varint len:varint utf8        (응답 끝, message)
+///   row   := idDelta:zigzag eventType:u8 flags:u8
+///            [tsDelta:zigzag | len:varint utf8]      (flags 0x02 / 0x04)
+///            [speedCenti:varint]                     (flags 0x01)
+///            path(image) path(start) path(end) len:varint plate
+///   path  := dictId:varint len:varint suffix         (dictId 0: 접두어 없음)
+///
+/// id/타임스탬프(UTC 초)는 직전 레코드와의 차이로 보낸다.
+namespace HistoryWire {
+    constexpr char Magic0 = char(0xB1);
+    constexpr char Magic1 = 'H';
+    constexpr const char *Name = "bin1";
+
+    enum Tag : quint8 { TagDict = 0x01, TagRow = 0x02, TagEnd = 0x03 };
+    enum RowFlag : quint8 { HasSpeed = 0x01, HasTimestamp = 0x02, HasRawDate = 0x04 };
+}
+
+class HistoryWireDecoder : public HistoryDecoder
+{
+public:
+    HistoryWireDecoder();
+
+    void reset() override;
+    qsizetype feed(const char *data, qsizetype size) override;
+
+    bool isComplete() const override { return complete_; }
+    bool hasError() const override { return !error_.isEmpty(); }
+    QString errorString() const override { return error_; }
+
+    QList<HistoryRecord> takeRecords() override;
+    QJsonObject header() const override { return header_; }
+    int recordCount() const override { return recordCount_; }
+
+private:
+    // 완전한 항목이 없으면 0, 오류면 -1, 성공하면 읽은 바이트 수
+    qsizetype parseItem(const char *p, const char *end);
+    bool decodeRow(const char *p, const char *end);
+    bool readPath(const char *&p, const char *end, QString &out);
+
+    QByteArray           buffer_;       // 아직 완성되지 않은 항목의 바이트
+    bool                 magicSeen_;
+    QStringList          dict_;         // dictId-1 → 경로 접두어
+    qint64               prevId_;
+    qint64               prevTs_;
+    QList<HistoryRecord> pending_;
+    QJsonObject          header_;
+    int                  recordCount_;
+    bool                 complete_;
+    QString              error_;
+};
+
+#endif // HISTORYWIRE_H
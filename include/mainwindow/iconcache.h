@@ -0,0 +1,38 @@
+// iconcache.h
+#ifndef ICONCACHE_H
+#define ICONCACHE_H
+
+#include <QIcon>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+class QWidget;
+
+/// 리소스 이미지와 축소본 캐시 (GUI 스레드 전용).
+/// 상태별 이미지는 경로가 다르므로 (경로, 크기) 가 곧 (리소스, 크기, 상태) 키다.
+/// 원본은 한 번만 읽고, 축소본은 QPixmapCache 에 넣어 전체 한도 안에서 오래된 것부터 버린다.
+class IconCache
+{
+public:
+    /// 원본 (읽기 실패도 기억해 다시 시도하지 않음)
+    static QPixmap pixmap(const QString &path);
+    /// 비율 유지, 부드러운 축소
+    static QPixmap scaled(const QString &path, const QSize &size);
+    /// 원본 크기 × factor
+    static QPixmap scaledBy(const QString &path, qreal factor);
+    /// QIcon 은 크기별 pixmap 을 자체 캐시하므로 같은 객체를 공유한다
+    static QIcon icon(const QString &path);
+};
+
+/// 상태에 따라 모양만 바뀌는 위젯용.
+/// 두 상태를 모두 담은 스타일시트를 한 번 설정해 두고 (예: QLabel[active="true"] { color: #F37321; })
+/// 상태가 바뀌면 동적 속성만 바꾼다. 스타일시트 문자열을 다시 해석하지 않는다.
+namespace StyleState {
+
+/// 값이 실제로 바뀔 때만 속성을 바꾸고 다시 polish 한다
+void set(QWidget *widget, const char *property, bool on);
+
+} // namespace StyleState
+
+#endif // ICONCACHE_H
@@ -0,0 +1,28 @@
+// imagedecoder.h
+#ifndef IMAGEDECODER_H
+#define IMAGEDECODER_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QImage>
+#include <QSize>
+
+/// 작업 스레드용 이미지 디코딩 도우미.
+/// QImage 만 다루므로 GUI 스레드 밖에서 호출해도 안전하다.
+namespace ImageDecoder {
+
+/// 앞부분 매직 바이트로 형식 판별 ("jpeg", "png", "bmp", "gif", "webp"). 모르면 빈 값
+QByteArray detectFormat(const QByteArray &data);
+
+/// target 안에 비율을 유지해 들어가는 크기로 디코딩한다.
+/// JPEG 는 디코더 단계에서 축소(DCT 스케일링)하므로 원본 전체를 풀지 않는다.
+/// 결과는 화면 표시용 형식으로 변환되어 GUI 스레드에서는 QPixmap 변환만 남는다.
+/// target 이 유효하지 않으면(QSize()) 원본 해상도로 디코딩한다.
+QImage decodeScaled(const QByteArray &data, const QSize &target);
+
+/// decodeScaled 를 전역 스레드 풀에서 실행
+QFuture<QImage> decodeScaledAsync(const QByteArray &data, const QSize &target);
+
+} // namespace ImageDecoder
+
+#endif // IMAGEDECODER_H
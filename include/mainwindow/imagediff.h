@@ -0,0 +1,33 @@
+// imagediff.h
+#ifndef IMAGEDIFF_H
+#define IMAGEDIFF_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <QSize>
+
+/// 주정차 시작/1분 경과 스냅샷 비교 (작업 스레드용).
+/// 두 이미지를 같은 작업 해상도로 디코딩한 뒤 OpenCV(imgproc)로
+/// 회색조 차이 → 임계값 → 닫힘 연산 → 외곽선 순으로 변경 영역을 찾는다.
+namespace ImageDiff {
+
+struct Result {
+    QImage       image;          // 1분 경과 이미지 위에 히트맵/영역 상자를 그린 결과 (target 크기)
+    QList<QRect> regions;        // 변경 영역 (image 좌표)
+    double       changedRatio = 0.0;   // 변한 픽셀 비율 (0~1)
+
+    bool isValid() const { return !image.isNull(); }
+};
+
+/// 두 원본 데이터를 비교해 target 안에 맞는 결과 이미지를 만든다. 디코딩 실패 시 빈 결과
+Result compare(const QByteArray &startData, const QByteArray &endData, const QSize &target);
+
+/// compare 를 전역 스레드 풀에서 실행
+QFuture<Result> compareAsync(const QByteArray &startData, const QByteArray &endData, const QSize &target);
+
+} // namespace ImageDiff
+
+#endif // IMAGEDIFF_H
@@ -0,0 +1,80 @@
+// imagefetchpool.h
+#ifndef IMAGEFETCHPOOL_H
+#define IMAGEFETCHPOOL_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QQueue>
+#include <QSslSocket>
+#include <QStringList>
+
+/// 여러 이미지를 GET_IMAGE 로 한꺼번에 받아오는 연결 풀.
+/// 소수의 TLS 연결을 재사용하고, 연결마다 응답을 기다리지 않고
+/// pipelineDepth 개까지 요청을 먼저 보낸다 (응답은 요청 순서대로 도착).
+/// 서버가 응답 후 연결을 끊으면 남은 요청은 새 연결로 다시 보낸다.
+class ImageFetchPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageFetchPool(QObject *parent = nullptr);
+    ~ImageFetchPool();
+
+    void setServer(const QString &host, quint16 port);
+    void setConcurrency(int connections, int pipelineDepth);
+
+    /// 요청 큐에 추가하고 연결을 연다
+    void fetch(const QStringList &paths);
+    /// 새 요청 전송만 멈춘다 (이미 보낸 요청의 응답은 계속 받음)
+    void pause();
+    void resume();
+    void cancel();
+
+    bool   isIdle() const;
+    int    fetchedCount() const { return fetched_; }
+    double imagesPerSecond() const;
+
+signals:
+    void imageFetched(const QString &path, const QByteArray &data);
+    void imageFailed(const QString &path, const QString &error);
+    void finished();
+
+private:
+    struct Connection {
+        QSslSocket     *socket = nullptr;
+        QQueue<QString> inFlight;       // 응답 대기 중인 요청 (보낸 순서)
+        QByteArray      buffer;
+        quint64         expected = 0;
+        bool            headerParsed = false;
+        bool            ready = false;  // TLS 핸드셰이크 완료
+        int             served = 0;     // 이 연결에서 받은 응답 수
+        qint64          handshakeStartUs = 0;   // MetricsRegistry 측정용
+    };
+
+    void openConnections();
+    void openConnection();
+    void pump(Connection *conn);
+    void onReadyRead(Connection *conn);
+    void onClosed(Connection *conn);
+    QStringList requeue(Connection *conn);   // 재시도 횟수를 넘긴 경로
+    void release(Connection *conn);
+    void checkFinished();
+
+    QString            host_;
+    quint16            port_ = 0;
+    int                maxConnections_ = 3;
+    int                pipelineDepth_  = 4;
+    QList<Connection*> connections_;
+    QQueue<QString>    queue_;
+    QHash<QString,int> attempts_;        // 경로별 재시도 횟수
+    int                connectFailures_ = 0;
+    bool               paused_ = false;
+    bool               active_ = false;     // fetch() 이후 finished 를 아직 보내지 않음
+    int                fetched_ = 0;
+    QElapsedTimer      elapsed_;
+};
+
+#endif // IMAGEFETCHPOOL_H
@@ -0,0 +1,69 @@
+// imageinspector.h
+#ifndef IMAGEINSPECTOR_H
+#define IMAGEINSPECTOR_H
+
+#include <QWidget>
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QPointF>
+
+/// 원본 해상도 이미지 확대/이동 보기.
+/// 디코딩한 원본(0단계)에서 1/2 씩 줄인 단계(밉맵)를 필요할 때 작업 스레드에서 만들고,
+/// 각 단계를 TileSize 타일로 나눠 화면에 보이는 타일만 그린다.
+/// 타일 QPixmap 은 캐시하므로 이동 중에는 이미지 전체를 다시 축소하지 않는다.
+class ImageInspector : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ImageInspector(QWidget *parent = nullptr);
+
+    /// 새 이미지 표시 (원본 디코딩은 작업 스레드에서)
+    void setImageData(const QByteArray &data);
+    void clear();
+
+    /// 창에 맞춤 / 원본 크기(1:1)
+    void fitToWindow();
+    void zoomTo(double scale, const QPointF &anchor);
+    double zoom() const { return scale_; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    static constexpr int TileSize = 256;
+
+    QSize imageSize() const { return levels_.isEmpty() ? QSize() : levels_.first().size(); }
+    int levelForScale(double scale) const;
+    int readyLevelNear(int level) const;
+    void requestLevel(int level);
+    void drawLevel(QPainter &painter, int level);
+    QPixmap tile(int level, int tx, int ty);
+    void clampOrigin();
+
+    QList<QImage>            levels_;          // 0 = 원본, n = 1/2^n (아직 없으면 null)
+    QCache<quint64, QPixmap> tiles_;           // (단계, 타일 x, y) → 픽스맵, 비용: KB
+    int                      seq_ = 0;         // 마지막 setImageData 번호
+    bool                     loading_ = false;
+    bool                     failed_ = false;
+    bool                     building_ = false;   // 밉맵 단계 생성 중
+
+    double  scale_ = 1.0;        // 화면 px / 원본 px
+    double  fitScale_ = 1.0;
+    bool    fitted_ = true;      // 사용자가 확대/이동하기 전 (창 크기 변경 시 다시 맞춤)
+    QPointF origin_;             // 화면 왼쪽 위에 해당하는 원본 좌표
+
+    bool    panning_ = false;
+    QPoint  lastMousePos_;
+};
+
+#endif // IMAGEINSPECTOR_H
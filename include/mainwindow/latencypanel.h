@@ -0,0 +1,35 @@
+// latencypanel.h
+#ifndef LATENCYPANEL_H
+#define LATENCYPANEL_H
+
+#include <QWidget>
+#include <QTimer>
+
+class QTableWidget;
+
+/// LatencyTracker 구간별 p50/p95/p99 표.
+/// 보이는 동안에만 1초마다 갱신하고, JSON 으로 내보낼 수 있다.
+class LatencyPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LatencyPanel(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refresh();
+    void exportJson();
+    void resetStats();
+
+private:
+    static constexpr int RefreshIntervalMs = 1000;
+
+    QTableWidget *table_;
+    QTimer        refreshTimer_;
+};
+
+#endif // LATENCYPANEL_H
@@ -0,0 +1,107 @@
+// latencytracker.h
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <array>
+#include <functional>
+
+class QWidget;
+
+/// 최근 1분(10초 칸 6개)의 지연 분포.
+/// 0.05ms 부터 10% 간격 로그 버킷이라 백분위 오차는 10% 이내.
+class LatencyHistogram
+{
+public:
+    static constexpr int    BucketCount = 160;     // 0.05ms ~ 약 190s
+    static constexpr int    SlotCount   = 6;
+    static constexpr qint64 SlotMs      = 10000;
+
+    struct Summary
+    {
+        quint64 count  = 0;
+        double  meanMs = 0;
+        double  p50Ms  = 0;
+        double  p95Ms  = 0;
+        double  p99Ms  = 0;
+        double  maxMs  = 0;
+    };
+
+    void    add(double ms, qint64 nowMs);
+    Summary summary(qint64 nowMs);
+    void    clear();
+
+    /// 창 안의 버킷별 건수 (index → count, 0 인 버킷 포함)
+    std::array<quint64, BucketCount> buckets(qint64 nowMs);
+
+    static double bucketUpperMs(int index);
+    static int    bucketFor(double ms);
+
+private:
+    struct Slot
+    {
+        std::array<quint32, BucketCount> counts{};
+        quint64 total = 0;
+        double  sum   = 0;
+        double  max   = 0;
+    };
+
+    void advance(qint64 nowMs);   // 지난 칸 비우기
+
+    std::array<Slot, SlotCount> slots_;
+    qint64 current_ = -1;         // 현재 칸 번호 (nowMs / SlotMs)
+};
+
+/// 알림/영상 지연 구간별 히스토그램 모음.
+/// GUI 스레드 전용 (기록은 모두 GUI 스레드의 슬롯/이벤트에서 이루어짐).
+class LatencyTracker
+{
+public:
+    enum Stage {
+        MqttPublishToReceive,   // payload timestamp → 네트워크 스레드 수신 (초 단위 timestamp 라 ±1s)
+        MqttReceiveToPaint,     // 수신 → 알림 목록 그리기
+        MqttEndToEnd,           // payload timestamp → 알림 목록 그리기
+        RtspCaptureToFrameReady,// 프레임 읽기 완료 → GUI 스레드 frameReady 처리
+        RtspFrameReadyToPaint,  // frameReady 처리 → 영상 라벨 그리기
+        RtspEndToEnd,           // 프레임 읽기 완료 → 영상 라벨 그리기
+        StageCount
+    };
+
+    static LatencyTracker &instance();
+
+    void record(Stage stage, double ms);
+    LatencyHistogram::Summary summary(Stage stage);
+    void reset();
+
+    static QString stageName(Stage stage);    // JSON 키 (mqtt.end_to_end 등)
+    static QString stageLabel(Stage stage);   // 화면 표시용
+
+    QJsonObject toJson();
+    bool exportJson(const QString &path, QString *error = nullptr);
+
+    /// 스레드 간 비교 가능한 단조 시계 (µs). MetricsRegistry::nowUs 와 같은 값
+    static qint64 nowUs();
+
+private:
+    LatencyTracker() = default;
+
+    std::array<LatencyHistogram, StageCount> stages_;
+};
+
+/// 대상 위젯이 그려지기 직전(QEvent::Paint)마다 콜백을 부르는 이벤트 필터.
+/// 대상 위젯의 자식이 되어 함께 삭제된다.
+class PaintProbe : public QObject
+{
+public:
+    PaintProbe(QWidget *target, std::function<void()> onPaint);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    std::function<void()> onPaint_;
+};
+
+#endif // LATENCYTRACKER_H
@@ -0,0 +1,35 @@
+// logging.h
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QLoggingCategory>
+#include <QString>
+
+// 분류별 로그. 릴리스 빌드는 QT_NO_DEBUG_OUTPUT 으로 qCDebug 가 컴파일되지 않는다.
+// 실행 중에는 config.ini [log] rules 나 QT_LOGGING_RULES 로 분류/수준을 켜고 끈다.
+Q_DECLARE_LOGGING_CATEGORY(lcTcp)       // quadqt.tcp     명령 채널, 히스토리 응답
+Q_DECLARE_LOGGING_CATEGORY(lcImage)     // quadqt.image   GET_IMAGE
+Q_DECLARE_LOGGING_CATEGORY(lcHistory)   // quadqt.history 히스토리 화면
+Q_DECLARE_LOGGING_CATEGORY(lcMqtt)      // quadqt.mqtt
+Q_DECLARE_LOGGING_CATEGORY(lcRtsp)      // quadqt.rtsp
+Q_DECLARE_LOGGING_CATEGORY(lcConfig)    // quadqt.config  설정/인증서 파일 검색
+Q_DECLARE_LOGGING_CATEGORY(lcUi)        // quadqt.ui      GUI 멈춤 감지
+Q_DECLARE_LOGGING_CATEGORY(lcStartup)   // quadqt.startup 로그인 후 첫 프레임까지 타임라인
+
+namespace Logging {
+
+/// Qt 메시지 처리기를 비동기 싱크로 교체한다 (main 에서 한 번).
+/// 호출한 스레드는 메시지를 링 버퍼에 넣기만 하고, 출력(stderr, 디버거, 파일)은
+/// 백그라운드 스레드가 묶어서 한다. 같은 위치의 메시지는 초당 RateLimitPerSecond 건까지만 남긴다.
+/// rules: QLoggingCategory 필터 규칙 (비우면 기본값), filePath: 추가로 기록할 파일
+void install(const QString &rules = QString(), const QString &filePath = QString());
+
+/// 남은 로그를 모두 쓰고 원래 처리기로 되돌린다 (다른 스레드가 모두 끝난 뒤 호출)
+void shutdown();
+
+constexpr int RateLimitPerSecond = 20;
+constexpr int RingCapacity       = 4096;
+
+} // namespace Logging
+
+#endif // LOGGING_H
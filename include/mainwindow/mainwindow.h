@@ -16,11 +16,14 @@
 #include "mainwindow/rtspthread.h"
 
 class QLabel;
+class QTimer;
 class DisplaySettingBox;
+class DiagnosticsPage;
 
 enum class PageType {
     Camera,
-    Document
+    Document,
+    Diagnostics
 };
 
 class MainWindow : public QMainWindow
@@ -48,10 +51,16 @@ private:
     void setupPages();
     void showPage(PageType pageType);
     void updateCameraPageLayout();
-    void forceLayoutUpdate();
+    void scheduleLayout();      // 다음 프레임에 한 번 배치 (여러 요청은 합쳐짐)
+    void performLayout();
+    void toggleDiagnosticsPage();
 
     QWidget* createCameraPage();
     QWidget* createDocumentPage();
+    void ensureHistoryView();   // 문서 페이지를 처음 열 때 히스토리 뷰 생성
+    QWidget* createDiagnosticsPage();
+
+    static constexpr int LayoutFrameMs = 16;
 
     // 공통 UI 요소
     TopBarWidget *topBar;
@@ -70,6 +79,8 @@ private:
     // RTSP 스트리밍
     QLabel *rtspLabel;
     RtspThread *rtspThread;
+    qint64 pendingFrameCaptureUs = 0;   // 아직 그려지지 않은 마지막 프레임 (지연 측정용)
+    qint64 pendingFrameReadyUs = 0;
 
     // 알림 패널 및 설정
     NotificationPanel *notificationPanel;
@@ -82,6 +93,12 @@ private:
     // 페이지들
     QWidget *cameraPage;
     QWidget *documentPage;
+    DiagnosticsPage *diagnosticsPage = nullptr;
+    PageType currentPageType = PageType::Camera;
+    PageType pageBeforeDiagnostics = PageType::Camera;   // F12 로 돌아갈 페이지
+
+    // 레이아웃 예약 (scheduleLayout)
+    QTimer *layoutTimer = nullptr;
 
     // 네트워크 매니저
     NetworkManager *networkManager;
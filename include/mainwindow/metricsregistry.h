@@ -0,0 +1,128 @@
+// metricsregistry.h
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QString>
+#include <QStringView>
+#include <array>
+#include <atomic>
+
+/// 진단 페이지용 카운터와 소요 시간 누계.
+/// 어느 스레드에서나 락 없이(relaxed atomic) 기록한다.
+/// 진단 페이지가 닫혀 있으면 기록 함수는 플래그 하나만 읽고 돌아간다 (시계도 읽지 않음).
+class MetricsRegistry
+{
+public:
+    enum Counter {
+        RtspFrames,          // frameReady 로 보낸 프레임
+        RtspDropped,         // 그려지기 전에 다음 프레임으로 교체된 프레임
+        RtspReadFailures,    // 빈 프레임 (스트림 끊김 등)
+        ImageCacheHits,      // 히스토리 이미지 캐시
+        ImageCacheMisses,
+        MqttMessages,        // 해석까지 마친 알림
+        MqttDropped,         // 큐가 가득 차 버린 알림
+        WireBytesIn,         // TCP 명령 채널(로그인/히스토리)에서 받은 바이트
+        WireBytesOut,        // 〃 보낸 명령 바이트
+        WireDeflatedBytes,   // 받은 압축 프레임의 본문 바이트
+        WireInflatedBytes,   // 그 프레임을 푼 뒤의 바이트
+        CounterCount
+    };
+
+    enum Timing {
+        RtspDecode,          // 프레임 읽기(디코드) + RGB 변환
+        EventLoopLag,        // GUI 이벤트 루프 지연 (진단 페이지가 측정)
+        TlsHandshake,        // TCP 연결 → 암호화 완료
+        MqttReconnect,       // MQTT 연결 끊김 → 재연결 완료
+        HistoryDecodeJson,   // 히스토리 응답 하나의 디코드 시간 (JSON)
+        HistoryDecodeBin1,   // 〃 (bin1)
+        WireInflate,         // 압축 프레임 하나의 압축 해제
+        // TCP 명령별 응답 시간 (명령 전송 → 응답 수신 완료)
+        TcpHello,
+        TcpLogin,
+        TcpRegister,
+        TcpResetPassword,
+        TcpGetHistory,
+        TcpGetHistoryByEventType,
+        TcpGetHistoryByDateRange,
+        TcpGetHistoryByEventTypeAndDateRange,
+        TcpAddHistory,
+        TcpChangeFrame,
+        TcpGetFrame,
+        TcpGetLog,
+        TcpGetImage,
+        TcpOther,
+        TimingCount
+    };
+
+    struct TimingValue
+    {
+        quint64 count = 0;
+        quint64 sumUs = 0;
+        quint64 maxUs = 0;
+
+        double meanMs() const { return count ? sumUs / 1000.0 / double(count) : 0.0; }
+        double maxMs() const  { return maxUs / 1000.0; }
+    };
+
+    struct Snapshot
+    {
+        std::array<quint64, CounterCount>    counters{};
+        std::array<TimingValue, TimingCount> timings{};
+    };
+
+    /// 프로세스 전체 사용량 (진단 페이지가 1초마다 읽음)
+    struct ProcessUsage
+    {
+        bool    valid    = false;
+        quint64 rssBytes = 0;   // 상주 메모리
+        qint64  cpuUs    = 0;   // 누적 CPU 시간 (user + kernel)
+    };
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    /// 켤 때 모든 값을 0 으로 되돌린다 (페이지를 연 뒤의 값만 보이도록)
+    static void setEnabled(bool enabled);
+
+    static void add(Counter counter, quint64 n = 1)
+    {
+        if (isEnabled())
+            counters_[counter].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// 측정 시작 시각. 꺼져 있으면 0 (finish 가 무시함)
+    static qint64 start() { return isEnabled() ? nowUs() : 0; }
+    static void finish(Timing timing, qint64 startUs)
+    {
+        if (startUs != 0 && isEnabled())
+            recordUs(timing, nowUs() - startUs);
+    }
+    static void recordUs(Timing timing, qint64 us);
+
+    static Snapshot snapshot();
+    static ProcessUsage processUsage();
+
+    /// 명령 문자열의 첫 단어로 TCP 응답 시간 항목 선택 (모르는 명령은 TcpOther)
+    static Timing tcpTiming(QStringView command);
+    static QString timingLabel(Timing timing);
+
+    /// 스레드 간 비교 가능한 단조 시계 (µs)
+    static qint64 nowUs();
+
+private:
+    // 서로 다른 스레드가 쓰는 값이 같은 캐시 라인을 나누지 않게 한다
+    struct alignas(64) CounterCell
+    {
+        std::atomic<quint64> value{0};
+    };
+    struct alignas(64) TimingCell
+    {
+        std::atomic<quint64> count{0};
+        std::atomic<quint64> sumUs{0};
+        std::atomic<quint64> maxUs{0};
+    };
+
+    static inline std::atomic<bool>                         enabled_{false};
+    static inline std::array<CounterCell, CounterCount>     counters_;
+    static inline std::array<TimingCell, TimingCount>       timings_;
+};
+
+#endif // METRICSREGISTRY_H
@@ -0,0 +1,27 @@
+// mqttevent.h
+#ifndef MQTTEVENT_H
+#define MQTTEVENT_H
+
+#include <QByteArray>
+#include <QString>
+#include "historystore.h"
+#include "topicrouter.h"
+
+/// 네트워크 스레드에서 해석을 마친 MQTT 알림 한 건.
+/// GUI 쪽은 JSON/날짜를 다시 파싱하지 않고 이 값만 사용한다.
+struct MqttEvent
+{
+    QString       topic;
+    int           eventType = -1;
+    QString       notifyDate;     // 알림 패널 표시값 (yyyy-MM-dd HH:mm)
+    HistoryRecord record;         // 히스토리 실시간 반영용
+    qint64        receivedMs = 0; // 수신 시각 (epoch ms)
+    qint64        sentMs = 0;     // payload timestamp (epoch ms), 없으면 0
+    QList<TopicMatch> matches;    // 일치한 경로 (MqttManager::addRoute)
+    QStringList   captures;       // 처리기에 넘길 때 그 경로의 '+' 자리 값
+
+    /// payload(JSON) 해석. JSON 이 아니거나 event 가 없는 테스트 메시지면 false
+    static bool decode(const QString &topic, const QByteArray &payload, MqttEvent &out);
+};
+
+#endif // MQTTEVENT_H
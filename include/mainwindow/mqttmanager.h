@@ -4,30 +4,134 @@
 #include <QObject>
 #include <QMqttClient>
 #include <QSslConfiguration>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QList>
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
+#include <QPointer>
+#include <functional>
+#include <atomic>
+#include "mqttevent.h"
+#include "spscqueue.h"
+#include "topicrouter.h"
 
+/// MQTT 수신. 클라이언트와 JSON 해석은 전용 네트워크 스레드에서 돌고,
+/// 해석된 MqttEvent 는 잠금 없는 SPSC 큐로 GUI 스레드에 넘어온다.
+/// GUI 스레드는 큐가 빈 상태에서 채워질 때만 한 번 깨어나 쌓인 이벤트를 묶음으로 꺼낸다.
+///
+/// 세션은 고정 client id + clean session 해제로 유지되어, 끊긴 동안 발행된 QoS 1/2 알림은
+/// 재연결 시 브로커가 다시 보낸다. 연결이 끊기면 지수 백오프로 재연결하고,
+/// 재전송/중복 수신된 이벤트는 id 기준으로 한 번만 전달한다.
+///
+/// 알림은 addRoute 로 등록한 토픽 필터(예: "site/+/camera/+/event/#")로만 전달된다.
+/// 필터는 네트워크 스레드에서 트라이로 미리 대조해 두고, GUI 스레드에서는
+/// 한 번에 꺼낸 묶음을 경로별로 나눠 일치한 경로의 처리기만 호출한다.
 class MqttManager : public QObject
 {
     Q_OBJECT
 public:
     explicit MqttManager(QObject *parent = nullptr);
+    ~MqttManager();
+
     void connectToBroker();
     void publish(const QString &topic, const QByteArray &payload);
     void publish(const QByteArray &payload); // 기본 토픽 사용
 
+    /// 경로 처리기: 한 번에 꺼낸 이벤트 중 이 경로와 일치한 것들 (수신 순서).
+    /// 각 이벤트의 captures 는 필터의 '+' 자리에 온 토픽 단계 (예: 사이트, 카메라 id)
+    using RouteHandler = std::function<void(const QList<MqttEvent> &events)>;
+
+    /// filter 와 일치하는 이벤트를 handler 로 전달 (GUI 스레드, context 가 사라지면 자동 해제).
+    /// qos 가 0~2 면 그 QoS 로 구독도 추가한다. 반환: 경로 id (필터 형식 오류면 -1)
+    int addRoute(const QString &filter, QObject *context, RouteHandler handler, int qos = -1);
+    void removeRoute(int route);
+
+    /// 알림 패널/히스토리가 받을 토픽 필터 (config [mqtt] notify_filter, history_filter. 기본 "#")
+    QString notificationFilter() const { return notificationFilter_; }
+    QString historyFilter() const { return historyFilter_; }
+
+    /// 마지막 재연결에 걸린 시간 (끊김 → 연결, 아직 재연결한 적이 없으면 -1)과 시도 횟수.
+    /// 진단 페이지가 닫혀 있어도 유지되며 어느 스레드에서나 읽을 수 있다
+    qint64 lastReconnectLatencyMs() const { return lastReconnectMs_.load(std::memory_order_relaxed); }
+    int lastReconnectAttempts() const { return lastReconnectAttempts_.load(std::memory_order_relaxed); }
+    /// 시작 후 재연결 직후 받은, 끊겨 있는 동안 발행된 알림 누계
+    quint64 recoveredTotal() const { return recoveredTotal_.load(std::memory_order_relaxed); }
+
 signals:
-    void newMessage(const QString &topic, const QByteArray &payload);
     void connected();
-    void messageReceived(const QByteArray &message);
 
 private:
-    QMqttClient client;
+    static constexpr std::size_t QueueCapacity = 8192;
+    static constexpr int    ReconnectMinMs   = 1000;
+    static constexpr int    ReconnectMaxMs   = 30000;
+    static constexpr int    DedupeCapacity   = 4096;      // 기억하는 최근 이벤트 id 수
+    static constexpr qint64 DedupeWindowMs   = 10 * 60 * 1000;
+    static constexpr int    RecoveryReportMs = 10000;     // 재연결 후 복구 건수 집계 시간
+
+    struct Subscription {
+        QString filter;
+        quint8  qos = 1;
+    };
+    static QList<Subscription> parseSubscriptions(const QString &value, quint8 defaultQos);
+    static QString stableClientId();
+
+    // 네트워크 스레드
+    void openConnection();
+    void onConnected();
+    void onStateChanged(QMqttClient::ClientState state);
+    void scheduleReconnect();
+    bool isDuplicate(int eventId, qint64 nowMs);
+    void onMessage(const QByteArray &message, const QMqttTopicName &topic);
+    // GUI 스레드
+    void drainEvents();
+    void dispatchRoutes(const QList<MqttEvent> &events);
+
+    struct Route {
+        QPointer<QObject> context;
+        RouteHandler      handler;
+    };
+    QHash<int, Route> routes_;            // GUI 스레드
+    int               nextRouteId_ = 1;
+    TopicRouter       router_;            // 네트워크 스레드
+
+    QThread      networkThread_;
+    QMqttClient *client;              // networkThread_ 소속
     QSslConfiguration sslConfig;
-    QString subscribeTopic;
+    QList<Subscription> subscriptions;
     QString publishTopic;
+    QString notificationFilter_ = QStringLiteral("#");
+    QString historyFilter_      = QStringLiteral("#");
     QString brokerUrl;
     bool useSSL = false;
+    bool certificatesLoaded_ = false;    // 네트워크 스레드
+
+    SpscQueue<MqttEvent, QueueCapacity> queue_;
+    std::atomic<bool>    drainScheduled_{false};
+    std::atomic<quint64> droppedCount_{0};   // 큐가 가득 차 버린 이벤트
+    std::atomic<bool>    stopping_{false};   // 의도한 종료 (재연결 안 함)
+
+    // 재연결/중복 제거 상태 (네트워크 스레드 전용)
+    QTimer       *reconnectTimer_;           // client 의 자식 → 같은 스레드
+    int           reconnectAttempts_ = 0;
+    bool          wasConnected_ = false;
+    QElapsedTimer disconnectedTimer_;
+    qint64        reconnectedAtMs_ = 0;
+    int           recoveredCount_ = 0;
+    std::atomic<qint64>  lastReconnectMs_{-1};
+    std::atomic<int>     lastReconnectAttempts_{0};
+    std::atomic<quint64> recoveredTotal_{0};
+    QHash<int, qint64> recentIds_;           // 이벤트 id → 수신 시각
+    QQueue<int>        recentOrder_;
+    quint64            duplicateCount_ = 0;
+
+    // 수신 통계 (GUI 스레드)
+    QElapsedTimer statsTimer_;
+    quint64       statsCount_ = 0;
+    std::size_t   statsMaxBatch_ = 0;
+
     void loadCertificates();
-    QString findCertificateFile(const QString &filename);
     QString findConfigFile();
 };
 
@@ -0,0 +1,36 @@
+// notificationdelegate.h
+#ifndef NOTIFICATIONDELEGATE_H
+#define NOTIFICATIONDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPixmap>
+
+/// 알림 한 줄 그리기 (유형별 배경/왼쪽 선/아이콘, 메시지, 시각, 반복 횟수, 삭제 버튼).
+/// 행마다 위젯을 만들지 않고 보이는 행만 그린다.
+class NotificationDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    explicit NotificationDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+signals:
+    void removeRequested(const QModelIndex &index);
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    static constexpr int ItemHeight = 72;
+    static constexpr int Spacing    = 2;   // 알림 간 간격
+
+    static QRect removeButtonRect(const QRect &itemRect);
+
+    QPixmap icons_[3];   // 유형별 아이콘 (40x40 으로 한 번만 축소)
+};
+
+#endif // NOTIFICATIONDELEGATE_H
@@ -0,0 +1,51 @@
+// notificationmodel.h
+#ifndef NOTIFICATIONMODEL_H
+#define NOTIFICATIONMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+
+/// 알림 한 줄. 같은 유형이 짧은 시간 안에 반복되면 새 줄 대신 count 를 올린다.
+struct NotificationEntry {
+    int     eventType = -1;
+    QString date;            // 표시용 (가장 최근 수신 시각)
+    qint64  lastSeenMs = 0;  // 마지막 수신 시각 (묶음 판단용, epoch ms)
+    int     count = 1;
+};
+
+/// 알림 목록 (최신이 0번 행). 최대 행 수를 넘으면 오래된 행부터 버린다.
+class NotificationModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Role {
+        EventTypeRole = Qt::UserRole + 1,
+        DateRole,
+        CountRole
+    };
+
+    explicit NotificationModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void setMaximumCount(int count);
+    int maximumCount() const { return maxCount_; }
+
+    /// 한 묶음을 맨 위에 한 번에 추가 (batch 는 최신이 앞)
+    void prependBatch(const QList<NotificationEntry> &batch);
+    /// windowMs 안에 받은 같은 유형의 행 (없으면 -1)
+    int findRecent(int eventType, qint64 nowMs, qint64 windowMs) const;
+    /// 기존 행에 반복 수신 반영 후 맨 위로 올림
+    void bump(int row, int count, const QString &date, qint64 lastSeenMs);
+    void removeEntry(int row);
+
+private:
+    void trim();
+
+    QList<NotificationEntry> entries_;
+    int                      maxCount_ = 200;
+};
+
+#endif // NOTIFICATIONMODEL_H
@@ -2,11 +2,14 @@
 #define NOTIFICATIONPANEL_H
 
 #include <QWidget>
+#include <QList>
+#include <QTimer>
+#include "notificationmodel.h"
+#include "mqttevent.h"
 
-class QVBoxLayout;
 class QLabel;
-class QScrollArea;
-class NotificationItem;  // 알림 항목 클래스 전방 선언
+class QListView;
+class QModelIndex;
 
 class NotificationPanel : public QWidget
 {
@@ -16,19 +19,36 @@ public:
     explicit NotificationPanel(QWidget *parent = nullptr);
     ~NotificationPanel();
 
+    /// 알림 추가 (바로 그리지 않고 다음 flush 때 한 번에 반영)
     void addNotification(int eventType, const QString &date);
 
 public slots:
-    void handleMqttMessage(const QByteArray &message);
+    /// 네트워크 스레드에서 해석을 마친 MQTT 이벤트 묶음
+    void handleMqttEvents(const QList<MqttEvent> &events);
 
 private slots:
-    void removeNotification(NotificationItem *item);
+    void flushPending();
+    void removeNotification(const QModelIndex &index);
 
 private:
-    QScrollArea *scrollArea;
-    QWidget *container;
-    QVBoxLayout *mainLayout;
-    QLabel *emptyLabel;
+    static constexpr int    FlushIntervalMs  = 16;     // 한 프레임에 한 번
+    static constexpr qint64 CoalesceWindowMs = 3000;   // 같은 유형을 한 줄로 묶는 시간
+    static constexpr int    MaxNotifications = 200;
+
+    void updateEmptyState();
+    void recordPaintLatency();
+
+    /// 지연 측정용 (payload timestamp, 수신 시각) - epoch ms
+    struct LatencySample { qint64 sentMs; qint64 receivedMs; };
+    static constexpr int MaxLatencySamples = 4096;   // 패널이 가려져 있을 때 상한
+
+    QListView               *listView;
+    NotificationModel       *model;
+    QLabel                  *emptyLabel;
+    QTimer                   flushTimer;
+    QList<NotificationEntry> pending;     // 아직 반영하지 않은 알림 (도착순)
+    QList<LatencySample>     pendingLatency;  // pending 과 함께 반영될 측정값
+    QList<LatencySample>     awaitingPaint;   // 목록에 반영됐고 아직 그려지지 않은 측정값
 };
 
 #endif // NOTIFICATIONPANEL_H
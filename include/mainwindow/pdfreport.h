@@ -0,0 +1,109 @@
+// pdfreport.h
+#ifndef PDFREPORT_H
+#define PDFREPORT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QThread>
+#include <memory>
+#include "historystore.h"
+
+class QPainter;
+class QPdfWriter;
+class ImageFetchPool;
+
+/// 보고서 한 건 (표시 문자열 + 원본 이미지 바이트)
+struct ReportItem
+{
+    QString    eventName;
+    QString    time;
+    QString    plate;
+    QString    speed;           // 표시용 ("-" 이면 없음)
+    QByteArray image;           // 촬영 이미지
+    QByteArray startImage;      // 정차 시작 이미지
+    QByteArray endImage;        // 1분 경과 이미지
+
+    static ReportItem fromRecord(const HistoryRecord &rec);
+};
+
+/// QPdfWriter 로 보고서를 직접 그리는 작성기 (화면 캡처를 쓰지 않음).
+/// 한 페이지에 여러 건을 배치하고 이미지는 원본 해상도 그대로 넣는다.
+/// 항목은 받는 즉시 그리고 버리므로 건수와 관계없이 메모리 사용이 일정하다.
+/// GUI 객체를 쓰지 않아 작업 스레드에서 사용할 수 있다.
+class PdfReportWriter
+{
+public:
+    PdfReportWriter(const QString &path, const QString &title);
+    ~PdfReportWriter();
+
+    bool begin();
+    bool addItem(const ReportItem &item);
+    bool finish();
+
+    int     pageCount() const { return pageCount_; }
+    QString errorString() const { return error_; }
+
+private:
+    void startPage();
+    void drawItem(const QRect &slot, const ReportItem &item);
+    void drawImage(const QRect &area, const QByteArray &data, const QString &caption);
+
+    QString                     path_;
+    QString                     title_;
+    std::unique_ptr<QPdfWriter> writer_;
+    std::unique_ptr<QPainter>   painter_;
+    QRect                       body_;           // 머리말/꼬리말을 뺀 영역
+    int                         slot_ = 0;       // 현재 페이지에서 다음에 그릴 칸
+    int                         pageCount_ = 0;
+    QString                     error_;
+};
+
+/// 히스토리 레코드로 PDF 보고서를 만드는 작업.
+/// 레코드 순서대로 이미지를 ImageFetchPool 로 받아 전용 스레드의
+/// PdfReportWriter 에 넘긴다. 받아 둔 이미지와 쓰기 대기 건수가 일정량을 넘으면
+/// 요청을 멈추므로 수천 건도 일정한 메모리로 처리한다.
+class PdfReportExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PdfReportExporter(QObject *parent = nullptr);
+    ~PdfReportExporter();
+
+    void start(const QString &pdfPath, const QList<HistoryRecord> &records,
+               const QString &host, quint16 port);
+    void cancel();
+    bool isRunning() const { return running_; }
+
+signals:
+    void progressChanged(int done, int total);
+    void finished(const QString &path, int records, int pages);
+    void failed(const QString &error);
+    void canceled();
+
+private:
+    void onImageResolved(const QString &path, const QByteArray &data);
+    void dispatchReady();
+    void updateFlowControl();
+    void onItemWritten(int job, bool ok, const QString &error);
+    void finishReport();
+    void stopWriter();
+
+    ImageFetchPool             *pool_;
+    QThread                     writerThread_;
+    QObject                    *writerContext_;
+    PdfReportWriter            *writer_ = nullptr;    // 쓰기 스레드에서만 접근
+    QList<HistoryRecord>        records_;
+    QHash<QString, int>         refs_;                // 경로 → 아직 쓰지 않은 레코드의 참조 수
+    QHash<QString, QByteArray>  resolved_;            // 받은 이미지 (실패는 빈 값)
+    QString                     path_;
+    int                         next_ = 0;            // 다음에 쓰기 스레드로 넘길 레코드
+    int                         written_ = 0;
+    int                         backlog_ = 0;
+    int                         job_ = 0;
+    bool                        running_ = false;
+};
+
+#endif // PDFREPORT_H
@@ -0,0 +1,63 @@
+// platesearchindex.h
+#ifndef PLATESEARCHINDEX_H
+#define PLATESEARCHINDEX_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+/// 번호판 검색 색인. 레코드가 들어올 때마다 증분으로 추가되며
+/// 앞부분/뒷부분/중간 일치와 편집 거리 1 (OCR 오인식 허용) 검색을 지원한다.
+///
+/// 번호판은 fold() 로 정규화한 키 단위로 묶고, 키를 정렬한 배열과
+/// 뒤집은 키를 정렬한 배열 두 개만 유지한다. 편집 거리 1 이내의 키는
+/// 질의의 앞쪽 절반을 접두어로 갖거나 뒤쪽 절반을 접미어로 가지므로
+/// 두 배열의 이진 탐색 범위만 확인하면 된다.
+/// 중간 일치("가34" → "12가3456")는 키의 두 글자 조각(bigram)별 항목 목록에서
+/// 가장 짧은 목록의 후보만 확인한다.
+class PlateSearchIndex
+{
+public:
+    /// 공백/구분자 제거, 대문자화, OCR 에서 자주 혼동되는 문자 통합
+    /// (O/D/Q→0, I/L→1, Z→2, S→5, G→6, B→8, 한글 모음 ㅓ→ㅏ, ㅜ→ㅗ 등)
+    static QString fold(const QString &plate);
+
+    void clear();
+    void add(int id, const QString &plate);
+
+    int keyCount() const { return int(keys_.size()); }
+
+    QList<int> prefixMatches(const QString &prefix);
+    QList<int> suffixMatches(const QString &suffix);
+    /// 정규화한 번호판 어디에든 text 가 들어 있는 레코드 (앞/뒷부분 일치 포함)
+    QList<int> infixMatches(const QString &text);
+    /// 정규화한 번호판 전체가 편집 거리 1 이내인 레코드
+    QList<int> fuzzyMatches(const QString &plate);
+
+    /// 검색창 입력용: 중간 일치(앞/뒷부분 포함) ∪ (4자 이상이면) 편집 거리 1
+    QSet<int> search(const QString &text);
+    /// 번호판 하나가 search(text) 에 걸리는지 (색인에 넣기 전 레코드 대조용)
+    static bool matches(const QString &plate, const QString &text);
+
+private:
+    void ensureSorted();
+    QList<int> entriesWithPrefix(const QList<int> &order, const QList<QString> &keys,
+                                 const QString &prefix) const;
+    QList<int> fuzzyEntries(const QString &folded);
+    QList<int> infixEntries(const QString &folded) const;
+    static quint32 bigramKey(QChar a, QChar b) { return quint32(a.unicode()) << 16 | b.unicode(); }
+    void appendIds(const QList<int> &entries, QList<int> &out) const;
+    static bool withinOneEdit(const QString &a, const QString &b);
+
+    QHash<QString, int> entryByKey_;   // 정규화 키 → 항목 번호
+    QList<QString>      keys_;
+    QList<QString>      reversed_;     // 뒤집은 키 (접미어 검색용)
+    QList<QList<int>>   ids_;          // 항목별 레코드 id
+    QList<int>          byKey_;        // 키 순으로 정렬한 항목 번호
+    QList<int>          byReversed_;   // 뒤집은 키 순으로 정렬한 항목 번호
+    QHash<quint32, QList<int>> bigrams_;  // 두 글자 조각 → 그 조각을 가진 항목 (오름차순)
+    qsizetype           sortedCount_ = 0;  // 정렬 배열에 반영된 항목 수
+};
+
+#endif // PLATESEARCHINDEX_H
@@ -50,11 +50,6 @@ private:
     QPushButton *plusButton;
 
     QButtonGroup *modeGroup;
-
-    QString sliderStyleGray;
-    QString sliderStyleOrange;
-    QString textStyleGray;
-    QString textStyleOrange;
 };
 
 #endif // PROCSETTINGBOX_H
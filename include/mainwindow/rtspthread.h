@@ -18,7 +18,8 @@ public:
     void stop();
 
 signals:
-    void frameReady(const QImage &frame);  // 새로운 프레임 도착 시 시그널
+    /// 새로운 프레임 도착 시 시그널. captureUs 는 프레임을 읽어 온 시각 (LatencyTracker::nowUs)
+    void frameReady(const QImage &frame, qint64 captureUs);
 
 protected:
     void run() override;  // QThread 메인 루프
@@ -0,0 +1,73 @@
+// spscqueue.h
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/// 단일 생산자/단일 소비자 고정 크기 링 버퍼 (잠금 없음).
+/// tryPush 는 생산자 스레드 하나에서만, tryPop 은 소비자 스레드 하나에서만 호출해야 한다.
+/// 상대편 위치는 가득 참/빔을 만났을 때만 다시 읽어 캐시 라인 왕복을 줄인다.
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity 는 2의 거듭제곱이어야 합니다");
+
+public:
+    SpscQueue() : slots_(new T[Capacity]) {}
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /// 생산자: 가득 차 있으면 false (value 는 그대로)
+    bool tryPush(T &&value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity)
+                return false;
+        }
+        slots_[tail & Mask] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// 소비자: 비어 있으면 false
+    bool tryPop(T &out)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+                return false;
+        }
+        out = std::move(slots_[head & Mask]);
+        slots_[head & Mask] = T();   // 꺼낸 항목이 잡고 있던 메모리는 바로 놓는다
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// 대략적인 길이 (통계용)
+    std::size_t sizeApprox() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    std::unique_ptr<T[]> slots_;
+
+    // 생산자/소비자가 쓰는 값은 서로 다른 캐시 라인에 둔다
+    alignas(64) std::atomic<std::size_t> head_{0};   // 소비자가 다음에 읽을 위치
+    std::size_t                           cachedTail_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0};   // 생산자가 다음에 쓸 위치
+    std::size_t                           cachedHead_ = 0;
+};
+
+#endif // SPSCQUEUE_H
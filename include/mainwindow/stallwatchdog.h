@@ -0,0 +1,106 @@
+// stallwatchdog.h
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <atomic>
+
+class StallMonitorThread;
+
+/// GUI 이벤트 루프 멈춤 감지기.
+/// GUI 스레드의 타이머가 HeartbeatMs 마다 박동을 남기고, 감시 스레드가 박동이
+/// 임계값보다 오래 끊기면 그때 실행 중이던 구간/이벤트와 GUI 스레드 스택을 기록한다.
+/// 멈춤은 구간(또는 이벤트)별로 모아 보고서로 만든다 (진단 페이지, 종료 시 로그).
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DefaultThresholdMs = 200;
+    static constexpr int HeartbeatMs        = 50;
+    static constexpr int MaxFrames          = 32;
+
+    /// 감시할 스레드(GUI 스레드)에서 만든다. 한 프로세스에 하나만
+    explicit StallWatchdog(int thresholdMs = DefaultThresholdMs, QObject *parent = nullptr);
+    ~StallWatchdog();
+
+    /// 만들어져 있지 않으면 nullptr
+    static StallWatchdog *instance();
+
+    struct Offender
+    {
+        QString     context;        // 구간 이름 또는 "이벤트 → 받는 클래스"
+        int         count   = 0;
+        qint64      totalMs = 0;
+        qint64      maxMs   = 0;
+        QStringList stack;          // 가장 길었던 멈춤의 스택 (위가 안쪽)
+    };
+
+    int  thresholdMs() const { return thresholdMs_; }
+    quint64 stallCount() const { return stallCount_.load(std::memory_order_relaxed); }
+
+    /// 누적 시간이 긴 순서
+    QList<Offender> offenders() const;
+    QString report() const;
+    void reset();
+
+    /// 오래 걸릴 수 있는 GUI 스레드 구간 표시 (RAII). 멈춤이 이 안에서 감지되면
+    /// 보고서에 이 이름이 남는다. name 은 문자열 리터럴이어야 한다 (포인터만 저장).
+    /// 감지기가 없어도 포인터 교환 한 번이라 그대로 두어도 된다.
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name)
+            : previous_(current_.exchange(name, std::memory_order_relaxed)) {}
+        ~Scope() { current_.store(previous_, std::memory_order_relaxed); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        friend class StallWatchdog;
+        static inline std::atomic<const char *> current_{nullptr};
+        const char *previous_;
+    };
+
+protected:
+    // GUI 스레드의 모든 이벤트 앞에서 받는 객체와 종류만 기록한다
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    friend class StallMonitorThread;
+
+    struct Stall
+    {
+        QString     context;
+        qint64      durationMs = 0;
+        QStringList stack;
+    };
+
+    void monitorLoop();
+    QString currentContext() const;
+    QStringList sampleStack();
+    void recordStall(const Stall &stall);
+
+    const int            thresholdMs_;
+    QTimer               heartbeat_;
+    StallMonitorThread  *monitor_ = nullptr;
+
+    // GUI 스레드가 쓰고 감시 스레드가 읽는다
+    std::atomic<qint64>        lastBeatUs_{0};          // 0 이면 아직 이벤트 루프가 돌지 않음
+    std::atomic<const char *>  lastReceiver_{nullptr};  // 클래스 이름 (정적 문자열)
+    std::atomic<int>           lastEvent_{0};
+    std::atomic<bool>          stopping_{false};
+
+    std::atomic<quint64>       stallCount_{0};
+    mutable QMutex             mutex_;                  // offenders_ 보호
+    QHash<QString, Offender>   offenders_;
+};
+
+#endif // STALLWATCHDOG_H
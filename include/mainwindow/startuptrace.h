@@ -0,0 +1,23 @@
+// startuptrace.h
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QString>
+
+/// 로그인 직후부터 첫 영상 프레임이 그려지기까지의 단계별 시각.
+/// 어느 스레드에서나 mark 할 수 있고, finish 가 불리면 타임라인을
+/// quadqt.startup 로그로 한 번 남긴 뒤 이후 기록은 무시한다.
+namespace StartupTrace {
+
+/// 로그인 성공 시점 (이전 기록은 지움)
+void begin();
+/// stage 는 문자열 리터럴. 같은 단계는 처음 한 번만 기록한다 (매 프레임 불러도 됨)
+void mark(const char *stage);
+/// 마지막 단계를 기록하고 타임라인 출력
+void finish(const char *stage);
+/// 지금까지의 타임라인 (진단용)
+QString timeline();
+
+} // namespace StartupTrace
+
+#endif // STARTUPTRACE_H
@@ -5,6 +5,11 @@
 #include <QtNetwork/QSslSocket>
 #include <QtNetwork/QSslError>
 #include <QJsonObject>
+#include <QQueue>
+#include "historystreamparser.h"
+#include "historywire.h"
+#include "wirecompression.h"
+#include "metricsregistry.h"
 
 class TcpHistoryHandler : public QObject
 {
@@ -15,10 +20,19 @@ public:
 
     /// 서버(SSL) 연결
     void connectToServer(const QString &host, quint16 port);
+    /// 연결을 바로 끊는다 (받던 응답은 버림)
+    void disconnectFromServer();
     
     /// 연결 상태 확인
     bool isConnected() const;
 
+    /// 서버와 바이너리 히스토리 형식을 협상했는지 (아니면 JSON)
+    bool isBinaryWire() const { return binaryWire_; }
+
+    /// 응답 압축 요청 (minBytes 이상인 응답만 압축, 0 이면 요청하지 않음).
+    /// 다음 연결의 HELLO 부터 적용된다
+    void setCompression(int minBytes) { compressMinBytes_ = minBytes; }
+
     /// API 호출
     void getHistory(const QString &email, int limit, int offset);
     void getHistoryByEventType(const QString &email, int eventType, int limit, int offset);
@@ -37,8 +51,11 @@ signals:
     void connected();
     /// 서버 연결 실패 시
     void connectionFailed();
-    /// 서버로부터 JSON 응답 수신 시
-    void historyDataReady(const QJsonObject &response);
+    /// 응답의 data[] 레코드가 도착하는 대로 조각 단위로 전달
+    /// (firstBatch: 새 응답의 첫 조각이면 true)
+    void historyRecordsReady(const QList<HistoryRecord> &records, bool firstBatch);
+    /// 응답 하나의 수신 완료 (data 를 제외한 최상위 필드와 레코드 수)
+    void historyFinished(const QJsonObject &header, int recordCount);
     /// 오류 발생 시
     void errorOccurred(const QString &errorString);
 
@@ -48,9 +65,26 @@ private slots:
     void onSslErrors(const QList<QSslError> &errors);
     void onSocketError(QAbstractSocket::SocketError error);
     void onDisconnected();
+    void onHelloTimeout();
 
 private:
     QSslSocket *socket_;
+    HistoryStreamParser jsonDecoder_;
+    HistoryWireDecoder  wireDecoder_;
+    WireFrameReader     wireReader_;
+    HistoryDecoder *decoder_  = nullptr;  // 현재 응답의 디코더 (응답 사이에는 nullptr)
+    bool firstBatch_   = true;     // 현재 응답에서 아직 레코드를 보내지 않았는지
+    bool resyncing_    = false;    // JSON 파싱 오류 후 다음 줄바꿈까지 버리는 중
+    bool helloPending_ = false;    // HELLO 응답 대기 중 (시간 초과 전)
+    bool helloUnanswered_ = false; // HELLO 응답을 아직 받지 못함 (시간 초과 뒤에도 유지)
+    bool binaryWire_   = false;
+    int  compressMinBytes_ = WireCompression::DefaultMinBytes;
+    // 응답 시간 측정 (응답은 보낸 순서대로 온다)
+    struct PendingCommand { MetricsRegistry::Timing timing; qint64 startUs; };
+    QQueue<PendingCommand> pendingCommands_;
+    qint64 handshakeStartUs_ = 0;
+    qint64 decodeUs_ = 0;      // 현재 응답을 디코드하는 데 쓴 시간 (진단 페이지가 열려 있을 때만)
+    bool finishResponse();     // 이후 바이트를 압축 프레임으로 읽어야 하면 true
+    static bool isHelloReply(const QJsonObject &header);
     void sendCommand(const QString &cmd);
-    QString findCertificateFile(const QString &filename);
 };
@@ -26,7 +26,6 @@ private slots:
 
 private:
     void sendGetImageRequest();
-    QString findCertificateFile(const QString &filename);
 
     QSslSocket* socket_;
     QByteArray buffer_;
@@ -35,6 +34,8 @@ private:
     quint16 port_;
     quint64 expectedSize_ = 0;
     bool headerParsed_ = false;
+    qint64 handshakeStartUs_ = 0;   // MetricsRegistry 측정 시작 시각 (꺼져 있으면 0)
+    qint64 requestStartUs_ = 0;
 };
 
 #endif // TCPIMAGEHANDLER_H
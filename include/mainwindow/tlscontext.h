@@ -0,0 +1,38 @@
+// tlscontext.h
+#ifndef TLSCONTEXT_H
+#define TLSCONTEXT_H
+
+#include <QFuture>
+#include <QList>
+#include <QSslCertificate>
+#include <QSslConfiguration>
+#include <QSslKey>
+#include <QString>
+
+/// 클라이언트 인증서/개인키/CA 를 프로세스에서 한 번만 읽어 공유한다.
+/// TcpHistoryHandler, TcpImageHandler(ImageFetchPool), MqttManager 가 같은 자료를 쓴다.
+/// 첫 호출이 파일을 읽고, 동시에 부른 다른 스레드는 읽기가 끝날 때까지 기다린다.
+class TlsContext
+{
+public:
+    struct Material
+    {
+        QSslKey                privateKey;
+        QSslCertificate        localCertificate;
+        QList<QSslCertificate> caCertificates;
+    };
+
+    static const Material &material();
+
+    /// 기본 설정(QSslConfiguration::defaultConfiguration) + 위 자료.
+    /// 기본 설정을 바꾸는 코드(MainWindow) 뒤에 처음 불려야 한다.
+    static QSslConfiguration clientConfiguration();
+
+    /// 작업 스레드에서 미리 읽어 둔다 (로그인 직후 시작 단계, 끝나면 "tls.ready")
+    static QFuture<void> preload();
+
+    /// 리소스(:/certs) → 실행/작업 디렉터리 주변 순서로 인증서 파일 검색
+    static QString findCertificateFile(const QString &filename);
+};
+
+#endif // TLSCONTEXT_H
@@ -36,6 +36,8 @@ private slots:
 private:
     void setupIcons();
     void updateButtonStates();
+    void applyIcon(QLabel *label, const QString &resource, const QString &fallbackPath,
+                   const QString &fallbackText, bool active);
     void showUserMenu();
     QRect getCameraRect() const;
     QRect getDocumentRect() const;
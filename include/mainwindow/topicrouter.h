@@ -0,0 +1,50 @@
+// topicrouter.h
+#ifndef TOPICROUTER_H
+#define TOPICROUTER_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <memory>
+
+/// 토픽 필터와 일치한 경로 하나
+struct TopicMatch
+{
+    int         route = -1;
+    QStringList captures;   // '+' 자리에 온 토픽 단계들 (필터 순서대로)
+};
+
+/// MQTT 토픽 필터('+' 한 단계, '#' 나머지 전부) 트라이.
+/// 수신 토픽을 '/' 단계로 나눠 단계마다 해시 조회만 하므로
+/// 등록된 경로 수와 상관없이 토픽 길이에 비례한 시간에 일치하는 경로를 모두 찾는다.
+/// 스레드 안전하지 않다 (한 스레드에서만 사용).
+class TopicRouter
+{
+public:
+    TopicRouter();
+    ~TopicRouter();
+
+    /// 필터 등록. 형식이 잘못되면 false ('#' 는 마지막 단계에만, '+'/'#' 는 단계 전체여야 함)
+    bool addRoute(const QString &filter, int route);
+    void removeRoute(int route);
+    bool isEmpty() const { return routeCount_ == 0; }
+
+    /// topic 과 일치하는 모든 경로를 out 에 추가
+    void match(QStringView topic, QList<TopicMatch> &out) const;
+
+    static bool isValidFilter(const QString &filter);
+
+private:
+    struct Node;
+
+    void matchLevel(const Node *node, const QList<QStringView> &levels, int index,
+                    QStringList &captures, QList<TopicMatch> &out) const;
+    static bool removeFrom(Node *node, int route);
+
+    std::unique_ptr<Node> root_;
+    int                   routeCount_ = 0;
+};
+
+#endif // TOPICROUTER_H
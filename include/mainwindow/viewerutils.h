@@ -0,0 +1,16 @@
+#ifndef VIEWERUTILS_H
+#define VIEWERUTILS_H
+
+#include <QRegularExpression>
+#include <functional>
+
+class QWidget;
+
+// 파일명 라벨의 HTML 태그 제거용 (정규식은 한 번만 컴파일)
+const QRegularExpression &htmlTagRegex();
+
+// 좌/우(또는 PageUp/PageDown) 키로 이전/다음 레코드 (step: -1 / +1).
+// 키 이벤트로 받으면 포커스를 가진 버튼이 방향키를 먼저 가져가므로 창 단축키로 받는다
+void addNavigationShortcuts(QWidget *view, const std::function<void(int step)> &navigate);
+
+#endif // VIEWERUTILS_H
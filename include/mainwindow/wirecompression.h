@@ -0,0 +1,66 @@
+// wirecompression.h
+#ifndef WIRECOMPRESSION_H
+#define WIRECOMPRESSION_H
+
+#include <QByteArray>
+#include <QString>
+
+/// 명령 채널 응답 압축 (HELLO 에서 "compress=deflate" 협상).
+/// 협상된 세션에서는 서버가 HELLO 응답 이후의 모든 응답을 프레임으로 보낸다.
+///
+///   frame := type:u8 len:u32be payload
+///   type  := 'R' (원본) | 'Z' (qCompress 형식: 원본 길이 u32be + zlib 스트림)
+///
+/// 서버는 compress_min 바이트보다 작거나 압축 이득이 없는 응답은 'R' 로 보낸다.
+namespace WireCompression {
+    constexpr const char *Name = "deflate";
+    constexpr char RawFrame     = 'R';
+    constexpr char DeflateFrame = 'Z';
+    constexpr int  HeaderSize   = 5;
+    constexpr int  DefaultMinBytes = 512;
+}
+
+/// 채널별 전송량/압축 해제 비용 누계
+struct WireStats
+{
+    quint64 wireBytesIn      = 0;   // 소켓에서 받은 바이트
+    quint64 payloadBytesIn   = 0;   // 압축 해제 후 바이트
+    quint64 bytesOut         = 0;   // 보낸 명령 바이트
+    quint64 compressedFrames = 0;
+    quint64 rawFrames        = 0;
+    qint64  inflateNs        = 0;   // 압축 해제에 쓴 시간
+
+    double ratio() const { return payloadBytesIn ? double(wireBytesIn) / double(payloadBytesIn) : 1.0; }
+};
+
+/// 수신 바이트에서 압축 프레임을 풀어 평문 응답 스트림을 돌려준다.
+/// 협상 전(framed 아님)에는 받은 바이트를 그대로 통과시킨다.
+/// 전송량과 압축 해제 시간은 연결별 누계(stats)와 함께 MetricsRegistry 에도 기록한다.
+class WireFrameReader
+{
+public:
+    void reset();
+
+    bool isFramed() const { return framed_; }
+    /// 이후 바이트를 프레임으로 해석. pending 은 이미 평문으로 넘겼지만
+    /// 아직 처리하지 않은 바이트 (협상 응답 뒤에 붙어 온 부분)
+    QByteArray enableFraming(const char *pending, qsizetype size);
+
+    QByteArray read(const QByteArray &wire);
+
+    bool hasError() const { return !error_.isEmpty(); }
+    QString errorString() const { return error_; }
+
+    void addBytesOut(qint64 n);
+    const WireStats &stats() const { return stats_; }
+
+private:
+    QByteArray unframe(const char *data, qsizetype size);
+
+    QByteArray buffer_;
+    bool       framed_ = false;
+    WireStats  stats_;
+    QString    error_;
+};
+
+#endif // WIRECOMPRESSION_H
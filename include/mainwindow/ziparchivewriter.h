@@ -0,0 +1,50 @@
+// ziparchivewriter.h
+#ifndef ZIPARCHIVEWRITER_H
+#define ZIPARCHIVEWRITER_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <QSaveFile>
+#include <QString>
+
+/// 압축하지 않는(stored) ZIP 파일을 앞에서부터 순서대로 쓰는 작성기.
+/// 항목은 받는 즉시 로컬 헤더와 함께 기록하고 중앙 디렉터리는 finish() 에서 쓴다.
+/// JPEG/PNG 는 이미 압축되어 있어 deflate 이득이 거의 없으므로 stored 만 지원한다.
+/// ZIP64 는 지원하지 않는다 (4GB / 65535 항목 초과 시 오류).
+/// QSaveFile 을 사용하므로 finish() 전에 실패/취소하면 대상 파일은 바뀌지 않는다.
+class ZipArchiveWriter
+{
+public:
+    explicit ZipArchiveWriter(const QString &path);
+
+    bool open();
+    bool addFile(const QString &name, const QByteArray &data,
+                 const QDateTime &modified = QDateTime::currentDateTime());
+    bool finish();
+    void abort();
+
+    int     entryCount() const { return int(entries_.size()); }
+    QString errorString() const { return error_; }
+
+    static quint32 crc32(const char *data, qsizetype size);
+
+private:
+    struct Entry {
+        QByteArray name;        // UTF-8
+        quint32    crc;
+        quint32    size;
+        quint32    offset;
+        quint16    dosTime;
+        quint16    dosDate;
+    };
+
+    bool writeBytes(const QByteArray &bytes);
+
+    QSaveFile    file_;
+    QList<Entry> entries_;
+    quint64      offset_ = 0;
+    QString      error_;
+};
+
+#endif // ZIPARCHIVEWRITER_H
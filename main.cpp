@@ -4,9 +4,13 @@
 #include <QPixmap>
 #include "login/loginpage.h"
 #include "mainwindow/mainwindow.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/stallwatchdog.h"
+#include "mainwindow/startuptrace.h"
 #include <QFontDatabase>
 #include <QFont>
 #include <QIcon>
+#include <QSettings>
 
 QString g_hanwhaGothicFontFamily;
 QString g_hanwhaFontFamily;
@@ -56,6 +60,17 @@ int main(int argc, char *argv[])
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     
     QApplication app(argc, argv);
+
+    // 로그는 백그라운드 스레드에서 출력 (분류 규칙/파일은 config.ini [log])
+    // GUI 멈춤 감지기는 이벤트 루프가 돌기 시작한 뒤부터 판정한다 (config.ini [watchdog])
+    StallWatchdog *watchdog = nullptr;
+    {
+        QSettings settings("config.ini", QSettings::IniFormat);
+        Logging::install(settings.value("log/rules").toString(),
+                         settings.value("log/file").toString());
+        if (settings.value("watchdog/enabled", true).toBool())
+            watchdog = new StallWatchdog(settings.value("watchdog/stall_ms", StallWatchdog::DefaultThresholdMs).toInt());
+    }
     
     // 애플리케이션 아이콘 설정
     app.setWindowIcon(QIcon(":/images/logo.png"));
@@ -71,11 +86,13 @@ int main(int argc, char *argv[])
         if (login.exec() == QDialog::Accepted) {
             // 로그인 성공 - 메인 윈도우 생성
             QString loggedInEmail = login.getLoggedInEmail();
+            StartupTrace::begin();   // 여기서부터 첫 영상 프레임까지 단계별 시각 기록
             
             MainWindow *w = new MainWindow();
             w->setUserEmail(loggedInEmail);  // 사용자 이메일 설정
             w->setAttribute(Qt::WA_DeleteOnClose);  // 닫힐 때 자동 삭제
             w->show();
+            StartupTrace::mark("window.shown");
             
             // 메인 윈도우가 닫힐 때까지 대기
             int result = app.exec();
@@ -93,5 +110,11 @@ int main(int argc, char *argv[])
         }
     }
     
+    if (watchdog) {
+        if (watchdog->stallCount() > 0)
+            qCInfo(lcUi).noquote() << watchdog->report();
+        delete watchdog;
+    }
+    Logging::shutdown();
     return 0;
 }
@@ -1,17 +1,22 @@
 #include "login/networkmanager.h"
-#include <QDebug>
+#include "mainwindow/logging.h"
 #include <QJsonParseError>
+#include <utility>
 
 NetworkManager::NetworkManager(QObject *parent)
     : QObject(parent)
     , m_socket(new QSslSocket(this))
     , m_timeoutTimer(new QTimer(this))
+    , m_helloTimer(new QTimer(this))
     , m_serverPort(8080)
     , m_timeout(5000)
     , m_sslEnabled(false)
     , m_caCertPath("ca.cert.pem")
     , m_clientCertPath("client.cert.pem")
     , m_clientKeyPath("client.key.pem")
+    , m_compressMinBytes(WireCompression::DefaultMinBytes)
+    , m_helloPending(false)
+    , m_helloUnanswered(false)
 {
     // 소켓 시그널 연결
     connect(m_socket, &QSslSocket::connected, this, &NetworkManager::onConnected);
@@ -28,14 +33,19 @@ NetworkManager::NetworkManager(QObject *parent)
     // 연결 타임아웃 타이머 설정
     m_timeoutTimer->setSingleShot(true);
     connect(m_timeoutTimer, &QTimer::timeout, this, &NetworkManager::onTimeout);
+
+    // HELLO 응답 대기 타이머 (응답 없는 예전 서버는 무압축으로 진행)
+    m_helloTimer->setSingleShot(true);
+    m_helloTimer->setInterval(HelloTimeoutMs);
+    connect(m_helloTimer, &QTimer::timeout, this, &NetworkManager::onHelloTimeout);
     
     // SSL 지원 여부 확인
     if (!QSslSocket::supportsSsl()) {
-        qDebug() << "[SSL] 시스템에서 SSL이 지원되지 않습니다.";
-        qDebug() << "[SSL] 라이브러리 버전:" << QSslSocket::sslLibraryVersionString();
+        qCWarning(lcTcp) << "시스템에서 SSL이 지원되지 않습니다.";
+        qCWarning(lcTcp) << "라이브러리 버전:" << QSslSocket::sslLibraryVersionString();
         m_sslEnabled = false;
     } else {
-        qDebug() << "[SSL] SSL 지원 확인됨. 버전:" << QSslSocket::sslLibraryVersionString();
+        qCDebug(lcTcp) << "SSL 지원 확인됨. 버전:" << QSslSocket::sslLibraryVersionString();
     }
     
     // 설정 파일 로드
@@ -59,7 +69,7 @@ void NetworkManager::loadConfig()
     // config.ini 파일 경로 찾기
     QString configPath = findConfigFile();
     if (configPath.isEmpty()) {
-        qDebug() << "[TCP] config.ini 파일을 찾을 수 없습니다. 기본 설정을 사용합니다.";
+        qCWarning(lcConfig) << "config.ini 파일을 찾을 수 없습니다. 기본 설정을 사용합니다.";
         return;
     }
     
@@ -67,7 +77,7 @@ void NetworkManager::loadConfig()
     
     // 설정 파일 상태 확인
     if (settings.status() != QSettings::NoError) {
-        qDebug() << "[TCP] 설정 파일 읽기 오류:" << settings.status();
+        qCWarning(lcConfig) << "설정 파일 읽기 오류:" << settings.status();
         return;
     }
     
@@ -75,6 +85,7 @@ void NetworkManager::loadConfig()
     m_serverIp = settings.value("tcp/ip", "192.168.0.10").toString();
     m_serverPort = settings.value("tcp/port", 8080).toInt();
     m_timeout = settings.value("tcp/timeout", 5000).toInt();
+    m_compressMinBytes = settings.value("tcp/compress_min_bytes", WireCompression::DefaultMinBytes).toInt();
     
     // SSL 설정 로드
     m_sslEnabled = settings.value("SSL/enabled", false).toBool();
@@ -82,8 +93,8 @@ void NetworkManager::loadConfig()
     m_clientCertPath = settings.value("SSL/client_cert", "client.cert.pem").toString();
     m_clientKeyPath = settings.value("SSL/client_key", "client.key.pem").toString();
     
-    qDebug() << "[TCP] 서버 설정 로드 - IP:" << m_serverIp << "포트:" << m_serverPort;
-    qDebug() << "[SSL] SSL 활성화:" << m_sslEnabled;
+    qCDebug(lcConfig) << "서버 설정 로드 - IP:" << m_serverIp << "포트:" << m_serverPort;
+    qCDebug(lcConfig) << "SSL 활성화:" << m_sslEnabled;
 }
 
 void NetworkManager::connectToServer()
@@ -95,7 +106,7 @@ void NetworkManager::connectToServer()
             return;
         }
         
-        qDebug() << "[TCP] 서버 연결 시도 (비암호화):" << m_serverIp << ":" << m_serverPort;
+        qCDebug(lcTcp) << "서버 연결 시도 (비암호화):" << m_serverIp << ":" << m_serverPort;
         m_socket->connectToHost(m_serverIp, m_serverPort);
         
         // 연결 타임아웃 설정
@@ -114,7 +125,7 @@ void NetworkManager::connectToServerSSL()
         return;
     }
     
-    qDebug() << "[TCP] 서버 SSL 연결 시도:" << m_serverIp << ":" << m_serverPort;
+    qCDebug(lcTcp) << "서버 SSL 연결 시도:" << m_serverIp << ":" << m_serverPort;
     m_socket->setSslConfiguration(m_sslConfig);
     m_socket->connectToHostEncrypted(m_serverIp, m_serverPort);
     
@@ -154,7 +165,7 @@ void NetworkManager::registerUser(const QString &email, const QString &password)
 void NetworkManager::loginUser(const QString &email, const QString &password)
 {
     if (!isConnected()) {
-        qDebug() << "[TCP] 로그인 실패: 서버에 연결되지 않음";
+        qCWarning(lcTcp) << "로그인 실패: 서버에 연결되지 않음";
         emit networkError("서버에 연결되지 않았습니다.");
         return;
     }
@@ -162,7 +173,7 @@ void NetworkManager::loginUser(const QString &email, const QString &password)
     QString command = QString("LOGIN %1 %2").arg(email, password);
     m_pendingCommand = "LOGIN";
     
-    qDebug() << "[TCP] 로그인 명령 전송:" << command;
+    qCDebug(lcTcp) << "로그인 명령 전송:" << command;
     sendCommand(command);
 }
 
@@ -181,32 +192,124 @@ void NetworkManager::resetPassword(const QString &email, const QString &newPassw
 void NetworkManager::onConnected()
 {
     m_timeoutTimer->stop();
-    qDebug() << "[TCP] 서버 연결 성공";
+    qCDebug(lcTcp) << "서버 연결 성공";
+    if (m_sslEnabled)
+        m_handshakeStartUs = MetricsRegistry::start();
+    // SSL 은 암호화 완료(onEncrypted) 후에 협상
+    if (!m_sslEnabled) {
+        sendHello();
+    }
     emit connected();
 }
 
+void NetworkManager::sendHello()
+{
+    m_wireReader.reset();
+    m_responseBuffer.clear();
+    m_helloTimer->stop();
+    m_helloPending = false;
+    m_helloUnanswered = false;
+    if (m_compressMinBytes <= 0 || m_socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    // 응답 압축 지원을 알린다. 서버가 모르는 명령으로 거절하면 무압축 유지.
+    // 명령 응답 측정(m_commandTiming)과 섞이지 않도록 sendCommand 를 거치지 않는다
+    const QString hello = QString("HELLO compress=%1 compress_min=%2")
+                              .arg(WireCompression::Name).arg(m_compressMinBytes);
+    m_wireReader.addBytesOut(m_socket->write(hello.toUtf8() + "\n"));
+    m_socket->flush();
+    m_helloStartUs = MetricsRegistry::start();
+    m_helloPending = true;
+    m_helloUnanswered = true;
+    m_helloTimer->start();
+}
+
+void NetworkManager::onHelloTimeout()
+{
+    if (!m_helloPending) return;
+    qCDebug(lcTcp) << "HELLO 응답 없음, 무압축으로 진행";
+    // 늦게 온 응답은 m_helloUnanswered 로 알아보고 버린다
+    m_helloPending = false;
+    m_helloStartUs = 0;
+}
+
+bool NetworkManager::isHelloReply(const QJsonObject &response)
+{
+    // 지원 서버는 message "HELLO" (+ compress) 로, 예전 서버는 모르는 명령으로 답한다
+    const QString message = response.value("message").toString();
+    return response.contains("compress")
+        || message == QLatin1String("HELLO")
+        || message == QLatin1String("Unknown command");
+}
+
 void NetworkManager::onDisconnected()
 {
     m_timeoutTimer->stop();
-    qDebug() << "[TCP] 서버 연결 해제";
+    qCDebug(lcTcp) << "서버 연결 해제";
+    m_helloTimer->stop();
+    m_helloPending = false;
+    m_helloUnanswered = false;
+    m_commandStartUs = 0;
+    m_helloStartUs = 0;
+    m_responseBuffer.clear();
     emit disconnected();
 }
 
 void NetworkManager::onReadyRead()
 {
-    QByteArray data = m_socket->readAll();
-    m_responseBuffer.append(QString::fromUtf8(data));
+    QByteArray data = m_wireReader.read(m_socket->readAll());
+    if (m_wireReader.hasError()) {
+        qCWarning(lcTcp) << "응답 프레임 오류:" << m_wireReader.errorString();
+        emit networkError("서버 응답 형식 오류");
+        m_socket->abort();
+        return;
+    }
+    m_responseBuffer.append(data);
+
+    if (m_helloUnanswered) {
+        // 연결 후 첫 응답은 보통 HELLO 에 대한 것 (한 줄). 서버가 HELLO 를 무시했거나
+        // 시간 초과 뒤라면 명령(LOGIN 등) 응답이 먼저 올 수 있어 내용으로 가린다
+        qsizetype end = m_responseBuffer.indexOf('\n');
+        if (end < 0) {
+            if (!m_responseBuffer.contains('}')) return;
+            end = m_responseBuffer.size() - 1;
+        }
+        QJsonObject hello = parseResponse(QString::fromUtf8(m_responseBuffer.left(end + 1)));
+        const bool late = !m_helloPending;
+        m_helloTimer->stop();
+        m_helloPending = false;
+        m_helloUnanswered = false;
+
+        if (isHelloReply(hello)) {
+            QByteArray rest = m_responseBuffer.mid(end + 1);
+            m_responseBuffer.clear();
+            MetricsRegistry::finish(MetricsRegistry::TcpHello, std::exchange(m_helloStartUs, 0));
+
+            // 늦게 왔더라도 서버는 이후 응답을 압축하므로 그대로 따른다
+            if (hello.value("compress").toString() == QLatin1String(WireCompression::Name)) {
+                qCDebug(lcTcp) << "응답 압축 사용:" << WireCompression::Name
+                         << "기준:" << m_compressMinBytes << "bytes" << (late ? "(늦은 HELLO 응답)" : "");
+                // HELLO 응답 뒤에 붙어 온 바이트부터 프레임으로 해석
+                rest = m_wireReader.enableFraming(rest.constData(), rest.size());
+            }
+            m_responseBuffer = rest;
+            if (m_responseBuffer.isEmpty()) return;
+        } else {
+            qCDebug(lcTcp) << "서버가 HELLO 에 답하지 않음, 무압축으로 진행";
+            m_helloStartUs = 0;
+        }
+    }
     
     // JSON 응답이 완전한지 확인 (} 로 끝나는지 확인)
     if (m_responseBuffer.contains('}')) {
-        QJsonObject response = parseResponse(m_responseBuffer);
+        QJsonObject response = parseResponse(QString::fromUtf8(m_responseBuffer));
         
         if (!response.isEmpty()) {
             // 명령어에 따라 적절한 시그널 발생
             if (m_pendingCommand == "REGISTER") {
                 emit registerResponse(response);
             } else if (m_pendingCommand == "LOGIN") {
-                qDebug() << "[TCP] 로그인 응답 처리";
+                qCDebug(lcTcp) << "로그인 응답 처리";
                 emit loginResponse(response);
             } else if (m_pendingCommand == "RESET_PASSWORD") {
                 emit resetPasswordResponse(response);
@@ -229,6 +332,11 @@ void NetworkManager::onReadyRead()
             }
         }
         
+        const WireStats &st = m_wireReader.stats();
+        qCDebug(lcTcp) << "누적 수신:" << st.wireBytesIn << "bytes (압축 해제 후"
+                 << st.payloadBytesIn << "bytes), 압축 해제" << st.inflateNs / 1e6 << "ms";
+
+        MetricsRegistry::finish(m_commandTiming, std::exchange(m_commandStartUs, 0));
         m_responseBuffer.clear();
         m_pendingCommand.clear();
     }
@@ -257,7 +365,7 @@ void NetworkManager::onError(QAbstractSocket::SocketError error)
         break;
     }
     
-    qDebug() << "[TCP] 소켓 오류:" << errorString;
+    qCWarning(lcTcp) << "소켓 오류:" << errorString;
     emit networkError(errorString);
 }
 
@@ -272,8 +380,10 @@ void NetworkManager::onTimeout()
 void NetworkManager::sendCommand(const QString &command)
 {
     if (m_socket->state() == QAbstractSocket::ConnectedState) {
-        m_socket->write(command.toUtf8() + "\n");
+        m_wireReader.addBytesOut(m_socket->write(command.toUtf8() + "\n"));
         m_socket->flush();
+        m_commandTiming  = MetricsRegistry::tcpTiming(command);
+        m_commandStartUs = MetricsRegistry::start();
     }
 }
 
@@ -283,7 +393,7 @@ QJsonObject NetworkManager::parseResponse(const QString &response)
     QJsonDocument doc = QJsonDocument::fromJson(response.toUtf8(), &error);
     
     if (error.error != QJsonParseError::NoError) {
-        qDebug() << "[TCP] JSON 파싱 오류:" << error.errorString();
+        qCWarning(lcTcp) << "JSON 파싱 오류:" << error.errorString();
         return QJsonObject();
     }
     
@@ -392,20 +502,20 @@ void NetworkManager::getLog()
 bool NetworkManager::setupSSLConfiguration()
 {
     if (!QSslSocket::supportsSsl()) {
-        qDebug() << "[SSL] SSL이 지원되지 않아 설정을 건너뜁니다.";
+        qCDebug(lcConfig) << "SSL이 지원되지 않아 설정을 건너뜁니다.";
         return false;
     }
     
     // CA 인증서 로드
     QString caCertPath = findCertificateFile(m_caCertPath);
     if (caCertPath.isEmpty()) {
-        qDebug() << "[SSL] CA 인증서 파일을 찾을 수 없습니다:" << m_caCertPath;
+        qCWarning(lcConfig) << "CA 인증서 파일을 찾을 수 없습니다:" << m_caCertPath;
         return false;
     }
     
     QFile caCertFile(caCertPath);
     if (!caCertFile.open(QIODevice::ReadOnly)) {
-        qDebug() << "[SSL] CA 인증서 파일을 열 수 없습니다:" << caCertPath;
+        qCWarning(lcConfig) << "CA 인증서 파일을 열 수 없습니다:" << caCertPath;
         return false;
     }
     
@@ -413,20 +523,20 @@ bool NetworkManager::setupSSLConfiguration()
     caCertFile.close();
     
     if (caCert.isNull()) {
-        qDebug() << "[SSL] CA 인증서가 유효하지 않습니다";
+        qCWarning(lcConfig) << "CA 인증서가 유효하지 않습니다";
         return false;
     }
     
     // 클라이언트 인증서 로드
     QString clientCertPath = findCertificateFile(m_clientCertPath);
     if (clientCertPath.isEmpty()) {
-        qDebug() << "[SSL] 클라이언트 인증서 파일을 찾을 수 없습니다:" << m_clientCertPath;
+        qCWarning(lcConfig) << "클라이언트 인증서 파일을 찾을 수 없습니다:" << m_clientCertPath;
         return false;
     }
     
     QFile clientCertFile(clientCertPath);
     if (!clientCertFile.open(QIODevice::ReadOnly)) {
-        qDebug() << "[SSL] 클라이언트 인증서 파일을 열 수 없습니다:" << clientCertPath;
+        qCWarning(lcConfig) << "클라이언트 인증서 파일을 열 수 없습니다:" << clientCertPath;
         return false;
     }
     
@@ -434,20 +544,20 @@ bool NetworkManager::setupSSLConfiguration()
     clientCertFile.close();
     
     if (clientCert.isNull()) {
-        qDebug() << "[SSL] 클라이언트 인증서가 유효하지 않습니다";
+        qCWarning(lcConfig) << "클라이언트 인증서가 유효하지 않습니다";
         return false;
     }
     
     // 클라이언트 개인키 로드
     QString clientKeyPath = findCertificateFile(m_clientKeyPath);
     if (clientKeyPath.isEmpty()) {
-        qDebug() << "[SSL] 클라이언트 개인키 파일을 찾을 수 없습니다:" << m_clientKeyPath;
+        qCWarning(lcConfig) << "클라이언트 개인키 파일을 찾을 수 없습니다:" << m_clientKeyPath;
         return false;
     }
     
     QFile clientKeyFile(clientKeyPath);
     if (!clientKeyFile.open(QIODevice::ReadOnly)) {
-        qDebug() << "[SSL] 클라이언트 개인키 파일을 열 수 없습니다:" << clientKeyPath;
+        qCWarning(lcConfig) << "클라이언트 개인키 파일을 열 수 없습니다:" << clientKeyPath;
         return false;
     }
     
@@ -455,7 +565,7 @@ bool NetworkManager::setupSSLConfiguration()
     clientKeyFile.close();
     
     if (clientKey.isNull()) {
-        qDebug() << "[SSL] 클라이언트 개인키가 유효하지 않습니다";
+        qCWarning(lcConfig) << "클라이언트 개인키가 유효하지 않습니다";
         return false;
     }
     
@@ -469,16 +579,16 @@ bool NetworkManager::setupSSLConfiguration()
     // CA 인증서 설정
     m_sslConfig.setCaCertificates(QList<QSslCertificate>() << caCert);
     
-    qDebug() << "[SSL] SSL 설정 완료 - 엄격 검증 활성화";
+    qCDebug(lcConfig) << "SSL 설정 완료 - 엄격 검증 활성화";
     
     return true;
 }
 
 void NetworkManager::onSslErrors(const QList<QSslError> &errors)
 {
-    qDebug() << "[SSL] SSL 오류 발생:";
+    qCWarning(lcTcp) << "SSL 오류 발생:";
     for (const QSslError &error : errors) {
-        qDebug() << "[SSL]   -" << error.errorString();
+        qCWarning(lcTcp) << "  -" << error.errorString();
     }
     
     // 호스트명 불일치 오류만 무시하고 다른 SSL 오류는 거부
@@ -490,28 +600,31 @@ void NetworkManager::onSslErrors(const QList<QSslError> &errors)
             ignorableErrors.append(error);
         } else {
             hasOnlyHostnameError = false;
-            qDebug() << "[SSL] 심각한 SSL 오류:" << error.errorString();
+            qCWarning(lcTcp) << "심각한 SSL 오류:" << error.errorString();
         }
     }
     
     if (hasOnlyHostnameError && !ignorableErrors.isEmpty()) {
-        qDebug() << "[SSL] 호스트명 불일치 오류만 발생 - 연결 허용";
+        qCWarning(lcTcp) << "호스트명 불일치 오류만 발생 - 연결 허용";
         m_socket->ignoreSslErrors(ignorableErrors);
     } else {
-        qDebug() << "[SSL] 심각한 SSL 오류로 인해 연결 거부";
+        qCWarning(lcTcp) << "심각한 SSL 오류로 인해 연결 거부";
         emit networkError("SSL 인증 실패");
     }
 }
 
 void NetworkManager::onEncrypted()
 {
-    qDebug() << "[SSL] SSL 연결 암호화 완료";
+    qCDebug(lcTcp) << "SSL 연결 암호화 완료";
+    MetricsRegistry::finish(MetricsRegistry::TlsHandshake, std::exchange(m_handshakeStartUs, 0));
     
     // SSL 세션 정보 출력
     QSslCipher cipher = m_socket->sessionCipher();
     if (!cipher.isNull()) {
-        qDebug() << "[SSL] 암호화 방식:" << cipher.name();
+        qCDebug(lcTcp) << "암호화 방식:" << cipher.name();
     }
+
+    sendHello();
 }
 
 QString NetworkManager::findCertificateFile(const QString &filename)
@@ -530,19 +643,19 @@ QString NetworkManager::findCertificateFile(const QString &filename)
         QDir::currentPath() + "/" + filename  // 현재 작업 디렉토리
     };
     
-    qDebug() << "[SSL] 인증서 파일 검색:" << filename;
-    qDebug() << "[SSL] 현재 작업 디렉토리:" << QDir::currentPath();
+    qCDebug(lcConfig) << "인증서 파일 검색:" << filename;
+    qCDebug(lcConfig) << "현재 작업 디렉토리:" << QDir::currentPath();
     
     for (const QString &path : searchPaths) {
         QFile file(path);
-        qDebug() << "[SSL] 검색 경로:" << path << "존재:" << file.exists();
+        qCDebug(lcConfig) << "검색 경로:" << path << "존재:" << file.exists();
         if (file.exists()) {
-            qDebug() << "[SSL] 인증서 파일 발견:" << path;
+            qCDebug(lcConfig) << "인증서 파일 발견:" << path;
             return path;
         }
     }
     
-    qDebug() << "[SSL] 인증서 파일을 찾을 수 없습니다:" << filename;
+    qCWarning(lcConfig) << "인증서 파일을 찾을 수 없습니다:" << filename;
     return QString(); // 빈 문자열 반환
 }
 
@@ -558,19 +671,19 @@ QString NetworkManager::findConfigFile()
         QDir::currentPath() + "/config.ini"  // 현재 작업 디렉토리
     };
     
-    qDebug() << "[TCP] config.ini 파일 검색 중...";
-    qDebug() << "[TCP] 현재 작업 디렉토리:" << QDir::currentPath();
-    qDebug() << "[TCP] 실행 파일 디렉토리:" << QCoreApplication::applicationDirPath();
+    qCDebug(lcConfig) << "config.ini 파일 검색 중...";
+    qCDebug(lcConfig) << "현재 작업 디렉토리:" << QDir::currentPath();
+    qCDebug(lcConfig) << "실행 파일 디렉토리:" << QCoreApplication::applicationDirPath();
     
     for (const QString &path : searchPaths) {
         QFile file(path);
-        qDebug() << "[TCP] 검색 경로:" << path << "존재:" << file.exists();
+        qCDebug(lcConfig) << "검색 경로:" << path << "존재:" << file.exists();
         if (file.exists()) {
-            qDebug() << "[TCP] config.ini 파일 발견:" << path;
+            qCDebug(lcConfig) << "config.ini 파일 발견:" << path;
             return path;
         }
     }
     
-    qDebug() << "[TCP] config.ini 파일을 찾을 수 없습니다.";
+    qCWarning(lcConfig) << "config.ini 파일을 찾을 수 없습니다.";
     return QString(); // 빈 문자열 반환
 }
@@ -1,6 +1,10 @@
 #include "mainwindow/compareimageview.h"
 #include "mainwindow/filenameutils.h"
 #include "mainwindow/overlaywidget.h"
+#include "mainwindow/pdfreport.h"
+#include "mainwindow/imagedecoder.h"
+#include "mainwindow/imageinspector.h"
+#include "mainwindow/viewerutils.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFileInfo>
@@ -21,6 +25,7 @@
 #include <QMouseEvent>
 #include <QIcon>
 #include <QRegularExpression>
+#include <QtConcurrent>
 
 constexpr int IMAGE_WIDTH = 427;
 constexpr int IMAGE_HEIGHT = 240;
@@ -29,10 +34,8 @@ constexpr int TOTAL_WIDTH = IMAGE_WIDTH * 2 + 60; // 두 이미지 + 화살표 +
 CompareImageView::CompareImageView(const QString& event, const QString& plate,
                                    const QString& datetime, const QString& startFilename, 
                                    const QString& endFilename, QWidget* parent)
-    : QDialog(parent), startFilename_(startFilename), endFilename_(endFilename), dragging_(false), overlay_(nullptr)
+    : QDialog(parent), dragging_(false), diffCache_(32)
 {
-    // 이벤트 타입을 멤버 변수로 저장
-    eventType_ = event;
     setStyleSheet("background:#fff;");
     
     // 프레임리스 창으로 설정하고 커스텀 타이틀바 생성
@@ -111,6 +114,7 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     leftTableWidget->setShowGrid(false);
     leftTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
     leftTableWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    leftTableWidget->setFocusPolicy(Qt::NoFocus);
     leftTableWidget->setStyleSheet(
         "QTableWidget, QHeaderView::section { background: #fff; border: none; }"
         "QTableWidget::item { border-bottom: 1px solid #888; border-left: none; border-right: none; border-top: none; }"
@@ -118,14 +122,16 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
 
     auto* leftPlateItem = new QTableWidgetItem("번호판");
     leftPlateItem->setFont(labelBoldFont);
-    auto* leftPlateValItem = new QTableWidgetItem(plate);
+    leftPlateValItem_ = new QTableWidgetItem;
+    auto* leftPlateValItem = leftPlateValItem_;
     leftPlateValItem->setTextAlignment(Qt::AlignCenter);
     leftTableWidget->setItem(0, 0, leftPlateItem);
     leftTableWidget->setItem(0, 1, leftPlateValItem);
 
     auto* leftTimeItem = new QTableWidgetItem("일시");
     leftTimeItem->setFont(labelBoldFont);
-    auto* leftTimeValItem = new QTableWidgetItem(datetime);
+    leftTimeValItem_ = new QTableWidgetItem;
+    auto* leftTimeValItem = leftTimeValItem_;
     leftTimeValItem->setTextAlignment(Qt::AlignCenter);
     leftTableWidget->setItem(1, 0, leftTimeItem);
     leftTableWidget->setItem(1, 1, leftTimeValItem);
@@ -154,6 +160,7 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     rightTableWidget->setShowGrid(false);
     rightTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
     rightTableWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    rightTableWidget->setFocusPolicy(Qt::NoFocus);
     rightTableWidget->setStyleSheet(
         "QTableWidget, QHeaderView::section { background: #fff; border: none; }"
         "QTableWidget::item { border-bottom: 1px solid #888; border-left: none; border-right: none; border-top: none; }"
@@ -161,21 +168,16 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
 
     auto* rightPlateItem = new QTableWidgetItem("번호판");
     rightPlateItem->setFont(labelBoldFont);
-    auto* rightPlateValItem = new QTableWidgetItem(plate);
+    rightPlateValItem_ = new QTableWidgetItem;
+    auto* rightPlateValItem = rightPlateValItem_;
     rightPlateValItem->setTextAlignment(Qt::AlignCenter);
     rightTableWidget->setItem(0, 0, rightPlateItem);
     rightTableWidget->setItem(0, 1, rightPlateValItem);
 
     auto* rightTimeItem = new QTableWidgetItem("일시");
     rightTimeItem->setFont(labelBoldFont);
-    
-    // endFilename에서 시간 파싱
-    QString endDatetime = parseEndFilenameTimestamp(endFilename);
-    if (endDatetime.isEmpty()) {
-        endDatetime = datetime; // fallback to original datetime
-    }
-    
-    auto* rightTimeValItem = new QTableWidgetItem(endDatetime);
+    rightTimeValItem_ = new QTableWidgetItem;
+    auto* rightTimeValItem = rightTimeValItem_;
     rightTimeValItem->setTextAlignment(Qt::AlignCenter);
     rightTableWidget->setItem(1, 0, rightTimeItem);
     rightTableWidget->setItem(1, 1, rightTimeValItem);
@@ -196,6 +198,8 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     startImageLabel_->setAlignment(Qt::AlignCenter);
     startImageLabel_->setStyleSheet("background:#ccc; border:none; color:#888; font-size:18px;");
     startImageLabel_->setText("이미지");
+    startImageLabel_->setToolTip("더블클릭하면 원본 크기로 확대해 볼 수 있습니다");
+    startImageLabel_->installEventFilter(this);
     
     // 화살표
     QLabel* arrowLabel = new QLabel("→", this);
@@ -209,6 +213,8 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     endImageLabel_->setAlignment(Qt::AlignCenter);
     endImageLabel_->setStyleSheet("background:#ccc; border:none; color:#888; font-size:18px;");
     endImageLabel_->setText("이미지");
+    endImageLabel_->setToolTip("더블클릭하면 원본 크기로 확대해 볼 수 있습니다");
+    endImageLabel_->installEventFilter(this);
     
     imageLayout->addWidget(startImageLabel_);
     imageLayout->addWidget(arrowLabel);
@@ -226,15 +232,13 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     leftFileKey->setStyleSheet("border:none; background:transparent; font-size:12px; color:#222; font-weight:bold;");
     leftFileRow->addWidget(leftFileKey);
     
-    QString displayStartFilename = convertFilename(startFilename, event);
-    startFilenameLabel_ = new QLabel(
-        QString("<a href=\"#\" style=\"color:#1976D2;text-decoration:underline;font-weight:bold;\">%1</a>").arg(displayStartFilename), this);
+    startFilenameLabel_ = new QLabel(this);
     startFilenameLabel_->setTextInteractionFlags(Qt::TextBrowserInteraction);
     startFilenameLabel_->setOpenExternalLinks(false);
     startFilenameLabel_->setAlignment(Qt::AlignCenter);
     startFilenameLabel_->setStyleSheet("border:none; background:transparent; color:#1976D2; font-size:12px; font-weight:bold; text-align:center;");
-    connect(startFilenameLabel_, &QLabel::linkActivated, [=](const QString&) {
-        QDesktopServices::openUrl(QUrl::fromLocalFile(startFilename));
+    connect(startFilenameLabel_, &QLabel::linkActivated, this, [this](const QString&) {
+        QDesktopServices::openUrl(QUrl::fromLocalFile(startFilename_));
     });
     leftFileRow->addWidget(startFilenameLabel_, 1, Qt::AlignCenter);
     leftFileRow->addStretch();
@@ -254,15 +258,13 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     rightFileKey->setStyleSheet("border:none; background:transparent; font-size:12px; color:#222; font-weight:bold;");
     rightFileRow->addWidget(rightFileKey);
     
-    QString displayEndFilename = convertFilename(endFilename, event);
-    endFilenameLabel_ = new QLabel(
-        QString("<a href=\"#\" style=\"color:#1976D2;text-decoration:underline;font-weight:bold;\">%1</a>").arg(displayEndFilename), this);
+    endFilenameLabel_ = new QLabel(this);
     endFilenameLabel_->setTextInteractionFlags(Qt::TextBrowserInteraction);
     endFilenameLabel_->setOpenExternalLinks(false);
     endFilenameLabel_->setAlignment(Qt::AlignCenter);
     endFilenameLabel_->setStyleSheet("border:none; background:transparent; color:#1976D2; font-size:12px; font-weight:bold; text-align:center;");
-    connect(endFilenameLabel_, &QLabel::linkActivated, [=](const QString&) {
-        QDesktopServices::openUrl(QUrl::fromLocalFile(endFilename));
+    connect(endFilenameLabel_, &QLabel::linkActivated, this, [this](const QString&) {
+        QDesktopServices::openUrl(QUrl::fromLocalFile(endFilename_));
     });
     rightFileRow->addWidget(endFilenameLabel_, 1, Qt::AlignCenter);
     rightFileRow->addStretch();
@@ -300,12 +302,20 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     // --- 4. 인쇄/닫기 버튼 (중앙정렬) ---
     QHBoxLayout* btnLayout = new QHBoxLayout;
     btnLayout->addStretch();
+    diffButton_ = new QPushButton("차이 보기", this);
+    diffButton_->setCheckable(true);
+    diffButton_->setFixedSize(72, 24);
+    diffButton_->setStyleSheet("QPushButton { background:#E0E0E0; color:black; border:none; }"
+                               "QPushButton:checked { background:#1976D2; color:white; }");
+    diffButton_->setToolTip("정차 시작 이미지와 달라진 영역을 1분 경과 이미지 위에 표시");
     printButton_ = new QPushButton("인쇄", this);
     printButton_->setFixedSize(72, 24);
     printButton_->setStyleSheet("background:rgba(243, 115, 33, 0.8); color:black; border:none;");
     closeButton_ = new QPushButton("닫기", this);
     closeButton_->setFixedSize(72, 24);
     closeButton_->setStyleSheet("background:#FBB584; color:black; border:none;");
+    btnLayout->addWidget(diffButton_);
+    btnLayout->addSpacing(20);
     btnLayout->addWidget(printButton_);
     btnLayout->addSpacing(20);
     btnLayout->addWidget(closeButton_);
@@ -321,38 +331,172 @@ CompareImageView::CompareImageView(const QString& event, const QString& plate,
     connect(downloadButton1_, &QPushButton::clicked, this, &CompareImageView::downloadStartImage);
     connect(downloadButton2_, &QPushButton::clicked, this, &CompareImageView::downloadEndImage);
     connect(printButton_, &QPushButton::clicked, this, &CompareImageView::printToPdf);
+    connect(diffButton_, &QPushButton::toggled, this, &CompareImageView::toggleDiff);
+
+    addNavigationShortcuts(this, [this](int step) { emit navigateRequested(step); });
+
+    rebind(event, plate, datetime, startFilename, endFilename);
+}
+
+void CompareImageView::rebind(const QString& event, const QString& plate, const QString& datetime,
+                              const QString& startFilename, const QString& endFilename) {
+    eventType_     = event;
+    plate_         = plate;
+    datetime_      = datetime;
+    startFilename_ = startFilename;
+    endFilename_   = endFilename;
+
+    // 이전 레코드의 이미지와 진행 중인 디코딩 결과는 버린다
+    startImageData_.clear();
+    endImageData_.clear();
+    ++startDecodeSeq_;
+    ++endDecodeSeq_;
+    ++diffSeq_;                      // 진행 중인 비교 결과도 버림
+    diffButton_->setEnabled(true);
+    endPixmap_ = QPixmap();
+    startImageLabel_->setPixmap(QPixmap());
+    startImageLabel_->setText("이미지");
+    endImageLabel_->setPixmap(QPixmap());
+    endImageLabel_->setText("이미지");
+
+    // endFilename에서 시간 파싱
+    QString endDatetime = parseEndFilenameTimestamp(endFilename);
+    if (endDatetime.isEmpty()) {
+        endDatetime = datetime; // fallback to original datetime
+    }
+
+    leftPlateValItem_->setText(plate);
+    leftTimeValItem_->setText(datetime);
+    rightPlateValItem_->setText(plate);
+    rightTimeValItem_->setText(endDatetime);
+
+    const QString link("<a href=\"#\" style=\"color:#1976D2;text-decoration:underline;font-weight:bold;\">%1</a>");
+    startFilenameLabel_->setText(link.arg(convertFilename(startFilename, event)));
+    endFilenameLabel_->setText(link.arg(convertFilename(endFilename, event)));
 }
 
 void CompareImageView::setStartImageData(const QByteArray& data) {
     startImageData_ = data; // 이미지 데이터 저장
+    const int seq = ++startDecodeSeq_;
     if (data.isEmpty()) {
         startImageLabel_->setText("이미지 없음");
         return;
     }
-    QPixmap pix;
-    if (!pix.loadFromData(data, "JPEG") && !pix.loadFromData(data, "PNG")) {
-        startImageLabel_->setText("이미지 오류");
-        return;
-    }
-    QPixmap scaledPix = pix.scaled(IMAGE_WIDTH, IMAGE_HEIGHT, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    startImageLabel_->setPixmap(scaledPix);
-    startImageLabel_->setAlignment(Qt::AlignCenter);
+    updateDiff();
+    // 디코딩/축소는 작업 스레드에서, GUI 스레드는 QPixmap 변환만
+    ImageDecoder::decodeScaledAsync(data, QSize(IMAGE_WIDTH, IMAGE_HEIGHT))
+        .then(this, [this, seq](const QImage& image) {
+            if (seq != startDecodeSeq_) return;   // 그 사이 새 이미지가 들어옴
+            if (image.isNull()) {
+                startImageLabel_->setText("이미지 오류");
+                return;
+            }
+            startImageLabel_->setPixmap(QPixmap::fromImage(image));
+            startImageLabel_->setAlignment(Qt::AlignCenter);
+        });
+
+    // 확대 보기가 같은 쪽을 보고 있으면 함께 교체
+    if (inspector_ && inspector_->isVisible() && !inspectorShowsEnd_)
+        openInspector(false);
 }
 
 void CompareImageView::setEndImageData(const QByteArray& data) {
     endImageData_ = data; // 이미지 데이터 저장
+    const int seq = ++endDecodeSeq_;
+    endPixmap_ = QPixmap();
     if (data.isEmpty()) {
         endImageLabel_->setText("이미지 없음");
         return;
     }
-    QPixmap pix;
-    if (!pix.loadFromData(data, "JPEG") && !pix.loadFromData(data, "PNG")) {
-        endImageLabel_->setText("이미지 오류");
+    // 디코딩/축소는 작업 스레드에서, GUI 스레드는 QPixmap 변환만
+    ImageDecoder::decodeScaledAsync(data, QSize(IMAGE_WIDTH, IMAGE_HEIGHT))
+        .then(this, [this, seq](const QImage& image) {
+            if (seq != endDecodeSeq_) return;   // 그 사이 새 이미지가 들어옴
+            if (image.isNull()) {
+                endImageLabel_->setText("이미지 오류");
+                return;
+            }
+            endPixmap_ = QPixmap::fromImage(image);
+            refreshEndLabel();
+        });
+    updateDiff();
+
+    if (inspector_ && inspector_->isVisible() && inspectorShowsEnd_)
+        openInspector(true);
+}
+
+void CompareImageView::toggleDiff(bool on) {
+    if (on)
+        updateDiff();
+    refreshEndLabel();
+}
+
+void CompareImageView::updateDiff() {
+    if (!diffButton_->isChecked() || startImageData_.isEmpty() || endImageData_.isEmpty())
+        return;
+
+    const QString key = startFilename_ + '\n' + endFilename_;
+    if (diffCache_.contains(key)) {
+        refreshEndLabel();
+        return;
+    }
+
+    // 비교는 작업 스레드에서, 결과는 쌍별로 캐시해 다시 켤 때는 즉시 표시
+    const int seq = ++diffSeq_;
+    diffButton_->setEnabled(false);
+    ImageDiff::compareAsync(startImageData_, endImageData_, QSize(IMAGE_WIDTH, IMAGE_HEIGHT))
+        .then(this, [this, seq, key](const ImageDiff::Result& result) {
+            if (seq != diffSeq_) return;   // 그 사이 다른 레코드로 바뀜
+            diffButton_->setEnabled(true);
+            diffCache_.insert(key, new ImageDiff::Result(result));
+            refreshEndLabel();
+        });
+}
+
+void CompareImageView::refreshEndLabel() {
+    const QString key = startFilename_ + '\n' + endFilename_;
+    const ImageDiff::Result* diff = diffButton_->isChecked() ? diffCache_.object(key) : nullptr;
+
+    if (diff && diff->isValid()) {
+        endImageLabel_->setPixmap(QPixmap::fromImage(diff->image));
+        endImageLabel_->setToolTip(QString("변경 영역 %1곳 (픽셀 %2%)")
+                                       .arg(diff->regions.size())
+                                       .arg(diff->changedRatio * 100.0, 0, 'f', 1));
         return;
     }
-    QPixmap scaledPix = pix.scaled(IMAGE_WIDTH, IMAGE_HEIGHT, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    endImageLabel_->setPixmap(scaledPix);
-    endImageLabel_->setAlignment(Qt::AlignCenter);
+
+    endImageLabel_->setToolTip("더블클릭하면 원본 크기로 확대해 볼 수 있습니다");
+    if (!endPixmap_.isNull())
+        endImageLabel_->setPixmap(endPixmap_);
+    if (diff && !diff->isValid())
+        endImageLabel_->setToolTip("이미지를 비교할 수 없습니다");
+}
+
+bool CompareImageView::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() == QEvent::MouseButtonDblClick
+        && (watched == startImageLabel_ || watched == endImageLabel_)) {
+        openInspector(watched == endImageLabel_);
+        return true;
+    }
+    return QDialog::eventFilter(watched, event);
+}
+
+void CompareImageView::openInspector(bool end) {
+    const QByteArray& data = end ? endImageData_ : startImageData_;
+    if (data.isEmpty()) return;
+
+    if (!inspector_) {
+        inspector_ = new ImageInspector(this);
+        inspector_->setWindowFlags(Qt::Window);
+        inspector_->resize(1280, 800);
+    }
+    inspectorShowsEnd_ = end;
+    QLabel* nameLabel = end ? endFilenameLabel_ : startFilenameLabel_;
+    inspector_->setWindowTitle(nameLabel->text().remove(htmlTagRegex()));
+    inspector_->setImageData(data);
+    inspector_->show();
+    inspector_->raise();
+    inspector_->activateWindow();
 }
 
 void CompareImageView::downloadStartImage() {
@@ -364,7 +508,7 @@ void CompareImageView::downloadStartImage() {
     // 변환된 파일명을 기본 파일명으로 사용
     QString displayFilename = startFilenameLabel_->text();
     // HTML 태그 제거
-    displayFilename = displayFilename.remove(QRegularExpression("<[^>]*>"));
+    displayFilename = displayFilename.remove(htmlTagRegex());
     
     QString fileName = QFileDialog::getSaveFileName(this, 
         "정차 시작 이미지 저장", 
@@ -392,7 +536,7 @@ void CompareImageView::downloadEndImage() {
     // 변환된 파일명을 기본 파일명으로 사용
     QString displayFilename = endFilenameLabel_->text();
     // HTML 태그 제거
-    displayFilename = displayFilename.remove(QRegularExpression("<[^>]*>"));
+    displayFilename = displayFilename.remove(htmlTagRegex());
     
     QString fileName = QFileDialog::getSaveFileName(this, 
         "1분 경과 이미지 저장", 
@@ -416,30 +560,28 @@ void CompareImageView::printToPdf() {
         "PDF로 저장", 
         QString("불법주정차_report_%1.pdf").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")),
         "PDF Files (*.pdf)");
-    
-    if (!fileName.isEmpty()) {
-        QPdfWriter pdfWriter(fileName);
-        pdfWriter.setPageSize(QPageSize::A4);
-        pdfWriter.setPageMargins(QMarginsF(20, 20, 20, 20));
-        
-        QPainter painter(&pdfWriter);
-        
-        // 현재 창을 PDF로 렌더링
-        QPixmap windowPixmap = this->grab();
-        
-        // PDF 페이지 크기에 맞게 조정
-        QRect pageRect = pdfWriter.pageLayout().paintRectPixels(pdfWriter.resolution());
-        QPixmap scaledPixmap = windowPixmap.scaled(pageRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        
-        // 중앙에 배치
-        int x = (pageRect.width() - scaledPixmap.width()) / 2;
-        int y = (pageRect.height() - scaledPixmap.height()) / 2;
-        
-        painter.drawPixmap(x, y, scaledPixmap);
-        painter.end();
-        
-        QMessageBox::information(this, "완료", "불법 주정차 증명 자료 PDF가 저장되었습니다.");
-    }
+    if (fileName.isEmpty()) return;
+
+    // 화면 캡처 대신 원본 이미지로 보고서를 직접 그린다 (작업 스레드)
+    ReportItem item;
+    item.eventName  = eventType_;
+    item.time       = datetime_;
+    item.plate      = plate_;
+    item.speed      = "-";
+    item.startImage = startImageData_;
+    item.endImage   = endImageData_;
+
+    printButton_->setEnabled(false);
+    QtConcurrent::run([fileName, item]() {
+        PdfReportWriter writer(fileName, QStringLiteral("단속 이력 보고서"));
+        return writer.begin() && writer.addItem(item) && writer.finish();
+    }).then(this, [this](bool ok) {
+        printButton_->setEnabled(true);
+        if (ok)
+            QMessageBox::information(this, "완료", "불법 주정차 증명 자료 PDF가 저장되었습니다.");
+        else
+            QMessageBox::warning(this, "오류", "PDF를 저장할 수 없습니다.");
+    });
 }
 void CompareImageView::mousePressEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
@@ -459,14 +601,15 @@ void CompareImageView::mouseMoveEvent(QMouseEvent* event) {
 void CompareImageView::showEvent(QShowEvent* event) {
     QDialog::showEvent(event);
     
-    // 최상위 윈도우를 찾아서 오버레이 생성
+    // 최상위 윈도우를 찾아서 오버레이 표시 (오버레이는 한 번만 만들고 재사용)
     QWidget* topLevelWidget = this;
     while (topLevelWidget->parentWidget()) {
         topLevelWidget = topLevelWidget->parentWidget();
     }
     
     if (topLevelWidget && topLevelWidget != this) {
-        overlay_ = new OverlayWidget(topLevelWidget);
+        if (!overlay_)
+            overlay_ = new OverlayWidget(topLevelWidget);
         overlay_->resize(topLevelWidget->size());
         overlay_->show();
         
@@ -476,10 +619,12 @@ void CompareImageView::showEvent(QShowEvent* event) {
 }
 
 void CompareImageView::hideEvent(QHideEvent* event) {
-    // 오버레이 제거
+    // 오버레이 숨김 (다음 표시 때 재사용)
     if (overlay_) {
-        overlay_->deleteLater();
-        overlay_ = nullptr;
+        overlay_->hide();
+    }
+    if (inspector_) {
+        inspector_->hide();
     }
     
     QDialog::hideEvent(event);
@@ -487,20 +632,6 @@ void CompareImageView::hideEvent(QHideEvent* event) {
 
 QString CompareImageView::parseEndFilenameTimestamp(const QString& filename) {
     // endshot 파일명에서 시간 파싱 (YYYYMMDD_HHMMSS 형식)
-    QRegularExpression re(R"((\d{8})_(\d{6}))");
-    QRegularExpressionMatch match = re.match(filename);
-    if (!match.hasMatch()) return "";
-    
-    QString dateStr = match.captured(1); // YYYYMMDD
-    QString timeStr = match.captured(2); // HHMMSS
-    
-    if (dateStr.length() != 8 || timeStr.length() != 6) return "";
-    
-    return QString("%1-%2-%3 %4:%5:%6")
-        .arg(dateStr.mid(0, 4))  // year
-        .arg(dateStr.mid(4, 2))  // month
-        .arg(dateStr.mid(6, 2))  // day
-        .arg(timeStr.mid(0, 2))  // hour
-        .arg(timeStr.mid(2, 2))  // minute
-        .arg(timeStr.mid(4, 2)); // second
+    const FilenameTimestamp ts = findCompactTimestamp(filename);
+    return ts.valid ? ts.toDisplayString() : QString();
 }
@@ -0,0 +1,227 @@
+// diagnosticspage.cpp
+#include "mainwindow/diagnosticspage.h"
+#include "mainwindow/latencypanel.h"
+#include "mainwindow/mqttmanager.h"
+#include "mainwindow/stallwatchdog.h"
+#include <QHeaderView>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+
+namespace {
+
+QString formatRate(double perSecond)
+{
+    return QString("%1 /초").arg(perSecond, 0, 'f', perSecond < 10.0 ? 1 : 0);
+}
+
+QString formatBytes(quint64 bytes)
+{
+    if (bytes < 1024)
+        return QString("%1 B").arg(bytes);
+    if (bytes < 1024 * 1024)
+        return QString("%1 KB").arg(double(bytes) / 1024.0, 0, 'f', 1);
+    return QString("%1 MB").arg(double(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+} // namespace
+
+DiagnosticsPage::DiagnosticsPage(QWidget *parent)
+    : QWidget(parent)
+{
+    this->setStyleSheet("background-color: #FFFFFF;");
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(24, 16, 24, 16);
+    layout->setSpacing(8);
+
+    auto *title = new QLabel("성능 진단", this);
+    title->setStyleSheet("font-weight: bold; font-size: 18px;");
+    layout->addWidget(title);
+
+    auto *hint = new QLabel("이 페이지가 열려 있는 동안에만 수집합니다. F12 로 이전 페이지로 돌아갑니다.", this);
+    hint->setStyleSheet("color: #666; font-size: 12px;");
+    layout->addWidget(hint);
+
+    const QStringList fixedLabels = {
+        "RTSP 수신 프레임",
+        "RTSP 표시 전 교체된 프레임",
+        "RTSP 읽기 실패",
+        "이미지 캐시 적중률",
+        "MQTT 수신",
+        "MQTT 버림 (큐 가득 참)",
+        "MQTT 마지막 재연결",
+        "MQTT 재연결 후 복구된 알림 (누계)",
+        "TCP 명령 채널 수신 / 송신",
+        "TCP 응답 압축 (압축 → 해제 후)",
+        "메모리 (RSS)",
+        "CPU (전체 코어 대비)",
+    };
+
+    table_ = new QTableWidget(FixedRowCount + MetricsRegistry::TimingCount, 2, this);
+    table_->setHorizontalHeaderLabels({"항목", "값"});
+    table_->verticalHeader()->setVisible(false);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setSelectionMode(QAbstractItemView::NoSelection);
+    table_->setFocusPolicy(Qt::NoFocus);
+    table_->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    table_->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+
+    for (int row = 0; row < table_->rowCount(); ++row) {
+        const QString label = row < FixedRowCount
+            ? fixedLabels.at(row)
+            : MetricsRegistry::timingLabel(MetricsRegistry::Timing(row - FixedRowCount));
+        table_->setItem(row, 0, new QTableWidgetItem(label));
+        table_->setItem(row, 1, new QTableWidgetItem("-"));
+    }
+    for (int t = MetricsRegistry::TcpHello; t < MetricsRegistry::TimingCount; ++t)
+        table_->setRowHidden(FixedRowCount + t, true);
+    layout->addWidget(table_, 3);
+
+    // GUI 멈춤은 페이지와 관계없이 감지기가 계속 모은 값이다
+    auto *stallTitle = new QLabel("GUI 멈춤 (구간/이벤트별)", this);
+    stallTitle->setStyleSheet("font-weight: bold;");
+    layout->addWidget(stallTitle);
+
+    stallReport_ = new QPlainTextEdit(this);
+    stallReport_->setReadOnly(true);
+    stallReport_->setLineWrapMode(QPlainTextEdit::NoWrap);
+    stallReport_->setStyleSheet("font-family: Consolas, monospace; font-size: 11px;");
+    layout->addWidget(stallReport_, 2);
+
+    latencyPanel_ = new LatencyPanel(this);
+    layout->addWidget(latencyPanel_, 2);
+
+    refreshTimer_.setInterval(RefreshIntervalMs);
+    connect(&refreshTimer_, &QTimer::timeout, this, &DiagnosticsPage::refresh);
+
+    // 주기 타이머가 늦게 깨어난 만큼을 이벤트 루프 지연으로 본다
+    lagTimer_.setTimerType(Qt::PreciseTimer);
+    lagTimer_.setInterval(LagProbeIntervalMs);
+    connect(&lagTimer_, &QTimer::timeout, this, &DiagnosticsPage::probeEventLoop);
+}
+
+DiagnosticsPage::~DiagnosticsPage()
+{
+    MetricsRegistry::setEnabled(false);
+}
+
+void DiagnosticsPage::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    MetricsRegistry::setEnabled(true);
+    lastSnapshot_ = MetricsRegistry::snapshot();
+    lastUsage_    = MetricsRegistry::processUsage();
+    lastRefresh_.start();
+    lagClock_.start();
+
+    lastStallCount_ = ~quint64(0);
+    refreshStallReport();
+
+    refreshTimer_.start();
+    lagTimer_.start();
+}
+
+void DiagnosticsPage::hideEvent(QHideEvent *event)
+{
+    refreshTimer_.stop();
+    lagTimer_.stop();
+    MetricsRegistry::setEnabled(false);
+    QWidget::hideEvent(event);
+}
+
+void DiagnosticsPage::probeEventLoop()
+{
+    const qint64 elapsedUs = lagClock_.nsecsElapsed() / 1000;
+    lagClock_.restart();
+    MetricsRegistry::recordUs(MetricsRegistry::EventLoopLag,
+                              qMax<qint64>(0, elapsedUs - LagProbeIntervalMs * 1000));
+}
+
+void DiagnosticsPage::setValue(int row, const QString &text)
+{
+    table_->item(row, 1)->setText(text);
+}
+
+void DiagnosticsPage::refresh()
+{
+    const MetricsRegistry::Snapshot now = MetricsRegistry::snapshot();
+    const MetricsRegistry::ProcessUsage usage = MetricsRegistry::processUsage();
+    const qint64 wallUs = qMax<qint64>(1, lastRefresh_.nsecsElapsed() / 1000);
+    lastRefresh_.restart();
+
+    const auto rate = [&](MetricsRegistry::Counter c) {
+        return double(now.counters[c] - lastSnapshot_.counters[c]) * 1e6 / double(wallUs);
+    };
+
+    setValue(RtspFpsRow,          QString("%1 fps").arg(rate(MetricsRegistry::RtspFrames), 0, 'f', 1));
+    setValue(RtspDroppedRow,      formatRate(rate(MetricsRegistry::RtspDropped)));
+    setValue(RtspReadFailuresRow, formatRate(rate(MetricsRegistry::RtspReadFailures)));
+    setValue(MqttRateRow,         formatRate(rate(MetricsRegistry::MqttMessages)));
+    setValue(MqttDroppedRow,      QString("%1 건").arg(now.counters[MetricsRegistry::MqttDropped]));
+    // 재연결 통계는 페이지를 열기 전에 일어난 것도 보여야 하므로 MqttManager 가 따로 누적한다
+    if (mqttManager_) {
+        const qint64 reconnectMs = mqttManager_->lastReconnectLatencyMs();
+        setValue(MqttLastReconnectRow, reconnectMs < 0 ? QString("-")
+                 : QString("%1 ms (%2 회 시도)").arg(reconnectMs).arg(mqttManager_->lastReconnectAttempts()));
+        setValue(MqttRecoveredRow, QString("%1 건").arg(mqttManager_->recoveredTotal()));
+    }
+
+    // TCP 전송량: 페이지를 연 뒤 누계 (로그인/히스토리 채널 합계)
+    setValue(WireTrafficRow, QString("%1 / %2")
+             .arg(formatBytes(now.counters[MetricsRegistry::WireBytesIn]),
+                  formatBytes(now.counters[MetricsRegistry::WireBytesOut])));
+    const quint64 deflated = now.counters[MetricsRegistry::WireDeflatedBytes];
+    const quint64 inflated = now.counters[MetricsRegistry::WireInflatedBytes];
+    setValue(WireCompressionRow, inflated == 0 ? QString("-")
+             : QString("%1 → %2 (%3%)").arg(formatBytes(deflated), formatBytes(inflated))
+                   .arg(100.0 * double(deflated) / double(inflated), 0, 'f', 0));
+
+    const quint64 hits    = now.counters[MetricsRegistry::ImageCacheHits];
+    const quint64 lookups = hits + now.counters[MetricsRegistry::ImageCacheMisses];
+    setValue(ImageCacheRow, lookups == 0 ? QString("-")
+             : QString("%1% (%2 / %3)").arg(100.0 * double(hits) / double(lookups), 0, 'f', 1)
+                                        .arg(hits).arg(lookups));
+
+    if (usage.valid && lastUsage_.valid) {
+        const double cpu = double(usage.cpuUs - lastUsage_.cpuUs) * 100.0
+                         / double(wallUs) / double(qMax(1, QThread::idealThreadCount()));
+        setValue(CpuRow, QString("%1%").arg(qMax(0.0, cpu), 0, 'f', 1));
+    }
+    if (usage.rssBytes > 0)
+        setValue(MemoryRow, QString("%1 MB").arg(double(usage.rssBytes) / (1024.0 * 1024.0), 0, 'f', 1));
+
+    // 소요 시간: 페이지를 연 뒤 누계. 한 번도 쓰지 않은 TCP 명령 행은 숨긴다
+    for (int t = 0; t < MetricsRegistry::TimingCount; ++t) {
+        const MetricsRegistry::TimingValue &v = now.timings[t];
+        const int row = FixedRowCount + t;
+        const bool tcp = t >= MetricsRegistry::TcpHello;
+        table_->setRowHidden(row, tcp && v.count == 0);
+        setValue(row, v.count == 0 ? QString("-")
+                 : QString("평균 %1 ms · 최대 %2 ms (%3 건)")
+                       .arg(v.meanMs(), 0, 'f', 2).arg(v.maxMs(), 0, 'f', 2).arg(v.count));
+    }
+
+    lastSnapshot_ = now;
+    lastUsage_    = usage;
+
+    refreshStallReport();
+}
+
+void DiagnosticsPage::refreshStallReport()
+{
+    StallWatchdog *watchdog = StallWatchdog::instance();
+    if (!watchdog) {
+        stallReport_->setPlainText("감지기 꺼짐 (config.ini [watchdog] enabled)");
+        return;
+    }
+    // 새 멈춤이 있을 때만 다시 만든다 (스크롤 위치 유지)
+    const quint64 count = watchdog->stallCount();
+    if (count == lastStallCount_)
+        return;
+    lastStallCount_ = count;
+    stallReport_->setPlainText(watchdog->report());
+}
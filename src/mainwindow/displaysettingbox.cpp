@@ -1,10 +1,24 @@
 #include "mainwindow/displaysettingbox.h"
+#include "mainwindow/iconcache.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QEvent>
 #include <QPixmap>
 
+namespace {
+
+// 켜짐/꺼짐 두 상태를 모두 담은 라벨 스타일 (한 번만 만들고 active 속성으로 전환)
+const QString &toggleLabelStyle()
+{
+    static const QString style =
+        "QLabel { font-size: 14px; color: #aaa; border: none; background: transparent; }"
+        "QLabel[active=\"true\"] { color: #F37321; }";
+    return style;
+}
+
+} // namespace
+
 DisplaySettingBox::DisplaySettingBox(QWidget *parent)
     : QWidget(parent), objectBoxOn(false), timestampOn(false)
 {
@@ -31,7 +45,7 @@ void DisplaySettingBox::setupUI()
 
     objectLabel = new QLabel("객체 박스", objectBoxWidget);
     objectLabel->setAlignment(Qt::AlignCenter);
-    objectLabel->setStyleSheet("font-size: 14px; color: #aaa; border: none; background: transparent;");
+    objectLabel->setStyleSheet(toggleLabelStyle());
 
     objectLayout->addStretch();
     objectLayout->addWidget(objectIcon);
@@ -51,7 +65,7 @@ void DisplaySettingBox::setupUI()
 
     timestampLabel = new QLabel("타임 스탬프", timestampWidget);
     timestampLabel->setAlignment(Qt::AlignCenter);
-    timestampLabel->setStyleSheet("font-size: 14px; color: #aaa; border: none; background: transparent;");
+    timestampLabel->setStyleSheet(toggleLabelStyle());
 
     timestampLayout->addStretch();
     timestampLayout->addWidget(timestampIcon);
@@ -109,25 +123,16 @@ bool DisplaySettingBox::eventFilter(QObject *watched, QEvent *event)
 
 void DisplaySettingBox::updateObjectBoxUI()
 {
-    QString iconPath = objectBoxOn ? ":/images/objectbox_orange.png" : ":/images/objectbox_gray.png";
-    QPixmap originalPixmap(iconPath);
-    // 원본 크기의 80%로 조정
-    int scaledWidth = originalPixmap.width() * 0.7;
-    int scaledHeight = originalPixmap.height() * 0.7;
-    objectIcon->setPixmap(originalPixmap.scaled(scaledWidth, scaledHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    objectIcon->setStyleSheet("border: none; background: transparent;");
-    objectLabel->setStyleSheet(QString("font-size: 14px; color: %1; border: none; background: transparent;")
-                                   .arg(objectBoxOn ? "#F37321" : "#aaa"));
+    // 원본 크기의 70% (축소본은 IconCache 가 재사용)
+    objectIcon->setPixmap(IconCache::scaledBy(objectBoxOn ? ":/images/objectbox_orange.png"
+                                                          : ":/images/objectbox_gray.png", 0.7));
+    StyleState::set(objectLabel, "active", objectBoxOn);
 }
 
 void DisplaySettingBox::updateTimestampUI()
 {
-    QString iconPath = timestampOn ? ":/images/timestamp_orange.png" : ":/images/timestamp_gray.png";
-    QPixmap originalPixmap(iconPath);
-    // 원본 크기의 80%로 조정
-    int scaledWidth = originalPixmap.width() * 0.8;
-    int scaledHeight = originalPixmap.height() * 0.8;
-    timestampIcon->setPixmap(originalPixmap.scaled(scaledWidth, scaledHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    timestampLabel->setStyleSheet(QString("font-size: 14px; color: %1; border: none; background: transparent;")
-                                      .arg(timestampOn ? "#F37321" : "#aaa"));
+    // 원본 크기의 80%
+    timestampIcon->setPixmap(IconCache::scaledBy(timestampOn ? ":/images/timestamp_orange.png"
+                                                             : ":/images/timestamp_gray.png", 0.8));
+    StyleState::set(timestampLabel, "active", timestampOn);
 }
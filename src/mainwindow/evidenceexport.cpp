@@ -0,0 +1,255 @@
+// evidenceexport.cpp
+#include "mainwindow/evidenceexport.h"
+#include "mainwindow/historyexport.h"
+#include "mainwindow/imagefetchpool.h"
+#include "mainwindow/ziparchivewriter.h"
+#include <QFileInfo>
+#include <QStringList>
+#include <QDebug>
+
+namespace {
+
+constexpr int kConnections   = 3;    // 동시에 여는 TLS 연결 수
+constexpr int kPipelineDepth = 4;    // 연결당 미리 보내는 요청 수
+constexpr int kMaxBacklog    = 16;   // 쓰기 대기 이미지가 이만큼이면 요청 중지
+constexpr int kResumeBacklog = 4;    // 이 이하로 줄면 요청 재개
+
+bool hasImage(const QString &path)
+{
+    return !path.isEmpty() && path != "-";
+}
+
+// 같은 파일명이 여러 폴더에 있을 수 있어 ZIP 안의 이름은 겹치지 않게 만든다
+QString uniqueEntryName(const QString &path, QSet<QString> &used)
+{
+    const QFileInfo info(path);
+    QString base = info.completeBaseName();
+    if (base.isEmpty())
+        base = QStringLiteral("image");
+    const QString suffix = info.suffix().isEmpty() ? QString() : "." + info.suffix();
+
+    QString name = QString("images/%1%2").arg(base, suffix);
+    for (int n = 2; used.contains(name); ++n)
+        name = QString("images/%1_%2%3").arg(base).arg(n).arg(suffix);
+    used.insert(name);
+    return name;
+}
+
+QByteArray buildManifest(const QList<HistoryRecord> &records,
+                         const QHash<QString, QString> &entryNames,
+                         const QSet<QString> &failedPaths)
+{
+    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
+    static const QStringList headers = {
+        "날짜","유형","번호판","속도","이미지","정차 시작 이미지","1분 경과 이미지"
+    };
+
+    auto imageCell = [&](const QString &path) -> QString {
+        if (!hasImage(path))
+            return QString();
+        if (failedPaths.contains(path))
+            return QStringLiteral("수신 실패: %1").arg(path);
+        return entryNames.value(path);
+    };
+
+    QByteArray out("\xEF\xBB\xBF");
+    out.append(headers.join(',').toUtf8());
+    out.append("\r\n");
+    for (const HistoryRecord &rec : records) {
+        const int et = rec.eventType;
+        HistoryExporter::appendField(out, rec.displayTime);
+        out.append(',');
+        HistoryExporter::appendField(out, et >= 0 && et < typeNames.size() ? typeNames[et] : QString::number(et));
+        out.append(',');
+        HistoryExporter::appendField(out, rec.plateNumber);
+        out.append(',');
+        out.append(rec.hasSpeed ? QByteArray::number(rec.speed, 'f', 2) : QByteArray("-"));
+        out.append(',');
+        HistoryExporter::appendField(out, imageCell(rec.imagePath));
+        out.append(',');
+        HistoryExporter::appendField(out, imageCell(rec.startSnapshot));
+        out.append(',');
+        HistoryExporter::appendField(out, imageCell(rec.endSnapshot));
+        out.append("\r\n");
+    }
+    return out;
+}
+
+} // namespace
+
+EvidenceExporter::EvidenceExporter(QObject *parent)
+    : QObject(parent),
+      pool_(new ImageFetchPool(this)),
+      writerContext_(new QObject)
+{
+    pool_->setConcurrency(kConnections, kPipelineDepth);
+    connect(pool_, &ImageFetchPool::imageFetched, this, &EvidenceExporter::onImageFetched);
+    connect(pool_, &ImageFetchPool::imageFailed, this, &EvidenceExporter::onImageFailed);
+
+    writerThread_.setObjectName("EvidenceWriter");
+    writerContext_->moveToThread(&writerThread_);
+    connect(&writerThread_, &QThread::finished, writerContext_, &QObject::deleteLater);
+    writerThread_.start();
+}
+
+EvidenceExporter::~EvidenceExporter()
+{
+    if (running_)
+        stopWriter();
+    writerThread_.quit();
+    writerThread_.wait();
+    delete zip_;   // 쓰기 스레드가 끝났으므로 안전
+}
+
+void EvidenceExporter::start(const QString &zipPath, const QList<HistoryRecord> &records,
+                             const QString &host, quint16 port)
+{
+    if (running_)
+        return;
+
+    records_ = records;
+    entryNames_.clear();
+    failedPaths_.clear();
+    path_    = zipPath;
+    written_ = 0;
+    backlog_ = 0;
+
+    // 여러 레코드가 같은 이미지를 가리킬 수 있으므로 경로 단위로 한 번만 받는다
+    QStringList paths;
+    QSet<QString> usedNames;
+    for (const HistoryRecord &rec : records) {
+        for (const QString &p : {rec.imagePath, rec.startSnapshot, rec.endSnapshot}) {
+            if (!hasImage(p) || entryNames_.contains(p))
+                continue;
+            entryNames_.insert(p, uniqueEntryName(p, usedNames));
+            paths.append(p);
+        }
+    }
+    total_   = int(paths.size());
+    running_ = true;
+    const int job = ++job_;
+    elapsed_.start();
+
+    QMetaObject::invokeMethod(writerContext_, [this, job, zipPath]() {
+        zip_ = new ZipArchiveWriter(zipPath);
+        const bool ok = zip_->open();
+        const QString error = zip_->errorString();
+        if (!ok)
+            QMetaObject::invokeMethod(this, [this, job, error]() {
+                onEntryWritten(job, false, error);
+            }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+
+    emit progressChanged(0, total_, 0.0);
+    if (total_ == 0) {
+        finishArchive();
+        return;
+    }
+    pool_->setServer(host, port);
+    pool_->fetch(paths);
+}
+
+void EvidenceExporter::cancel()
+{
+    if (!running_)
+        return;
+    stopWriter();
+    emit canceled();
+}
+
+void EvidenceExporter::stopWriter()
+{
+    running_ = false;
+    pool_->cancel();
+    // 이미 넘긴 쓰기 작업이 끝난 뒤 임시 파일을 지운다 (대상 파일은 그대로)
+    QMetaObject::invokeMethod(writerContext_, [this]() {
+        if (zip_) {
+            zip_->abort();
+            delete zip_;
+            zip_ = nullptr;
+        }
+    }, Qt::QueuedConnection);
+}
+
+void EvidenceExporter::onImageFetched(const QString &path, const QByteArray &data)
+{
+    if (!running_)
+        return;
+
+    if (++backlog_ >= kMaxBacklog)
+        pool_->pause();
+
+    const int job = job_;
+    const QString name = entryNames_.value(path);
+    QMetaObject::invokeMethod(writerContext_, [this, job, name, data]() {
+        const bool ok = zip_ && zip_->addFile(name, data);
+        const QString error = zip_ ? zip_->errorString() : QString();
+        QMetaObject::invokeMethod(this, [this, job, ok, error]() {
+            onEntryWritten(job, ok, error);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void EvidenceExporter::onImageFailed(const QString &path, const QString &error)
+{
+    if (!running_)
+        return;
+    qWarning() << "[EvidenceExporter] 이미지 수신 실패:" << path << error;
+    failedPaths_.insert(path);
+    checkComplete();
+}
+
+void EvidenceExporter::onEntryWritten(int job, bool ok, const QString &error)
+{
+    if (job != job_ || !running_)
+        return;
+    if (!ok) {
+        stopWriter();
+        emit failed(error);
+        return;
+    }
+
+    --backlog_;
+    ++written_;
+    if (backlog_ <= kResumeBacklog)
+        pool_->resume();
+    checkComplete();
+}
+
+void EvidenceExporter::checkComplete()
+{
+    const double rate = written_ * 1000.0 / qMax<qint64>(1, elapsed_.elapsed());
+    const int done = written_ + int(failedPaths_.size());
+    emit progressChanged(done, total_, rate);
+    if (done == total_)
+        finishArchive();
+}
+
+void EvidenceExporter::finishArchive()
+{
+    const int job = job_;
+    QMetaObject::invokeMethod(writerContext_,
+        [this, job, records = records_, names = entryNames_, failedPaths = failedPaths_]() {
+            bool ok = zip_ && zip_->addFile("manifest.csv", buildManifest(records, names, failedPaths));
+            ok = ok && zip_->finish();
+            const QString error = zip_ ? zip_->errorString() : QString();
+            if (zip_ && !ok)
+                zip_->abort();
+            delete zip_;
+            zip_ = nullptr;
+
+            QMetaObject::invokeMethod(this, [this, job, ok, error]() {
+                if (job != job_ || !running_)
+                    return;
+                running_ = false;
+                if (!ok) {
+                    emit failed(error);
+                    return;
+                }
+                const double rate = written_ * 1000.0 / qMax<qint64>(1, elapsed_.elapsed());
+                qDebug() << "[EvidenceExporter] 완료:" << written_ << "장," << failedPaths_.size()
+                         << "장 실패," << rate << "장/초";
+                emit finished(path_, written_, int(failedPaths_.size()), rate);
+            }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+}
@@ -1,6 +1,101 @@
 #include "mainwindow/filenameutils.h"
-#include <QRegularExpression>
-#include <QDateTime>
+
+namespace {
+
+// 패턴의 'D' 는 ASCII 숫자, 그 외 문자는 그대로 일치해야 한다
+bool matchesAt(QStringView text, qsizetype at, const char *pattern, qsizetype length)
+{
+    if (at + length > text.size())
+        return false;
+    for (qsizetype i = 0; i < length; ++i) {
+        const QChar c = text[at + i];
+        if (pattern[i] == 'D') {
+            if (c < u'0' || c > u'9')
+                return false;
+        } else if (c != QLatin1Char(pattern[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 패턴이 처음 일치하는 위치, 없으면 -1
+template <qsizetype N>
+qsizetype findPattern(QStringView text, const char (&pattern)[N])
+{
+    constexpr qsizetype length = N - 1;
+    for (qsizetype at = 0; at + length <= text.size(); ++at) {
+        if (matchesAt(text, at, pattern, length))
+            return at;
+    }
+    return -1;
+}
+
+// 이미 숫자임이 확인된 구간을 정수로
+int digitsAt(QStringView text, qsizetype at, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; ++i)
+        value = value * 10 + (text[at + i].unicode() - u'0');
+    return value;
+}
+
+} // namespace
+
+QString FilenameTimestamp::toDisplayString() const
+{
+    return QString::asprintf("%04d-%02d-%02d %02d:%02d:%02d",
+                             year, month, day, hour, minute, second);
+}
+
+QString FilenameTimestamp::toCompactString() const
+{
+    return QString::asprintf("%04d%02d%02d_%02d%02d%02d",
+                             year, month, day, hour, minute, second);
+}
+
+FilenameTimestamp findCompactTimestamp(QStringView text)
+{
+    FilenameTimestamp ts;
+    const qsizetype at = findPattern(text, "DDDDDDDD_DDDDDD");
+    if (at < 0)
+        return ts;
+    ts.year   = digitsAt(text, at, 4);
+    ts.month  = digitsAt(text, at + 4, 2);
+    ts.day    = digitsAt(text, at + 6, 2);
+    ts.hour   = digitsAt(text, at + 9, 2);
+    ts.minute = digitsAt(text, at + 11, 2);
+    ts.second = digitsAt(text, at + 13, 2);
+    ts.valid  = true;
+    return ts;
+}
+
+FilenameTimestamp findDashedTimestamp(QStringView text)
+{
+    FilenameTimestamp ts;
+    const qsizetype at = findPattern(text, "DDDD-DD-DD_DD-DD-DD");
+    if (at < 0)
+        return ts;
+    ts.year   = digitsAt(text, at, 4);
+    ts.month  = digitsAt(text, at + 5, 2);
+    ts.day    = digitsAt(text, at + 8, 2);
+    ts.hour   = digitsAt(text, at + 11, 2);
+    ts.minute = digitsAt(text, at + 14, 2);
+    ts.second = digitsAt(text, at + 17, 2);
+    ts.valid  = true;
+    return ts;
+}
+
+FilenameTimestamp timestampFromFilename(QStringView text, bool preferDashed)
+{
+    if (preferDashed) {
+        FilenameTimestamp ts = findDashedTimestamp(text);
+        if (ts.valid)
+            return ts;
+        // 뒷쪽 시간이 없으면 앞쪽 시간으로 fallback
+    }
+    return findCompactTimestamp(text);
+}
 
 QString convertFilename(const QString& originalPath, const QString& eventType) {
     // "images/" 제거
@@ -9,33 +104,9 @@ QString convertFilename(const QString& originalPath, const QString& eventType) {
         filename = filename.mid(7); // "images/" 제거
     }
     
-    QString timeStr = "";
-    
-    // 과속감지일 경우 뒷쪽 타임스탬프 우선 시도 (YYYY-MM-DD_HH-MM-SS 형식)
-    if (eventType == "과속감지") {
-        QRegularExpression backTimestampRegex("(\\d{4})-(\\d{2})-(\\d{2})_(\\d{2})-(\\d{2})-(\\d{2})");
-        QRegularExpressionMatch backMatch = backTimestampRegex.match(filename);
-        if (backMatch.hasMatch()) {
-            QString year = backMatch.captured(1);
-            QString month = backMatch.captured(2);
-            QString day = backMatch.captured(3);
-            QString hour = backMatch.captured(4);
-            QString minute = backMatch.captured(5);
-            QString second = backMatch.captured(6);
-            timeStr = QString("%1%2%3_%4%5%6").arg(year, month, day, hour, minute, second);
-        }
-    }
-    
-    // 뒷쪽 시간이 없거나 과속감지가 아닌 경우 앞쪽 타임스탬프 사용 (YYYYMMDD_HHMMSS 형식)
-    if (timeStr.isEmpty()) {
-        QRegularExpression frontTimestampRegex("(\\d{8})_(\\d{6})");
-        QRegularExpressionMatch frontMatch = frontTimestampRegex.match(filename);
-        if (frontMatch.hasMatch()) {
-            QString dateStr = frontMatch.captured(1); // YYYYMMDD
-            QString timeOnlyStr = frontMatch.captured(2); // HHMMSS
-            timeStr = QString("%1_%2").arg(dateStr, timeOnlyStr);
-        }
-    }
+    // 과속감지일 경우 뒷쪽 타임스탬프(YYYY-MM-DD_HH-MM-SS) 우선, 없으면 앞쪽(YYYYMMDD_HHMMSS)
+    const FilenameTimestamp ts = timestampFromFilename(filename, eventType == "과속감지");
+    const QString timeStr = ts.valid ? ts.toCompactString() : QString();
     
     // person으로 시작하는 경우
     if (filename.startsWith("person_")) {
@@ -88,4 +159,18 @@ QString convertFilename(const QString& originalPath, const QString& eventType) {
     
     // 매칭되지 않는 경우 원본 반환
     return filename;
-}
\ No newline at end of file
+}
+
+QDate dateFromFilename(const QString& filename) {
+    // 뒷쪽 날짜 우선 시도 (YYYY-MM-DD 형식)
+    qsizetype at = findPattern(filename, "DDDD-DD-DD");
+    if (at >= 0)
+        return QDate(digitsAt(filename, at, 4), digitsAt(filename, at + 5, 2), digitsAt(filename, at + 8, 2));
+
+    // 앞쪽 날짜 시도 (YYYYMMDD 형식)
+    at = findPattern(filename, "DDDDDDDD");
+    if (at >= 0)
+        return QDate(digitsAt(filename, at, 4), digitsAt(filename, at + 4, 2), digitsAt(filename, at + 6, 2));
+
+    return QDate(); // 유효하지 않은 날짜 반환
+}
@@ -1,6 +1,10 @@
 #include "mainwindow/getimageview.h"
 #include "mainwindow/filenameutils.h"
 #include "mainwindow/overlaywidget.h"
+#include "mainwindow/pdfreport.h"
+#include "mainwindow/imagedecoder.h"
+#include "mainwindow/imageinspector.h"
+#include "mainwindow/viewerutils.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFileInfo>
@@ -21,12 +25,14 @@
 #include <QMouseEvent>
 #include <QIcon>
 #include <QRegularExpression>
+#include <QtConcurrent>
+
 constexpr int IMAGE_WIDTH = 427;
 constexpr int IMAGE_HEIGHT = 240;
 
 GetImageView::GetImageView(const QString& event, const QString& plate,
                            const QString& datetime, const QString& filename, QWidget* parent)
-    : QDialog(parent), dragging_(false), overlay_(nullptr)
+    : QDialog(parent), dragging_(false)
 {
     // 이벤트 타입을 멤버 변수로 저장
     eventType_ = event;
@@ -81,10 +87,8 @@ GetImageView::GetImageView(const QString& event, const QString& plate,
     
     containerLayout->addWidget(titleBar);
 
-    // --- 1. 정보 테이블 부분 ---
-    int rowCount = (plate != "-" && !plate.trimmed().isEmpty()) ? 3 : 2;
-    QTableWidget* table = new QTableWidget(rowCount, 2, this);
-    table->setFixedHeight(rowCount * 32);
+    // --- 1. 정보 테이블 부분 (내용은 rebind 에서 채움) ---
+    QTableWidget* table = new QTableWidget(2, 2, this);
     table->setFixedWidth(IMAGE_WIDTH);
     table->setColumnWidth(0, 45);  // 레이블 컬럼 너비를 70px로 설정하여 값들이 더 가운데 오도록 조정
     table->setColumnWidth(1, IMAGE_WIDTH - 75);
@@ -100,41 +104,7 @@ GetImageView::GetImageView(const QString& event, const QString& plate,
         "QTableWidget, QHeaderView::section { background: #fff; border: none; }"
         "QTableWidget::item { border-bottom: 1px solid #888; border-left: none; border-right: none; border-top: none; }"
         );
-
-    // 이벤트 유형
-    auto* typeItem = new QTableWidgetItem("유형");
-    QFont labelBoldFont = typeItem->font();
-    labelBoldFont.setBold(true);
-    typeItem->setFont(labelBoldFont);
-    typeItem->setFlags(typeItem->flags() & ~Qt::ItemIsSelectable);
-    auto* typeVal  = new QTableWidgetItem(event);
-    typeVal->setTextAlignment(Qt::AlignCenter);
-    typeVal->setFlags(typeVal->flags() & ~Qt::ItemIsSelectable);
-    table->setItem(0, 0, typeItem);
-    table->setItem(0, 1, typeVal);
-
-    int curRow = 1;
-    // 번호판(필요시)
-    if (plate != "-" && !plate.trimmed().isEmpty()) {
-        auto* plateItem = new QTableWidgetItem("번호판");
-        plateItem->setFont(labelBoldFont);
-        plateItem->setFlags(plateItem->flags() & ~Qt::ItemIsSelectable);
-        auto* plateVal  = new QTableWidgetItem(plate);
-        plateVal->setTextAlignment(Qt::AlignCenter);
-        plateVal->setFlags(plateVal->flags() & ~Qt::ItemIsSelectable);
-        table->setItem(curRow, 0, plateItem);
-        table->setItem(curRow, 1, plateVal);
-        ++curRow;
-    }
-    // 일시 (레이블만 bold)
-    auto* timeItem = new QTableWidgetItem("일시");
-    timeItem->setFont(labelBoldFont);
-    timeItem->setFlags(timeItem->flags() & ~Qt::ItemIsSelectable);
-    auto* timeVal  = new QTableWidgetItem(datetime);
-    timeVal->setTextAlignment(Qt::AlignCenter);
-    timeVal->setFlags(timeVal->flags() & ~Qt::ItemIsSelectable);
-    table->setItem(curRow, 0, timeItem);
-    table->setItem(curRow, 1, timeVal);
+    infoTable_ = table;
 
     containerLayout->addWidget(table);
 
@@ -144,6 +114,8 @@ GetImageView::GetImageView(const QString& event, const QString& plate,
     imageLabel_->setAlignment(Qt::AlignCenter);
     imageLabel_->setStyleSheet("background:#ccc; border:none; color:#888; font-size:18px;");
     imageLabel_->setText("이미지");
+    imageLabel_->setToolTip("더블클릭하면 원본 크기로 확대해 볼 수 있습니다");
+    imageLabel_->installEventFilter(this);
     containerLayout->addWidget(imageLabel_);
 
     // --- 3. 파일이름 행 ---
@@ -156,16 +128,14 @@ GetImageView::GetImageView(const QString& event, const QString& plate,
     fileKey->setStyleSheet("border:none; background:transparent; font-size:12px; color:#222; font-weight:bold;");
     fileRow->addWidget(fileKey);
 
-    // 파일명(하이퍼링크처럼) - 변환된 파일명 사용 (이벤트 타입 전달)
-    QString displayFilename = convertFilename(filename, event);
-    filenameLabel_ = new QLabel(
-        QString("<a href=\"#\" style=\"color:#1976D2;text-decoration:underline;font-weight:bold;\">%1</a>").arg(displayFilename), this);
+    // 파일명(하이퍼링크처럼) - 변환된 파일명은 rebind 에서 설정
+    filenameLabel_ = new QLabel(this);
     filenameLabel_->setTextInteractionFlags(Qt::TextBrowserInteraction);
     filenameLabel_->setOpenExternalLinks(false);
     filenameLabel_->setAlignment(Qt::AlignCenter);
     filenameLabel_->setStyleSheet("border:none; background:transparent; color:#1976D2; font-size:12px; font-weight:bold; text-align:center;");
-    connect(filenameLabel_, &QLabel::linkActivated, [=](const QString&) {
-        QDesktopServices::openUrl(QUrl::fromLocalFile(filename));
+    connect(filenameLabel_, &QLabel::linkActivated, this, [this](const QString&) {
+        QDesktopServices::openUrl(QUrl::fromLocalFile(filename_));
     });
     fileRow->addWidget(filenameLabel_, 1, Qt::AlignCenter);
 
@@ -204,23 +174,112 @@ GetImageView::GetImageView(const QString& event, const QString& plate,
     connect(closeButton_, &QPushButton::clicked, this, &QDialog::accept);
     connect(downloadButton_, &QPushButton::clicked, this, &GetImageView::downloadImage);
     connect(printButton_, &QPushButton::clicked, this, &GetImageView::printToPdf);
+
+    addNavigationShortcuts(this, [this](int step) { emit navigateRequested(step); });
+
+    rebind(event, plate, datetime, filename);
+}
+
+void GetImageView::rebind(const QString& event, const QString& plate,
+                          const QString& datetime, const QString& filename) {
+    eventType_ = event;
+    plate_     = plate;
+    datetime_  = datetime;
+    filename_  = filename;
+
+    // 이전 레코드의 이미지와 진행 중인 디코딩 결과는 버린다
+    imageData_.clear();
+    ++decodeSeq_;
+    imageLabel_->setPixmap(QPixmap());
+    imageLabel_->setText("이미지");
+
+    // 번호판(필요시) 행 포함 여부에 따라 행 수 조정
+    const bool hasPlate = (plate != "-" && !plate.trimmed().isEmpty());
+    const int rowCount = hasPlate ? 3 : 2;
+    infoTable_->setRowCount(rowCount);
+    infoTable_->setFixedHeight(rowCount * 32);
+    setInfoRow(0, "유형", event);
+    if (hasPlate)
+        setInfoRow(1, "번호판", plate);
+    setInfoRow(rowCount - 1, "일시", datetime);   // 레이블만 bold
+
+    // 변환된 파일명 사용 (이벤트 타입 전달)
+    filenameLabel_->setText(
+        QString("<a href=\"#\" style=\"color:#1976D2;text-decoration:underline;font-weight:bold;\">%1</a>")
+            .arg(convertFilename(filename, event)));
+}
+
+void GetImageView::setInfoRow(int row, const QString& key, const QString& value) {
+    // 항목은 한 번만 만들고 이후에는 글자만 바꾼다
+    QTableWidgetItem* keyItem = infoTable_->item(row, 0);
+    if (!keyItem) {
+        keyItem = new QTableWidgetItem;
+        QFont labelBoldFont = keyItem->font();
+        labelBoldFont.setBold(true);
+        keyItem->setFont(labelBoldFont);
+        keyItem->setFlags(keyItem->flags() & ~Qt::ItemIsSelectable);
+        infoTable_->setItem(row, 0, keyItem);
+    }
+    keyItem->setText(key);
+
+    QTableWidgetItem* valueItem = infoTable_->item(row, 1);
+    if (!valueItem) {
+        valueItem = new QTableWidgetItem;
+        valueItem->setTextAlignment(Qt::AlignCenter);
+        valueItem->setFlags(valueItem->flags() & ~Qt::ItemIsSelectable);
+        infoTable_->setItem(row, 1, valueItem);
+    }
+    valueItem->setText(value);
 }
 
 void GetImageView::setImageData(const QByteArray& data) {
     imageData_ = data; // 이미지 데이터 저장
+    const int seq = ++decodeSeq_;
     if (data.isEmpty()) {
         imageLabel_->setText("이미지 없음");
         return;
     }
-    QPixmap pix;
-    if (!pix.loadFromData(data, "JPEG") && !pix.loadFromData(data, "PNG")) {
-        imageLabel_->setText("이미지 오류");
-        return;
-    }
+    // 디코딩/축소는 작업 스레드에서, GUI 스레드는 QPixmap 변환만
     // 컨테이너 패딩을 고려한 크기로 원본 비율 유지하며 최대 크기로 맞춤
-    QPixmap scaledPix = pix.scaled(IMAGE_WIDTH - 20, IMAGE_HEIGHT, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    imageLabel_->setPixmap(scaledPix);
-    imageLabel_->setAlignment(Qt::AlignCenter);
+    ImageDecoder::decodeScaledAsync(data, QSize(IMAGE_WIDTH - 20, IMAGE_HEIGHT))
+        .then(this, [this, seq](const QImage& image) {
+            if (seq != decodeSeq_) return;   // 그 사이 새 이미지가 들어옴
+            if (image.isNull()) {
+                imageLabel_->setText("이미지 오류");
+                return;
+            }
+            imageLabel_->setPixmap(QPixmap::fromImage(image));
+            imageLabel_->setAlignment(Qt::AlignCenter);
+        });
+
+    // 확대 보기가 열려 있으면 다음 레코드 이미지로 함께 교체
+    if (inspector_ && inspector_->isVisible()) {
+        inspector_->setWindowTitle(filenameLabel_->text().remove(htmlTagRegex()));
+        inspector_->setImageData(data);
+    }
+}
+
+bool GetImageView::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == imageLabel_ && event->type() == QEvent::MouseButtonDblClick) {
+        openInspector();
+        return true;
+    }
+    return QDialog::eventFilter(watched, event);
+}
+
+void GetImageView::openInspector() {
+    if (imageData_.isEmpty()) return;
+
+    if (!inspector_) {
+        inspector_ = new ImageInspector(this);
+        inspector_->setWindowFlags(Qt::Window);
+        inspector_->resize(1280, 800);
+    }
+    inspector_->setWindowTitle(filenameLabel_->text().remove(htmlTagRegex()));
+    inspector_->setImageData(imageData_);
+    inspector_->show();
+    inspector_->raise();
+    inspector_->activateWindow();
 }
 
 void GetImageView::downloadImage() {
@@ -232,7 +291,7 @@ void GetImageView::downloadImage() {
     // 변환된 파일명을 기본 파일명으로 사용
     QString displayFilename = filenameLabel_->text();
     // HTML 태그 제거
-    displayFilename = displayFilename.remove(QRegularExpression("<[^>]*>"));
+    displayFilename = displayFilename.remove(htmlTagRegex());
     
     QString fileName = QFileDialog::getSaveFileName(this, 
         "이미지 저장", 
@@ -256,30 +315,27 @@ void GetImageView::printToPdf() {
         "PDF로 저장", 
         QString("불법주정차_report_%1.pdf").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")),
         "PDF Files (*.pdf)");
-    
-    if (!fileName.isEmpty()) {
-        QPdfWriter pdfWriter(fileName);
-        pdfWriter.setPageSize(QPageSize::A4);
-        pdfWriter.setPageMargins(QMarginsF(20, 20, 20, 20));
-        
-        QPainter painter(&pdfWriter);
-        
-        // 현재 창을 PDF로 렌더링
-        QPixmap windowPixmap = this->grab();
-        
-        // PDF 페이지 크기에 맞게 조정
-        QRect pageRect = pdfWriter.pageLayout().paintRectPixels(pdfWriter.resolution());
-        QPixmap scaledPixmap = windowPixmap.scaled(pageRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        
-        // 중앙에 배치
-        int x = (pageRect.width() - scaledPixmap.width()) / 2;
-        int y = (pageRect.height() - scaledPixmap.height()) / 2;
-        
-        painter.drawPixmap(x, y, scaledPixmap);
-        painter.end();
-        
-        QMessageBox::information(this, "완료", "PDF가 저장되었습니다.");
-    }
+    if (fileName.isEmpty()) return;
+
+    // 화면 캡처 대신 원본 이미지로 보고서를 직접 그린다 (작업 스레드)
+    ReportItem item;
+    item.eventName  = eventType_;
+    item.time       = datetime_;
+    item.plate      = plate_;
+    item.speed      = "-";
+    item.image      = imageData_;
+
+    printButton_->setEnabled(false);
+    QtConcurrent::run([fileName, item]() {
+        PdfReportWriter writer(fileName, QStringLiteral("단속 이력 보고서"));
+        return writer.begin() && writer.addItem(item) && writer.finish();
+    }).then(this, [this](bool ok) {
+        printButton_->setEnabled(true);
+        if (ok)
+            QMessageBox::information(this, "완료", "PDF가 저장되었습니다.");
+        else
+            QMessageBox::warning(this, "오류", "PDF를 저장할 수 없습니다.");
+    });
 }
 
 void GetImageView::mousePressEvent(QMouseEvent* event) {
@@ -300,14 +356,15 @@ void GetImageView::mouseMoveEvent(QMouseEvent* event) {
 void GetImageView::showEvent(QShowEvent* event) {
     QDialog::showEvent(event);
     
-    // 최상위 윈도우를 찾아서 오버레이 생성
+    // 최상위 윈도우를 찾아서 오버레이 표시 (오버레이는 한 번만 만들고 재사용)
     QWidget* topLevelWidget = this;
     while (topLevelWidget->parentWidget()) {
         topLevelWidget = topLevelWidget->parentWidget();
     }
     
     if (topLevelWidget && topLevelWidget != this) {
-        overlay_ = new OverlayWidget(topLevelWidget);
+        if (!overlay_)
+            overlay_ = new OverlayWidget(topLevelWidget);
         overlay_->resize(topLevelWidget->size());
         overlay_->show();
         
@@ -317,10 +374,12 @@ void GetImageView::showEvent(QShowEvent* event) {
 }
 
 void GetImageView::hideEvent(QHideEvent* event) {
-    // 오버레이 제거
+    // 오버레이 숨김 (다음 표시 때 재사용)
     if (overlay_) {
-        overlay_->deleteLater();
-        overlay_ = nullptr;
+        overlay_->hide();
+    }
+    if (inspector_) {
+        inspector_->hide();
     }
     
     QDialog::hideEvent(event);
@@ -0,0 +1,335 @@
+// historyexport.cpp
+#include "mainwindow/historyexport.h"
+#include "mainwindow/platesearchindex.h"
+#include "mainwindow/tcphistoryhandler.h"
+#include <QSaveFile>
+#include <QStringList>
+#include <QtConcurrent>
+#include <utility>
+
+namespace {
+
+// 이만큼 모이면 파일에 쓴다
+constexpr qsizetype kFlushBytes = 256 * 1024;
+// 취소 확인/진행률 보고 단위
+constexpr qsizetype kChunkRows  = 4096;
+
+const QStringList &headerColumns()
+{
+    static const QStringList headers = {
+        "날짜","유형","이미지","번호판","속도","정차 시작 이미지","1분 경과 이미지"
+    };
+    return headers;
+}
+
+QByteArray headerBytes()
+{
+    QByteArray out("\xEF\xBB\xBF");
+    out.append(headerColumns().join(',').toUtf8());
+    out.append("\r\n");
+    return out;
+}
+
+// 서버 페이지 하나를 이어 쓴다 (작업 스레드). 실패하면 오류 메시지
+QString appendRows(QSaveFile &file, const QList<HistoryRecord> &records)
+{
+    QByteArray buffer;
+    buffer.reserve(kFlushBytes + 4096);
+    for (const HistoryRecord &rec : records) {
+        HistoryExporter::appendRow(buffer, rec);
+        if (buffer.size() >= kFlushBytes) {
+            if (file.write(buffer) != buffer.size())
+                return file.errorString();
+            buffer.resize(0);
+        }
+    }
+    if (file.write(buffer) != buffer.size())
+        return file.errorString();
+    return QString();
+}
+
+} // namespace
+
+void HistoryExporter::appendField(QByteArray &out, const QString &field)
+{
+    const QByteArray utf8 = field.toUtf8();
+    bool quote = false;
+    for (char c : utf8) {
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            quote = true;
+            break;
+        }
+    }
+    if (!quote) {
+        out.append(utf8);
+        return;
+    }
+    out.append('"');
+    for (char c : utf8) {
+        if (c == '"')
+            out.append('"');
+        out.append(c);
+    }
+    out.append('"');
+}
+
+void HistoryExporter::appendRow(QByteArray &out, const HistoryRecord &rec)
+{
+    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
+    const int et = rec.eventType;
+
+    appendField(out, rec.date);
+    out.append(',');
+    appendField(out, et >= 0 && et < typeNames.size() ? typeNames[et] : QString::number(et));
+    out.append(',');
+    appendField(out, rec.imagePath);
+    out.append(',');
+    appendField(out, rec.plateNumber);
+    out.append(',');
+    if (rec.hasSpeed)
+        out.append(QByteArray::number(rec.speed, 'f', 2));
+    else
+        out.append('-');
+    out.append(',');
+    appendField(out, rec.startSnapshot);
+    out.append(',');
+    appendField(out, rec.endSnapshot);
+    out.append("\r\n");
+}
+
+QString HistoryExporter::write(const QString &path, const QList<HistoryRecord> &records,
+                               QPromise<QString> *promise)
+{
+    auto canceled = [promise]() { return promise && promise->isCanceled(); };
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return file.errorString();
+
+    QByteArray buffer;
+    buffer.reserve(kFlushBytes + 4096);
+    buffer.append(headerBytes());
+
+    if (promise)
+        promise->setProgressRange(0, int(records.size()));
+
+    for (qsizetype i = 0; i < records.size(); ++i) {
+        appendRow(buffer, records.at(i));
+
+        if (buffer.size() >= kFlushBytes) {
+            if (file.write(buffer) != buffer.size())
+                return file.errorString();
+            buffer.resize(0);   // 용량은 유지
+        }
+        if ((i + 1) % kChunkRows == 0) {
+            if (canceled()) {
+                file.cancelWriting();
+                return QString();
+            }
+            if (promise)
+                promise->setProgressValue(int(i + 1));
+        }
+    }
+
+    if (canceled()) {
+        file.cancelWriting();
+        return QString();
+    }
+    if (file.write(buffer) != buffer.size() || !file.commit())
+        return file.errorString();
+    if (promise)
+        promise->setProgressValue(int(records.size()));
+    return QString();
+}
+
+HistoryExporter::HistoryExporter(QObject *parent)
+    : QObject(parent)
+{
+    connect(&watcher_, &QFutureWatcherBase::progressValueChanged, this, [this](int value) {
+        emit progressChanged(value, total_);
+    });
+    connect(&watcher_, &QFutureWatcherBase::finished, this, [this]() {
+        if (watcher_.isCanceled() || watcher_.future().resultCount() == 0) {
+            emit canceled();
+            return;
+        }
+        const QString error = watcher_.result();
+        if (error.isEmpty())
+            emit finished(path_, total_);
+        else
+            emit failed(error);
+    });
+    connect(&pageWatcher_, &QFutureWatcherBase::finished, this, &HistoryExporter::onPageWritten);
+}
+
+HistoryExporter::~HistoryExporter()
+{
+    cancel();
+    watcher_.waitForFinished();
+    pageWatcher_.waitForFinished();   // file_ 은 쓰기가 끝난 뒤에 닫는다 (커밋 안 했으므로 버려짐)
+}
+
+void HistoryExporter::start(const QString &path, const QList<HistoryRecord> &records)
+{
+    cancel();
+    watcher_.waitForFinished();   // 같은 파일에 두 작업이 겹치지 않도록
+
+    path_  = path;
+    total_ = int(records.size());
+    watcher_.setFuture(QtConcurrent::run(
+        [](QPromise<QString> &promise, const QString &path, const QList<HistoryRecord> &records) {
+            QString error = HistoryExporter::write(path, records, &promise);
+            if (!promise.isCanceled())
+                promise.addResult(std::move(error));
+        },
+        path, records));
+}
+
+void HistoryExporter::startFromServer(const QString &path, const QString &host, quint16 port,
+                                      const QString &email, const HistoryQuery &filter,
+                                      const QString &plateText)
+{
+    if (isRunning())
+        return;
+
+    auto file = std::make_unique<QSaveFile>(path);
+    if (!file->open(QIODevice::WriteOnly)) {
+        emit failed(file->errorString());
+        return;
+    }
+    const QByteArray header = headerBytes();
+    if (file->write(header) != header.size()) {
+        emit failed(file->errorString());
+        return;
+    }
+
+    file_         = std::move(file);
+    path_         = path;
+    total_        = 0;
+    offset_       = 0;
+    lastPage_     = false;
+    pageCanceled_ = false;
+    pageError_.clear();
+    page_.clear();
+    filter_       = filter;
+    plateText_    = plateText;
+    email_        = email;
+    paging_       = true;
+
+    if (!source_) {
+        // 화면의 히스토리 연결과 응답이 섞이지 않도록 전용 연결을 쓴다
+        source_ = new TcpHistoryHandler(this);
+        connect(source_, &TcpHistoryHandler::connected, this, &HistoryExporter::requestNextPage);
+        connect(source_, &TcpHistoryHandler::historyRecordsReady, this, &HistoryExporter::onPageRecords);
+        connect(source_, &TcpHistoryHandler::historyFinished, this, &HistoryExporter::onPageFinished);
+        connect(source_, &TcpHistoryHandler::errorOccurred, this, &HistoryExporter::failPaging);
+        connect(source_, &TcpHistoryHandler::connectionFailed, this, [this]() {
+            failPaging(tr("서버에 연결할 수 없습니다"));
+        });
+    }
+    emit progressChanged(0, 0);
+    source_->connectToServer(host, port);
+}
+
+void HistoryExporter::requestNextPage()
+{
+    if (!paging_)
+        return;
+    if (filter_.eventType >= 0)
+        source_->getHistoryByEventType(email_, filter_.eventType, ServerPageRows, offset_);
+    else
+        source_->getHistory(email_, ServerPageRows, offset_);
+}
+
+void HistoryExporter::onPageRecords(const QList<HistoryRecord> &records)
+{
+    if (!paging_)
+        return;
+    // 날짜/번호판 조건은 서버 명령에 없으므로 받은 조각에서 바로 거른다
+    for (const HistoryRecord &rec : records) {
+        if (!filter_.matches(rec))
+            continue;
+        if (!plateText_.isEmpty() && !PlateSearchIndex::matches(rec.plateNumber, plateText_))
+            continue;
+        page_.append(rec);
+    }
+}
+
+void HistoryExporter::onPageFinished(const QJsonObject &header, int recordCount)
+{
+    if (!paging_)
+        return;
+    if (header.value("status").toString() == QLatin1String("error")) {
+        failPaging(header.value("message").toString());
+        return;
+    }
+
+    offset_  += recordCount;
+    lastPage_ = recordCount < ServerPageRows;
+    total_   += int(page_.size());
+
+    // 페이지의 행은 쓰기 작업으로 넘기고 여기서는 버린다
+    pageWatcher_.setFuture(QtConcurrent::run(
+        [file = file_.get()](const QList<HistoryRecord> &rows) { return appendRows(*file, rows); },
+        std::exchange(page_, {})));
+}
+
+void HistoryExporter::onPageWritten()
+{
+    if (!paging_)
+        return;
+    const QString error = pageWatcher_.result();
+    if (pageCanceled_ || !pageError_.isEmpty() || !error.isEmpty()) {
+        failPaging(pageError_.isEmpty() ? error : pageError_);
+        return;
+    }
+
+    emit progressChanged(total_, 0);
+    if (!lastPage_) {
+        requestNextPage();
+        return;
+    }
+    if (!file_->commit()) {
+        failPaging(file_->errorString());
+        return;
+    }
+    finishPaging();
+    emit finished(path_, total_);
+}
+
+void HistoryExporter::failPaging(const QString &error)
+{
+    if (!paging_)
+        return;
+    // 쓰는 중이면 파일을 닫지 않고 쓰기가 끝난 뒤(onPageWritten) 처리
+    if (pageWatcher_.isRunning()) {
+        if (pageError_.isEmpty())
+            pageError_ = error;
+        return;
+    }
+    const bool wasCanceled = pageCanceled_;
+    finishPaging();
+    if (wasCanceled)
+        emit canceled();
+    else
+        emit failed(error);
+}
+
+void HistoryExporter::finishPaging()
+{
+    paging_ = false;
+    source_->disconnectFromServer();
+    file_.reset();   // 커밋하지 않았으면 임시 파일을 지우고 기존 파일은 그대로 둔다
+    page_.clear();
+}
+
+void HistoryExporter::cancel()
+{
+    if (paging_) {
+        pageCanceled_ = true;
+        failPaging(QString());
+        return;
+    }
+    if (watcher_.isRunning())
+        watcher_.cancel();
+}
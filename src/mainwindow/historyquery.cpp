@@ -0,0 +1,134 @@
+// historyquery.cpp
+#include "mainwindow/historyquery.h"
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+// 병렬 필터링 단위. 이보다 적으면 한 스레드에서 처리
+constexpr qsizetype kChunkSize = 4096;
+
+} // namespace
+
+bool HistoryQuery::matches(const HistoryRecord &rec) const
+{
+    if (eventType >= 0 && rec.eventType != eventType)
+        return false;
+    if (filterByPlate && !plateIds.contains(rec.id))
+        return false;
+
+    // 파일명에서 날짜를 얻지 못한 레코드는 표시하지 않음 (기존 동작 유지)
+    const QDate &date = rec.fileDate;
+    if (!date.isValid())
+        return false;
+    if (startDate.isValid() && date < startDate)
+        return false;
+    if (endDate.isValid() && date > endDate)
+        return false;
+    return true;
+}
+
+QList<HistoryRecord> HistoryQuery::evaluate(const QList<HistoryRecord> &records,
+                                            const HistoryQuery &query,
+                                            QPromise<QList<HistoryRecord>> *promise)
+{
+    auto canceled = [promise]() { return promise && promise->isCanceled(); };
+
+    // 1) 청크 단위 병렬 필터 (청크 안에서는 원래 순서 유지)
+    QList<qsizetype> chunkStarts;
+    for (qsizetype i = 0; i < records.size(); i += kChunkSize)
+        chunkStarts.append(i);
+
+    auto filterChunk = [&](qsizetype begin) {
+        QList<qsizetype> hits;
+        if (canceled())
+            return hits;
+        const qsizetype end = qMin(begin + kChunkSize, records.size());
+        for (qsizetype i = begin; i < end; ++i) {
+            if (query.matches(records.at(i)))
+                hits.append(i);
+        }
+        return hits;
+    };
+
+    QList<QList<qsizetype>> parts;
+    if (chunkStarts.size() > 1) {
+        parts = QtConcurrent::blockingMapped<QList<QList<qsizetype>>>(chunkStarts, filterChunk);
+    } else if (!chunkStarts.isEmpty()) {
+        parts.append(filterChunk(0));
+    }
+    if (canceled())
+        return {};
+
+    QList<qsizetype> order;
+    for (const QList<qsizetype> &part : std::as_const(parts))
+        order.append(part);
+
+    // 2) 정렬. 날짜도 저장 순서에 기대지 않고 표시 시각으로 비교해 오름/내림차순이 서로 정확히 뒤집히게 한다
+    auto compareKey = [&](const HistoryRecord &x, const HistoryRecord &y) {
+        switch (query.sortKey) {
+        case SortByType:  return (x.eventType > y.eventType) - (x.eventType < y.eventType);
+        case SortBySpeed: {
+            const double sx = x.hasSpeed ? x.speed : -1.0;
+            const double sy = y.hasSpeed ? y.speed : -1.0;
+            return (sx > sy) - (sx < sy);
+        }
+        case SortByPlate: return x.plateNumber.compare(y.plateNumber);
+        case SortByDate:  break;
+        }
+        // 날짜 열에 보이는 값(파일명 시각, "yyyy-MM-dd hh:mm:ss")은 문자열 비교가 곧 시간순
+        return x.displayTime.compare(y.displayTime);
+    };
+    const bool ascending = query.order == Qt::AscendingOrder;
+    std::stable_sort(order.begin(), order.end(), [&](qsizetype a, qsizetype b) {
+        const int c = compareKey(records.at(a), records.at(b));
+        if (c != 0)
+            return ascending ? c < 0 : c > 0;
+        // 같은 값은 방향과 무관하게 저장 순서로 (다시 정렬해도 행이 뒤섞이지 않게)
+        return a < b;
+    });
+    if (canceled())
+        return {};
+
+    QList<HistoryRecord> results;
+    results.reserve(order.size());
+    for (qsizetype i : std::as_const(order))
+        results.append(records.at(i));
+    return results;
+}
+
+HistoryQueryEngine::HistoryQueryEngine(QObject *parent)
+    : QObject(parent)
+{
+    connect(&watcher_, &QFutureWatcherBase::finished, this, [this]() {
+        if (watcher_.isCanceled() || watcher_.future().resultCount() == 0)
+            return;
+        emit resultsReady(watcher_.result());
+    });
+}
+
+HistoryQueryEngine::~HistoryQueryEngine()
+{
+    cancel();
+    watcher_.waitForFinished();
+}
+
+void HistoryQueryEngine::run(const QList<HistoryRecord> &records, const HistoryQuery &query)
+{
+    cancel();
+    // 이전 future 는 watcher 에서 떨어지므로 늦게 끝나도 결과가 전달되지 않는다
+    watcher_.setFuture(QtConcurrent::run(
+        [](QPromise<QList<HistoryRecord>> &promise,
+           const QList<HistoryRecord> &records, const HistoryQuery &query) {
+            QList<HistoryRecord> results = HistoryQuery::evaluate(records, query, &promise);
+            if (!promise.isCanceled())
+                promise.addResult(std::move(results));
+        },
+        records, query));
+}
+
+void HistoryQueryEngine::cancel()
+{
+    if (watcher_.isRunning())
+        watcher_.cancel();
+}
@@ -0,0 +1,117 @@
+// historystore.cpp
+#include "mainwindow/historystore.h"
+#include "mainwindow/filenameutils.h"
+#include <QJsonValue>
+#include <QDateTime>
+#include <atomic>
+
+void HistoryRecord::precompute()
+{
+    // 과속감지(1)는 뒷쪽 타임스탬프 우선
+    const bool preferDashed = (eventType == 1);
+    fileDate = dateFromFilename(imagePath);
+
+    const FilenameTimestamp ts = timestampFromFilename(imagePath, preferDashed);
+    displayTime = ts.valid ? ts.toDisplayString() : date;
+
+    const FilenameTimestamp start = timestampFromFilename(startSnapshot, preferDashed);
+    startTime = start.valid ? start.toDisplayString() : QString();
+}
+
+HistoryRecord HistoryRecord::fromJson(const QJsonObject &obj)
+{
+    HistoryRecord rec;
+    rec.id            = obj.value("id").toInt();
+    rec.eventType     = obj.value("event_type").toInt();
+    rec.date          = obj.value("date").toString();
+    rec.imagePath     = obj.value("image_path").toString();
+    rec.plateNumber   = obj.value("plate_number").toString();
+    QJsonValue sp = obj.value("speed");
+    rec.hasSpeed      = sp.isDouble();
+    rec.speed         = sp.toDouble();
+    rec.startSnapshot = obj.value("start_snapshot").toString();
+    rec.endSnapshot   = obj.value("end_snapshot").toString();
+    rec.precompute();
+    return rec;
+}
+
+HistoryRecord HistoryRecord::fromMqttPayload(const QJsonObject &obj)
+{
+    // id 가 없는 알림은 임시 음수 id 를 부여 (다음 새로고침 때 서버 레코드로 대체됨).
+    // MQTT 네트워크 스레드에서 호출되므로 원자적으로 증가
+    static std::atomic<int> nextLocalId{-1};
+
+    HistoryRecord rec = fromJson(obj);
+    rec.eventType = obj.value("event").toInt(-1);
+    if (rec.id == 0)
+        rec.id = nextLocalId.fetch_sub(1, std::memory_order_relaxed);
+
+    // 알림은 timestamp(ISO 8601), 서버 형식을 따르는 발행기는 date 를 보낸다
+    QString timestamp = obj.value("timestamp").toString();
+    if (timestamp.isEmpty())
+        timestamp = rec.date;
+    QDateTime dt = QDateTime::fromString(timestamp, Qt::ISODate);
+    if (!dt.isValid())
+        dt = QDateTime::fromString(timestamp, "yyyy-MM-dd hh:mm:ss");
+    rec.date = dt.isValid() ? dt.toString("yyyy-MM-dd hh:mm:ss") : timestamp;
+
+    // 알림 payload 는 축약 키를 쓰는 경우가 있어 함께 확인
+    if (rec.imagePath.isEmpty())
+        rec.imagePath = obj.value("image").toString();
+    if (rec.plateNumber.isEmpty())
+        rec.plateNumber = obj.value("plate").toString();
+    rec.precompute();
+
+    // 경보 알림은 이미지 경로가 없을 수 있다. 파일명에 날짜가 없으면 payload 시각을 쓴다
+    // (fileDate 가 비어 있으면 기간 필터에서 빠져 표에 나타나지 않음)
+    if (!rec.fileDate.isValid() && dt.isValid()) {
+        rec.fileDate    = dt.date();
+        rec.displayTime = rec.date;
+    }
+    return rec;
+}
+
+void HistoryStore::reset(const QList<HistoryRecord> &records)
+{
+    clear();
+    records_.reserve(records.size());
+    for (const HistoryRecord &rec : records)
+        append(rec);
+}
+
+void HistoryStore::clear()
+{
+    records_.clear();
+    keyById_.clear();
+    frontKey_ = 0;
+    plateIndex_.clear();
+}
+
+bool HistoryStore::prepend(const HistoryRecord &record)
+{
+    if (keyById_.contains(record.id))
+        return false;
+    --frontKey_;
+    records_.prepend(record);
+    keyById_.insert(record.id, frontKey_);
+    plateIndex_.add(record.id, record.plateNumber);
+    return true;
+}
+
+bool HistoryStore::append(const HistoryRecord &record)
+{
+    if (keyById_.contains(record.id))
+        return false;
+    keyById_.insert(record.id, frontKey_ + records_.size());
+    records_.append(record);
+    plateIndex_.add(record.id, record.plateNumber);
+    return true;
+}
+
+const HistoryRecord *HistoryStore::find(int id) const
+{
+    auto it = keyById_.constFind(id);
+    if (it == keyById_.constEnd())
+        return nullptr;
+    return &records_.at(it.value() - frontKey_);
+}
@@ -0,0 +1,292 @@
+// historystreamparser.cpp
+#include "mainwindow/historystreamparser.h"
+#include <cstring>
+
+HistoryStreamParser::HistoryStreamParser()
+{
+    reset();
+}
+
+void HistoryStreamParser::reset()
+{
+    state_       = State::Value;
+    token_.resize(0);              // 용량은 유지해서 다음 응답에서 재사용
+    escape_      = false;
+    expectKey_   = false;
+    stack_.clear();
+    inData_      = false;
+    topKey_.clear();
+    fieldKey_.clear();
+    current_     = HistoryRecord();
+    pending_.clear();
+    header_      = QJsonObject();
+    recordCount_ = 0;
+    complete_    = false;
+    error_.clear();
+}
+
+QList<HistoryRecord> HistoryStreamParser::takeRecords()
+{
+    QList<HistoryRecord> out;
+    out.swap(pending_);
+    return out;
+}
+
+qsizetype HistoryStreamParser::feed(const char *data, qsizetype size)
+{
+    qsizetype i = 0;
+    while (i < size && !complete_ && error_.isEmpty()) {
+        const char c = data[i];
+
+        if (state_ == State::String) {
+            if (escape_) {
+                token_.append(c);
+                escape_ = false;
+                ++i;
+                continue;
+            }
+            // 따옴표/역슬래시가 나올 때까지 한 번에 복사
+            qsizetype j = i;
+            while (j < size && data[j] != '"' && data[j] != '\\')
+                ++j;
+            token_.append(data + i, j - i);
+            i = j;
+            if (i == size)
+                break;
+            if (data[i] == '\\') {
+                token_.append('\\');
+                escape_ = true;
+            } else {
+                state_ = State::Value;
+                finishString();
+            }
+            ++i;
+            continue;
+        }
+
+        if (state_ == State::Literal) {
+            if (c == ',' || c == '}' || c == ']' || c == ':' ||
+                c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                state_ = State::Value;
+                finishLiteral();
+                continue;          // 구분 문자는 Value 상태에서 다시 처리
+            }
+            token_.append(c);
+            ++i;
+            continue;
+        }
+
+        switch (c) {
+        case ' ': case '\t': case '\r': case '\n':
+            break;
+        case '"':
+            if (stack_.isEmpty()) {
+                error_ = QStringLiteral("응답이 JSON 객체가 아닙니다");
+                return i;
+            }
+            state_ = State::String;
+            token_.resize(0);
+            break;
+        case '{':
+        case '[':
+            openContainer(c);
+            break;
+        case '}':
+        case ']':
+            closeContainer(c);
+            break;
+        case ',':
+            expectKey_ = !stack_.isEmpty() && stack_.last() == '{';
+            break;
+        case ':':
+            expectKey_ = false;
+            break;
+        default:
+            if (stack_.isEmpty()) {
+                error_ = QStringLiteral("응답이 JSON 객체가 아닙니다");
+                return i;
+            }
+            state_ = State::Literal;
+            token_.resize(0);
+            token_.append(c);
+            break;
+        }
+        if (!error_.isEmpty())
+            return i;
+        ++i;
+    }
+    return i;
+}
+
+bool HistoryStreamParser::inRecord() const
+{
+    return inData_ && stack_.size() == 3 && stack_.at(2) == '{';
+}
+
+void HistoryStreamParser::openContainer(char c)
+{
+    const qsizetype depth = stack_.size();
+    if (depth == 0 && c != '{') {
+        error_ = QStringLiteral("응답이 JSON 객체가 아닙니다");
+        return;
+    }
+    if (expectKey_) {
+        error_ = QStringLiteral("객체 키 위치에 값이 있습니다");
+        return;
+    }
+    if (depth == 1 && c == '[' && topKey_ == QLatin1String("data"))
+        inData_ = true;
+    if (depth == 2 && inData_ && c == '{')
+        current_ = HistoryRecord();
+
+    stack_.append(c);
+    expectKey_ = (c == '{');
+}
+
+void HistoryStreamParser::closeContainer(char c)
+{
+    const char open = (c == '}') ? '{' : '[';
+    if (stack_.isEmpty() || stack_.last() != open) {
+        error_ = QStringLiteral("괄호 짝이 맞지 않습니다");
+        return;
+    }
+
+    if (c == '}' && inRecord()) {
+        current_.precompute();
+        pending_.append(current_);
+        ++recordCount_;
+    }
+
+    stack_.removeLast();
+    expectKey_ = false;
+
+    if (stack_.size() == 1 && c == ']' && inData_)
+        inData_ = false;
+    if (stack_.isEmpty())
+        complete_ = true;
+}
+
+void HistoryStreamParser::finishString()
+{
+    const QString value = unescape(token_);
+    token_.resize(0);
+
+    if (expectKey_) {
+        setKey(value);
+        expectKey_ = false;
+        return;
+    }
+    onScalar(QJsonValue(value));
+}
+
+void HistoryStreamParser::finishLiteral()
+{
+    QJsonValue value;
+    if (token_ == "true") {
+        value = true;
+    } else if (token_ == "false") {
+        value = false;
+    } else if (token_ == "null") {
+        value = QJsonValue(QJsonValue::Null);
+    } else {
+        bool ok = false;
+        const double d = token_.toDouble(&ok);
+        if (!ok) {
+            error_ = QStringLiteral("잘못된 값: %1").arg(QString::fromUtf8(token_.left(32)));
+            return;
+        }
+        value = d;
+    }
+    token_.resize(0);
+    onScalar(value);
+}
+
+void HistoryStreamParser::setKey(const QString &key)
+{
+    if (stack_.size() == 1)
+        topKey_ = key;
+    else if (inRecord())
+        fieldKey_ = key;
+}
+
+void HistoryStreamParser::onScalar(const QJsonValue &value)
+{
+    if (stack_.size() == 1)
+        header_.insert(topKey_, value);
+    else if (inRecord())
+        assignField(fieldKey_, value);
+    // 그 외 깊이(레코드 안의 중첩 값 등)는 사용하지 않으므로 버린다
+}
+
+void HistoryStreamParser::assignField(const QString &key, const QJsonValue &value)
+{
+    // HistoryRecord::fromJson 과 같은 키 매핑
+    if (key == QLatin1String("id")) {
+        current_.id = value.toInt();
+    } else if (key == QLatin1String("event_type")) {
+        current_.eventType = value.toInt();
+    } else if (key == QLatin1String("date")) {
+        current_.date = value.toString();
+    } else if (key == QLatin1String("image_path")) {
+        current_.imagePath = value.toString();
+    } else if (key == QLatin1String("plate_number")) {
+        current_.plateNumber = value.toString();
+    } else if (key == QLatin1String("speed")) {
+        current_.hasSpeed = value.isDouble();
+        current_.speed    = value.toDouble();
+    } else if (key == QLatin1String("start_snapshot")) {
+        current_.startSnapshot = value.toString();
+    } else if (key == QLatin1String("end_snapshot")) {
+        current_.endSnapshot = value.toString();
+    }
+}
+
+QString HistoryStreamParser::unescape(const QByteArray &raw)
+{
+    // 대부분의 값은 이스케이프가 없으므로 바로 변환
+    const char *p = raw.constData();
+    const qsizetype n = raw.size();
+    const char *bs = static_cast<const char *>(std::memchr(p, '\\', size_t(n)));
+    if (!bs)
+        return QString::fromUtf8(p, n);
+
+    QString out;
+    out.reserve(n);
+    qsizetype start = 0;
+    qsizetype i = bs - p;
+    while (i < n) {
+        if (p[i] != '\\') {
+            ++i;
+            continue;
+        }
+        out += QString::fromUtf8(p + start, i - start);
+        if (i + 1 >= n)
+            break;
+        const char e = p[i + 1];
+        i += 2;
+        switch (e) {
+        case 'n': out += QLatin1Char('\n'); break;
+        case 't': out += QLatin1Char('\t'); break;
+        case 'r': out += QLatin1Char('\r'); break;
+        case 'b': out += QLatin1Char('\b'); break;
+        case 'f': out += QLatin1Char('\f'); break;
+        case 'u': {
+            // \uXXXX: 서러게이트 쌍은 UTF-16 코드 유닛을 그대로 이어 붙이면 된다
+            bool ok = false;
+            const ushort unit = raw.mid(i, 4).toUShort(&ok, 16);
+            if (ok) {
+                out += QChar(unit);
+                i += 4;
+            }
+            break;
+        }
+        default:   // \" \\ \/
+            out += QLatin1Char(e);
+            break;
+        }
+        start = i;
+    }
+    if (start < n)
+        out += QString::fromUtf8(p + start, n - start);
+    return out;
+}
@@ -2,6 +2,11 @@
 #include "mainwindow/historyview.h"
 #include "mainwindow/tcphistoryhandler.h"
 #include "mainwindow/compareimageview.h"
+#include "mainwindow/filenameutils.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/stallwatchdog.h"
+#include "mainwindow/iconcache.h"
 
 #include <QResizeEvent>
 #include <QDate>
@@ -29,16 +34,35 @@
 #include <QPainter>
 #include <QSpinBox>
 #include <QLayout>
+#include <QLineEdit>
+#include <QProgressDialog>
 
 
 static constexpr int PAGE_SIZE = 16;
 
+namespace {
+QString eventTypeName(int eventType)
+{
+    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
+    return (eventType >= 0 && eventType < typeNames.size()) ? typeNames[eventType]
+                                                            : QString::number(eventType);
+}
+
+// 스타일시트는 같은 문자열이어도 설정할 때마다 위젯과 자식 전체를 다시 polish 한다
+void setStyleSheetIfChanged(QWidget *widget, const QString &styleSheet)
+{
+    if (widget->styleSheet() != styleSheet)
+        widget->setStyleSheet(styleSheet);
+}
+} // namespace
+
 HistoryView::HistoryView(QWidget *parent)
     : QWidget(parent),
     calendarForStart(false),
     currentPage(0),
     currentImageView_(nullptr),
-    currentCompareView_(nullptr)
+    currentCompareView_(nullptr),
+    imageCache_(64 * 1024)   // KB 단위, 약 64MB
 {
     this->setStyleSheet("background-color: #FFFFFF;");
     
@@ -160,7 +184,7 @@ HistoryView::HistoryView(QWidget *parent)
     auto addF=[&](auto txt){
         QAction* a=fm->addAction(txt);
         connect(a,&QAction::triggered,this,[this,txt](){
-            qDebug() << "필터 선택됨:" << txt;
+            qCDebug(lcHistory) << "필터 선택됨:" << txt;
             currentFilter=txt;
             // "전체보기" 선택 시 버튼 텍스트는 "유형"으로 표시
             if (txt == "전체보기") {
@@ -169,7 +193,7 @@ HistoryView::HistoryView(QWidget *parent)
                 filterButton->setText(txt);
             }
             currentPage=0;
-            qDebug() << "필터 적용 후 requestPage 호출, currentFilter:" << currentFilter;
+            qCDebug(lcHistory) << "필터 적용 후 requestPage 호출, currentFilter:" << currentFilter;
             requestPage();
         });
     };
@@ -179,7 +203,11 @@ HistoryView::HistoryView(QWidget *parent)
     downloadButton = new QPushButton(this);
     downloadButton->setIcon(QIcon(":/images/download.png"));
     downloadButton->setFlat(true);
-    connect(downloadButton,&QPushButton::clicked,this,&HistoryView::exportCsv);
+    QMenu* dm = new QMenu(this);
+    connect(dm->addAction("CSV로 저장"), &QAction::triggered, this, &HistoryView::exportCsv);
+    connect(dm->addAction("증거 패키지(ZIP)로 저장"), &QAction::triggered, this, &HistoryView::exportEvidence);
+    connect(dm->addAction("PDF 보고서로 저장"), &QAction::triggered, this, &HistoryView::exportReport);
+    downloadButton->setMenu(dm);
 
     refreshButton = new QPushButton(this);
     refreshButton->setIcon(QIcon(":/images/refresh.png"));
@@ -194,6 +222,11 @@ HistoryView::HistoryView(QWidget *parent)
         endDate.clear();
         startDateButton->setText("시작일 선택하기");
         endDateButton->setText("종료일 선택하기");
+
+        // 번호판 검색어 초기화 (조회는 아래 requestPage 응답으로 실행)
+        plateSearchEdit_->blockSignals(true);
+        plateSearchEdit_->clear();
+        plateSearchEdit_->blockSignals(false);
         
         // 체크된 항목들 모두 해제
         selectedRecordIds.clear();
@@ -350,9 +383,52 @@ HistoryView::HistoryView(QWidget *parent)
     // 달력 밖 클릭 시 숨기기 위한 이벤트 필터 설치
     this->installEventFilter(this);
 
+    // 필터/정렬 엔진 (작업 스레드에서 실행, 결과만 GUI 스레드로)
+    queryEngine_ = new HistoryQueryEngine(this);
+    connect(queryEngine_, &HistoryQueryEngine::resultsReady, this, &HistoryView::onFilterResults);
+
+    // CSV 내보내기 (작업 스레드에서 파일로 스트리밍)
+    exporter_ = new HistoryExporter(this);
+    connect(exporter_, &HistoryExporter::progressChanged, this, [this](int written, int total) {
+        if (!exportProgress_) return;
+        exportProgress_->setMaximum(total);
+        exportProgress_->setValue(written);
+        // 서버에서 페이지로 받을 때는 전체 수를 모르므로 쓴 행 수만 보인다
+        if (total == 0)
+            exportProgress_->setLabelText(tr("CSV로 저장 중... %1건").arg(written));
+    });
+    auto closeProgress = [this]() {
+        if (exportProgress_) {
+            exportProgress_->deleteLater();
+            exportProgress_ = nullptr;
+        }
+    };
+    connect(exporter_, &HistoryExporter::finished, this, closeProgress);
+    connect(exporter_, &HistoryExporter::canceled, this, closeProgress);
+    connect(exporter_, &HistoryExporter::failed, this, [this, closeProgress](const QString &error) {
+        closeProgress();
+        QMessageBox::warning(this, tr("CSV로 저장"), tr("내보내기에 실패했습니다: %1").arg(error));
+    });
+
+    tableWidget->horizontalHeader()->setSectionsClickable(true);
+    tableWidget->horizontalHeader()->setSortIndicatorShown(true);
+    tableWidget->horizontalHeader()->setSortIndicator(1, Qt::DescendingOrder);
+    connect(tableWidget->horizontalHeader(), &QHeaderView::sectionClicked,
+            this, &HistoryView::onSortSectionClicked);
+
+    // 번호판 검색 (입력할 때마다 진행 중인 조회를 취소하고 다시 조회)
+    plateSearchEdit_ = new QLineEdit(this);
+    plateSearchEdit_->setPlaceholderText("번호판 검색");
+    plateSearchEdit_->setClearButtonEnabled(true);
+    connect(plateSearchEdit_, &QLineEdit::textChanged, this, [this]() {
+        currentPage = 0;
+        applyFilters();
+    });
+
     tcpHandler_      = new TcpHistoryHandler(this);
     tcpImageHandler_ = new TcpImageHandler(this);
-    connect(tcpHandler_, &TcpHistoryHandler::historyDataReady, this, &HistoryView::onHistoryData);
+    connect(tcpHandler_, &TcpHistoryHandler::historyRecordsReady, this, &HistoryView::onHistoryRecords);
+    connect(tcpHandler_, &TcpHistoryHandler::historyFinished,     this, &HistoryView::onHistoryFinished);
     connect(tcpHandler_, &TcpHistoryHandler::errorOccurred,   this, &HistoryView::onHistoryError);
     connect(tcpImageHandler_, &TcpImageHandler::imageDataReady,
             this, &HistoryView::onImageDataReady);
@@ -373,11 +449,13 @@ HistoryView::HistoryView(QWidget *parent)
         QSettings settings(configPath, QSettings::IniFormat);
         QString tcpHost = settings.value("tcp/ip").toString();
         int tcpPort = settings.value("tcp/port").toInt();
+        tcpHandler_->setCompression(settings.value("tcp/compress_min_bytes",
+                                                   WireCompression::DefaultMinBytes).toInt());
         tcpHandler_->connectToServer(tcpHost, tcpPort);
         
         // 5초 후에도 데이터가 없으면 더미 데이터 로드
         QTimer::singleShot(5000, this, [this]() {
-            if (tableWidget->rowCount() == 0) loadDummyData();
+            if (historyStore_.isEmpty()) loadDummyData();
         });
     } else {
         loadDummyData(); // 설정 파일이 없으면 더미 데이터 로드
@@ -387,178 +465,99 @@ HistoryView::HistoryView(QWidget *parent)
     
     // 초기화 완료 후 더미 데이터 로드 (필요시)
     QTimer::singleShot(100, this, [this]() {
-        if (tableWidget->rowCount() == 0)
+        if (historyStore_.isEmpty())
             loadDummyData();
     });
 }
 
-QString HistoryView::parseTimestampFromPath(const QString& path, const QString& eventType) {
-    // 과속감지일 경우 뒷쪽 타임스탬프 우선 시도 (YYYY-MM-DD_HH-MM-SS 형식)
-    if (eventType == "과속감지") {
-        QRegularExpression backRe(R"((\d{4})-(\d{2})-(\d{2})_(\d{2})-(\d{2})-(\d{2}))");
-        QRegularExpressionMatch backMatch = backRe.match(path);
-        if (backMatch.hasMatch()) {
-            return QString("%1-%2-%3 %4:%5:%6")
-                .arg(backMatch.captured(1))  // year
-                .arg(backMatch.captured(2))  // month
-                .arg(backMatch.captured(3))  // day
-                .arg(backMatch.captured(4))  // hour
-                .arg(backMatch.captured(5))  // minute
-                .arg(backMatch.captured(6)); // second
-        }
-        // 뒷쪽 시간이 없으면 앞쪽 시간으로 fallback (과속감지도 앞쪽 시간 사용)
-    }
-    
-    // 앞쪽 타임스탬프 사용 (YYYYMMDD_HHMMSS 형식)
-    QRegularExpression re(R"((\d{8})_(\d{6}))");
-    QRegularExpressionMatch match = re.match(path);
-    if (!match.hasMatch()) return "";
-    
-    QString dateStr = match.captured(1); // YYYYMMDD
-    QString timeStr = match.captured(2); // HHMMSS
-    
-    if (dateStr.length() != 8 || timeStr.length() != 6) return "";
-    
-    return QString("%1-%2-%3 %4:%5:%6")
-        .arg(dateStr.mid(0, 4))  // year
-        .arg(dateStr.mid(4, 2))  // month
-        .arg(dateStr.mid(6, 2))  // day
-        .arg(timeStr.mid(0, 2))  // hour
-        .arg(timeStr.mid(2, 2))  // minute
-        .arg(timeStr.mid(4, 2)); // second
+const HistoryRecord *HistoryView::recordAtRow(int row) const {
+    // 1번 열 아이템에 레코드 id 가 저장되어 있음
+    QTableWidgetItem* idItem = tableWidget->item(row, 1);
+    if (!idItem || !idItem->data(Qt::UserRole).isValid())
+        return nullptr;
+    return historyStore_.find(idItem->data(Qt::UserRole).toInt());
 }
 
 void HistoryView::onImageCellClicked(int row, int col) {
     if (col != 5 && col != 8 && col != 9) return;
 
-    // 기존 창들 닫기 (한번에 하나만 뜨게 하기)
-    if (currentImageView_) {
-        currentImageView_->close();
-        currentImageView_->deleteLater();
-        currentImageView_ = nullptr;
-    }
-    if (currentCompareView_) {
-        currentCompareView_->close();
-        currentCompareView_->deleteLater();
-        currentCompareView_ = nullptr;
-    }
-
-    // 정차 시작 이미지(8번) 또는 1분 경과 이미지(9번) 클릭 시 비교 창 표시
-    if (col == 8 || col == 9) {
-        // 정차 시작 이미지 경로 가져오기
-        QString startPath = "";
-        QWidget* startCell = tableWidget->cellWidget(row, 8);
-        if (startCell && startCell->property("imagePath").isValid()) {
-            startPath = startCell->property("imagePath").toString();
-        }
-        if (startPath.isEmpty()) {
-            QTableWidgetItem* startItem = tableWidget->item(row, 8);
-            if (startItem && startItem->data(Qt::UserRole).isValid()) {
-                startPath = startItem->data(Qt::UserRole).toString();
-            }
-        }
-
-        // 1분 경과 이미지 경로 가져오기
-        QString endPath = "";
-        QWidget* endCell = tableWidget->cellWidget(row, 9);
-        if (endCell && endCell->property("imagePath").isValid()) {
-            endPath = endCell->property("imagePath").toString();
-        }
-        if (endPath.isEmpty()) {
-            QTableWidgetItem* endItem = tableWidget->item(row, 9);
-            if (endItem && endItem->data(Qt::UserRole).isValid()) {
-                endPath = endItem->data(Qt::UserRole).toString();
-            }
-        }
+    const HistoryRecord* rec = recordAtRow(row);
+    if (!rec) return;
 
-        // 두 이미지 경로가 모두 있는 경우에만 비교 창 표시
-        if (!startPath.isEmpty() && !endPath.isEmpty() && startPath != "-" && endPath != "-") {
-            // 유형 정보 가져오기 (3번 열에서)
-            QString eventType = "";
-            QWidget* typeCell = tableWidget->cellWidget(row, 3);
-            if (typeCell && typeCell->layout() && typeCell->layout()->itemAt(0)) {
-                QLabel* typeLabel = qobject_cast<QLabel*>(typeCell->layout()->itemAt(0)->widget());
-                if (typeLabel) {
-                    eventType = typeLabel->text();
-                }
-            }
-            
-            QString timestamp = parseTimestampFromPath(startPath, eventType);
-
-            // 번호판 정보 가져오기 (6번 열에서)
-            QString plate = "";
-            QWidget* plateCell = tableWidget->cellWidget(row, 6);
-            if (plateCell && plateCell->layout() && plateCell->layout()->itemAt(0)) {
-                QLabel* plateLabel = qobject_cast<QLabel*>(plateCell->layout()->itemAt(0)->widget());
-                if (plateLabel) {
-                    plate = plateLabel->text();
-                }
-            }
-
-            // 비교 창 생성 및 표시
-            currentCompareView_ = new CompareImageView(eventType, plate, timestamp, startPath, endPath, this);
-            currentCompareView_->show();
-
-            // 이미지 데이터 요청
-            pendingStartImagePath_ = startPath;
-            pendingEndImagePath_ = endPath;
-            startImageData_.clear();
-            endImageData_.clear();
-
-            QString configPath = findConfigFile();
-            if (!configPath.isEmpty()) {
-                QSettings settings(configPath, QSettings::IniFormat);
-                QString tcpHost = settings.value("tcp/ip").toString();
-                int tcpPort = settings.value("tcp/port").toInt();
-                if (tcpImageHandler_) {
-                    // 첫 번째 이미지 요청
-                    tcpImageHandler_->connectToServerThenRequestImage(tcpHost, tcpPort, startPath);
-                }
-            }
-            return;
-        }
+    // 정차 시작 이미지(8번) 또는 1분 경과 이미지(9번) 클릭 시, 두 이미지가 모두 있으면 비교 창 표시
+    if ((col == 8 || col == 9) && hasSnapshotPair(*rec)) {
+        openCompareViewer(*rec);
+        return;
     }
 
-    // 기존 단일 이미지 보기 로직 (5번 열 클릭 시)
-    QString path;
-    QTableWidgetItem* item = tableWidget->item(row, col);
-    if (item && item->data(Qt::UserRole).isValid()) {
-        path = item->data(Qt::UserRole).toString();
-    }
-    if (path.isEmpty()) {
-        QWidget* cell = tableWidget->cellWidget(row, col);
-        if (cell && cell->property("imagePath").isValid()) {
-            path = cell->property("imagePath").toString();
-        }
-    }
+    // 단일 이미지 보기 (5번 열, 또는 스냅샷이 하나뿐인 경우)
+    QString path = (col == 5) ? rec->imagePath
+                 : (col == 8) ? rec->startSnapshot
+                              : rec->endSnapshot;
     if (path.isEmpty()) path = "-";
+    openImageViewer(*rec, path);
+}
 
-    // 유형 정보 가져오기 (3번 열에서)
-    QString eventType = "";
-    QWidget* typeCell = tableWidget->cellWidget(row, 3);
-    if (typeCell && typeCell->layout() && typeCell->layout()->itemAt(0)) {
-        QLabel* typeLabel = qobject_cast<QLabel*>(typeCell->layout()->itemAt(0)->widget());
-        if (typeLabel) {
-            eventType = typeLabel->text();
-        }
-    }
-
-    QString timestamp = parseTimestampFromPath(path, eventType);
+bool HistoryView::hasSnapshotPair(const HistoryRecord &rec) {
+    return !rec.startSnapshot.isEmpty() && !rec.endSnapshot.isEmpty()
+        && rec.startSnapshot != "-" && rec.endSnapshot != "-";
+}
 
-    // 번호판 정보 가져오기 (6번 열에서)
-    QString plate = "";
-    QWidget* plateCell = tableWidget->cellWidget(row, 6);
-    if (plateCell && plateCell->layout() && plateCell->layout()->itemAt(0)) {
-        QLabel* plateLabel = qobject_cast<QLabel*>(plateCell->layout()->itemAt(0)->widget());
-        if (plateLabel) {
-            plate = plateLabel->text();
-        }
+void HistoryView::openImageViewer(const HistoryRecord &rec, const QString &path) {
+    // 창은 한 번만 만들고 이후에는 내용만 교체 (한번에 하나만 뜨게 하기)
+    if (!currentImageView_) {
+        currentImageView_ = new GetImageView(QString(), QString(), QString(), QString(), this);
+        connect(currentImageView_, &GetImageView::navigateRequested, this, &HistoryView::navigateViewer);
     }
+    if (currentCompareView_)
+        currentCompareView_->hide();
 
-    QString filename = path;
+    viewerRecordId_   = rec.id;
+    pendingImagePath_ = path;
 
-    currentImageView_ = new GetImageView(eventType, plate, timestamp, filename, this);
+    // 시각은 수집 시 미리 계산된 값을 사용
+    const QString &timestamp = (path == rec.startSnapshot) ? rec.startTime : rec.displayTime;
+    currentImageView_->rebind(eventTypeName(rec.eventType), rec.plateNumber, timestamp, path);
     currentImageView_->show();
+    currentImageView_->raise();
+    currentImageView_->activateWindow();
+
+    requestViewerImage(path);
+}
+
+void HistoryView::openCompareViewer(const HistoryRecord &rec) {
+    if (!currentCompareView_) {
+        currentCompareView_ = new CompareImageView(QString(), QString(), QString(), QString(), QString(), this);
+        connect(currentCompareView_, &CompareImageView::navigateRequested, this, &HistoryView::navigateViewer);
+    }
+    if (currentImageView_)
+        currentImageView_->hide();
+
+    viewerRecordId_ = rec.id;
+    pendingStartImagePath_ = rec.startSnapshot;
+    pendingEndImagePath_   = rec.endSnapshot;
+    startImageData_.clear();
+    endImageData_.clear();
+
+    currentCompareView_->rebind(eventTypeName(rec.eventType), rec.plateNumber, rec.startTime,
+                                rec.startSnapshot, rec.endSnapshot);
+    currentCompareView_->show();
+    currentCompareView_->raise();
+    currentCompareView_->activateWindow();
+
+    // 첫 번째 이미지 요청 (두 번째는 첫 번째 수신 후)
+    requestViewerImage(pendingStartImagePath_);
+}
+
+void HistoryView::requestViewerImage(const QString &path) {
+    // 최근에 본 이미지는 서버에 다시 묻지 않는다 (앞뒤 이동 시 즉시 표시)
+    if (const QByteArray *cached = imageCache_.object(path)) {
+        MetricsRegistry::add(MetricsRegistry::ImageCacheHits);
+        const QByteArray data = *cached;
+        onImageDataReady(path, data);
+        return;
+    }
+    MetricsRegistry::add(MetricsRegistry::ImageCacheMisses);
 
     QString configPath = findConfigFile();
     if (configPath.isEmpty()) return;
@@ -570,14 +569,51 @@ void HistoryView::onImageCellClicked(int row, int col) {
     }
 }
 
+void HistoryView::navigateViewer(int step) {
+    qsizetype index = -1;
+    for (qsizetype i = 0; i < filteredRecords_.size(); ++i) {
+        if (filteredRecords_.at(i).id == viewerRecordId_) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) return;
+
+    // 지금 열린 창과 같은 종류의 이미지가 있는 다음 레코드로 이동
+    const bool compare = currentCompareView_ && currentCompareView_->isVisible();
+    for (qsizetype i = index + step; i >= 0 && i < filteredRecords_.size(); i += step) {
+        const HistoryRecord &rec = filteredRecords_.at(i);
+        // 표는 이미지가 없는 칸을 "-" 로 채운다
+        const bool hasImage = !rec.imagePath.isEmpty() && rec.imagePath != "-";
+        if (compare ? !hasSnapshotPair(rec) : !hasImage)
+            continue;
+
+        // 표의 페이지도 함께 따라간다
+        const int page = int(i / PAGE_SIZE);
+        if (page != currentPage) {
+            currentPage = page;
+            refreshTable();
+        }
+
+        if (compare)
+            openCompareViewer(rec);
+        else
+            openImageViewer(rec, rec.imagePath);
+        return;
+    }
+}
+
 void HistoryView::onImageDataReady(const QString& path, const QByteArray& data) {
-    // 단일 이미지 뷰어에 데이터 설정
-    if (currentImageView_) {
+    if (!data.isEmpty() && !imageCache_.contains(path))
+        imageCache_.insert(path, new QByteArray(data), qMax<qsizetype>(1, data.size() / 1024));
+
+    // 단일 이미지 뷰어에 데이터 설정 (이미 다른 레코드로 넘어갔으면 무시)
+    if (currentImageView_ && currentImageView_->isVisible() && path == pendingImagePath_) {
         currentImageView_->setImageData(data);
     }
     
     // 비교 뷰어에 데이터 설정
-    if (currentCompareView_) {
+    if (currentCompareView_ && currentCompareView_->isVisible()) {
         if (path == pendingStartImagePath_) {
             startImageData_ = data;
             currentCompareView_->setStartImageData(data);
@@ -585,16 +621,10 @@ void HistoryView::onImageDataReady(const QString& path, const QByteArray& data)
             // 첫 번째 이미지를 받았으면 두 번째 이미지 요청
             if (!pendingEndImagePath_.isEmpty() && endImageData_.isEmpty()) {
                 // 잠시 대기 후 두 번째 이미지 요청 (연결이 완전히 끝나도록)
-                QTimer::singleShot(1, this, [this]() {
-                    QString configPath = findConfigFile();
-                    if (!configPath.isEmpty()) {
-                        QSettings settings(configPath, QSettings::IniFormat);
-                        QString tcpHost = settings.value("tcp/ip").toString();
-                        int tcpPort = settings.value("tcp/port").toInt();
-                        if (tcpImageHandler_) {
-                            tcpImageHandler_->connectToServerThenRequestImage(tcpHost, tcpPort, pendingEndImagePath_);
-                        }
-                    }
+                const QString endPath = pendingEndImagePath_;
+                QTimer::singleShot(1, this, [this, endPath]() {
+                    if (endPath == pendingEndImagePath_)
+                        requestViewerImage(endPath);
                 });
             }
         } else if (path == pendingEndImagePath_) {
@@ -604,33 +634,155 @@ void HistoryView::onImageDataReady(const QString& path, const QByteArray& data)
     }
 }
 
+QList<HistoryRecord> HistoryView::exportRecords() const {
+    // 체크된 행이 있으면 그 행만, 없으면 필터 결과 전체 (화면에 없는 페이지 포함)
+    if (selectedRecordIds.isEmpty())
+        return filteredRecords_;   // 암시적 공유, 복사 없음
+
+    QList<HistoryRecord> records;
+    records.reserve(selectedRecordIds.size());
+    for (const HistoryRecord &rec : std::as_const(filteredRecords_)) {
+        if (selectedRecordIds.contains(rec.id))
+            records.append(rec);
+    }
+    return records;
+}
+
 void HistoryView::exportCsv() {
+    if (exporter_->isRunning()) return;
+
     QString path = QFileDialog::getSaveFileName(this, tr("CSV로 저장"), QString(), tr("CSV Files (*.csv)"));
     if (path.isEmpty()) return;
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly|QIODevice::Truncate)) return;
-    file.write("\xEF\xBB\xBF");
-    QStringList headers = {
-        "날짜","유형","이미지","번호판","속도","정차 시작 이미지","1분 경과 이미지"
-    };
-    file.write(headers.join(',').toUtf8() + "\r\n");
-    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
-    for (int id : selectedRecordIds) {
-        auto obj = recordDataMap.value(id);
-        if (obj.isEmpty()) continue;
-        QStringList cols;
-        cols << obj.value("date").toString();
-        int et = obj.value("event_type").toInt();
-        cols << (et>=0&&et<typeNames.size()?typeNames[et]:QString::number(et));
-        cols << obj.value("image_path").toString();
-        cols << obj.value("plate_number").toString();
-        QJsonValue sp = obj.value("speed");
-        cols << (sp.isDouble()?QString::number(sp.toDouble(),'f',2):QString("-"));
-        cols << obj.value("start_snapshot").toString();
-        cols << obj.value("end_snapshot").toString();
-        file.write(cols.join(',').toUtf8() + "\r\n");
-    }
-    file.close();
+
+    // 체크한 행이 없고 서버에 연결되어 있으면 아직 받지 않은 레코드까지 서버에서 페이지로 받아 쓴다
+    const bool online = selectedRecordIds.isEmpty() && tcpHandler_ && tcpHandler_->isConnected();
+    const QString configPath = online ? findConfigFile() : QString();
+    const bool fromServer = !configPath.isEmpty();
+    const QList<HistoryRecord> records = fromServer ? QList<HistoryRecord>() : exportRecords();
+
+    exportProgress_ = new QProgressDialog(tr("CSV로 저장 중..."), tr("취소"), 0, int(records.size()), this);
+    exportProgress_->setWindowModality(Qt::WindowModal);
+    exportProgress_->setMinimumDuration(300);
+    exportProgress_->setAutoClose(false);
+    exportProgress_->setAutoReset(false);
+    connect(exportProgress_, &QProgressDialog::canceled, exporter_, &HistoryExporter::cancel);
+
+    if (fromServer) {
+        QSettings settings(configPath, QSettings::IniFormat);
+        // 번호판은 색인 결과(id) 대신 검색어로 다시 거른다
+        HistoryQuery filter = filterQuery_;
+        filter.filterByPlate = false;
+        filter.plateIds.clear();
+        exporter_->startFromServer(path, settings.value("tcp/ip").toString(),
+                                   quint16(settings.value("tcp/port").toInt()),
+                                   currentEmail, filter, filterPlateText_);
+        return;
+    }
+    exporter_->start(path, records);
+}
+
+void HistoryView::exportEvidence() {
+    if (evidenceExporter_ && evidenceExporter_->isRunning()) return;
+
+    QString configPath = findConfigFile();
+    if (configPath.isEmpty()) {
+        QMessageBox::warning(this, tr("증거 패키지"), tr("설정 파일을 찾을 수 없습니다."));
+        return;
+    }
+    QString path = QFileDialog::getSaveFileName(this, tr("증거 패키지로 저장"), QString(), tr("ZIP Files (*.zip)"));
+    if (path.isEmpty()) return;
+
+    if (!evidenceExporter_) {
+        // 이미지 연결 풀과 쓰기 스레드는 처음 사용할 때 만든다
+        evidenceExporter_ = new EvidenceExporter(this);
+        connect(evidenceExporter_, &EvidenceExporter::progressChanged, this,
+                [this](int done, int total, double imagesPerSecond) {
+            if (!evidenceProgress_) return;
+            evidenceProgress_->setMaximum(total);
+            evidenceProgress_->setValue(done);
+            evidenceProgress_->setLabelText(tr("이미지 수신 중... %1/%2 (%3장/초)")
+                                                .arg(done).arg(total).arg(imagesPerSecond, 0, 'f', 1));
+        });
+        auto closeProgress = [this]() {
+            if (evidenceProgress_) {
+                evidenceProgress_->deleteLater();
+                evidenceProgress_ = nullptr;
+            }
+        };
+        connect(evidenceExporter_, &EvidenceExporter::canceled, this, closeProgress);
+        connect(evidenceExporter_, &EvidenceExporter::finished, this,
+                [this, closeProgress](const QString &, int images, int failedImages, double imagesPerSecond) {
+            closeProgress();
+            if (failedImages > 0) {
+                QMessageBox::warning(this, tr("증거 패키지"),
+                                     tr("이미지 %1장을 저장했습니다 (%2장 수신 실패, %3장/초).")
+                                         .arg(images).arg(failedImages).arg(imagesPerSecond, 0, 'f', 1));
+            }
+        });
+        connect(evidenceExporter_, &EvidenceExporter::failed, this, [this, closeProgress](const QString &error) {
+            closeProgress();
+            QMessageBox::warning(this, tr("증거 패키지"), tr("내보내기에 실패했습니다: %1").arg(error));
+        });
+    }
+
+    evidenceProgress_ = new QProgressDialog(tr("이미지 수신 중..."), tr("취소"), 0, 0, this);
+    evidenceProgress_->setWindowModality(Qt::WindowModal);
+    evidenceProgress_->setMinimumDuration(300);
+    evidenceProgress_->setAutoClose(false);
+    evidenceProgress_->setAutoReset(false);
+    connect(evidenceProgress_, &QProgressDialog::canceled, evidenceExporter_, &EvidenceExporter::cancel);
+
+    QSettings settings(configPath, QSettings::IniFormat);
+    QString tcpHost = settings.value("tcp/ip").toString();
+    int tcpPort = settings.value("tcp/port").toInt();
+    evidenceExporter_->start(path, exportRecords(), tcpHost, quint16(tcpPort));
+}
+
+void HistoryView::exportReport() {
+    if (reportExporter_ && reportExporter_->isRunning()) return;
+
+    QString configPath = findConfigFile();
+    if (configPath.isEmpty()) {
+        QMessageBox::warning(this, tr("PDF 보고서"), tr("설정 파일을 찾을 수 없습니다."));
+        return;
+    }
+    QString path = QFileDialog::getSaveFileName(this, tr("PDF 보고서로 저장"),
+        QString("단속이력_report_%1.pdf").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")),
+        tr("PDF Files (*.pdf)"));
+    if (path.isEmpty()) return;
+
+    if (!reportExporter_) {
+        reportExporter_ = new PdfReportExporter(this);
+        connect(reportExporter_, &PdfReportExporter::progressChanged, this, [this](int done, int total) {
+            if (!reportProgress_) return;
+            reportProgress_->setMaximum(total);
+            reportProgress_->setValue(done);
+        });
+        auto closeProgress = [this]() {
+            if (reportProgress_) {
+                reportProgress_->deleteLater();
+                reportProgress_ = nullptr;
+            }
+        };
+        connect(reportExporter_, &PdfReportExporter::canceled, this, closeProgress);
+        connect(reportExporter_, &PdfReportExporter::finished, this, closeProgress);
+        connect(reportExporter_, &PdfReportExporter::failed, this, [this, closeProgress](const QString &error) {
+            closeProgress();
+            QMessageBox::warning(this, tr("PDF 보고서"), tr("보고서 작성에 실패했습니다: %1").arg(error));
+        });
+    }
+
+    reportProgress_ = new QProgressDialog(tr("PDF 보고서 작성 중..."), tr("취소"), 0, 0, this);
+    reportProgress_->setWindowModality(Qt::WindowModal);
+    reportProgress_->setMinimumDuration(300);
+    reportProgress_->setAutoClose(false);
+    reportProgress_->setAutoReset(false);
+    connect(reportProgress_, &QProgressDialog::canceled, reportExporter_, &PdfReportExporter::cancel);
+
+    QSettings settings(configPath, QSettings::IniFormat);
+    QString tcpHost = settings.value("tcp/ip").toString();
+    int tcpPort = settings.value("tcp/port").toInt();
+    reportExporter_->start(path, exportRecords(), tcpHost, quint16(tcpPort));
 }
 
 
@@ -662,303 +814,451 @@ void HistoryView::requestPage()
 
 void HistoryView::onHistoryData(const QJsonObject &resp)
 {
-    tableWidget->clearContents();
+    // 서버 응답으로 저장소 전체 교체
     QJsonArray arr = resp.value("data").toArray();
-    
-    // 새로운 데이터를 받은 경우에만 전체 데이터 업데이트
-    if (currentPage == 0) {
-        allHistoryData = arr;
+    QList<HistoryRecord> records;
+    records.reserve(arr.size());
+    for (const QJsonValue &v : arr) {
+        records.append(HistoryRecord::fromJson(v.toObject()));
     }
-    
-    // 저장된 전체 데이터에서 클라이언트 사이드 필터링 (유형 + 날짜)
-    QJsonArray filteredArr;
-    
+    historyStore_.reset(records);
+
+    // 결과는 onFilterResults 에서 표시
+    applyFilters();
+}
+
+void HistoryView::onHistoryRecords(const QList<HistoryRecord> &records, bool firstBatch)
+{
+    StallWatchdog::Scope stallScope("HistoryView::onHistoryRecords");
+
+    // 새 응답의 첫 조각이 오면 기존 데이터를 교체
+    if (firstBatch) {
+        historyStore_.clear();
+        filteredRecords_.clear();
+        rebuildFilterQuery();
+        streamDeferred_ = !canUpdateIncrementally();
+        if (!streamDeferred_) {
+            tableWidget->clearContents();
+            tableWidget->setRowCount(0);
+        }
+    }
+
+    // 정렬/조회 중이라 바로 그릴 수 없으면 저장만 하고 응답 완료 후 한 번에 조회
+    if (streamDeferred_) {
+        for (const HistoryRecord &rec : records)
+            historyStore_.append(rec);
+        return;
+    }
+
+    // 도착한 레코드를 바로 저장소에 추가하고, 현재 페이지에 해당하면 행도 바로 채운다
+    QList<HistoryRecord> added;
+    added.reserve(records.size());
+    for (const HistoryRecord &rec : records) {
+        if (historyStore_.append(rec))
+            added.append(rec);
+    }
+
+    int startIndex = currentPage * PAGE_SIZE;
+    bool rowsAdded = false;
+    for (const HistoryRecord &rec : std::as_const(added)) {
+        if (!matchesFilters(rec)) continue;
+
+        filteredRecords_.append(rec);
+        int index = filteredRecords_.size() - 1;
+        if (index >= startIndex && index < startIndex + PAGE_SIZE) {
+            int row = tableWidget->rowCount();
+            tableWidget->setRowCount(row + 1);
+            populateRow(row, rec);
+            rowsAdded = true;
+        }
+    }
+
+    updatePaginationControls();
+    if (rowsAdded) {
+        syncHeaderCheck();
+        updateTypeColumnBackground();
+        resizeEvent(nullptr);
+    }
+}
+
+void HistoryView::onHistoryFinished(const QJsonObject &header, int recordCount)
+{
+    Q_UNUSED(header);
+
+    // 빈 응답이면 레코드 조각이 오지 않으므로 여기서 비운다
+    if (recordCount == 0) {
+        historyStore_.clear();
+        filteredRecords_.clear();
+    }
+
+    if (streamDeferred_ || (recordCount > 0 && !canUpdateIncrementally())) {
+        streamDeferred_ = false;
+        applyFilters();
+        return;
+    }
+
+    // 보던 페이지가 새 결과 범위를 벗어나면 첫 페이지로
+    if (currentPage * PAGE_SIZE >= filteredRecords_.size() && currentPage > 0) {
+        currentPage = 0;
+        refreshTable();
+    } else if (recordCount == 0) {
+        refreshTable();
+    } else {
+        updatePaginationControls();
+    }
+}
+
+HistoryQuery HistoryView::currentQuery()
+{
     // 유형 필터 매핑
     static const QMap<QString,int> filterMap = {
         {"주정차감지",0},{"과속감지",1},{"보행자감지",2}
     };
-    
-    for (int i = 0; i < allHistoryData.size(); ++i) {
-        auto obj = allHistoryData.at(i).toObject();
-        QString imagePath = obj.value("image_path").toString();
-        int eventType = obj.value("event_type").toInt();
-        
-        // 유형 필터링 체크
-        bool typeMatches = true;
-        if (!currentFilter.isEmpty() && currentFilter != "전체보기") {
-            int expectedType = filterMap.value(currentFilter, -1);
-            if (expectedType >= 0 && eventType != expectedType) {
-                typeMatches = false;
-            }
-        }
-        
-        // 날짜 필터링 체크
-        QDate fileDate = extractDateFromFilename(imagePath);
-        bool dateMatches = isDateInRange(fileDate, startDate, endDate);
-        
-        // 두 조건 모두 만족하는 경우만 추가
-        if (typeMatches && dateMatches) {
-            filteredArr.append(obj);
-        }
+
+    HistoryQuery query;
+    if (!currentFilter.isEmpty() && currentFilter != "전체보기")
+        query.eventType = filterMap.value(currentFilter, -1);
+    query.startDate = QDate::fromString(startDate, "yyyy-MM-dd");
+    query.endDate   = QDate::fromString(endDate, "yyyy-MM-dd");
+    // 번호판은 색인에서 바로 찾아 id 집합으로 넘긴다 (부분 일치 + OCR 오인식 허용)
+    const QString plateText = plateSearchEdit_->text().trimmed();
+    if (!plateText.isEmpty()) {
+        query.filterByPlate = true;
+        query.plateIds = historyStore_.plateIndex().search(plateText);
     }
-    
+    query.sortKey   = sortKey_;
+    query.order     = sortOrder_;
+    return query;
+}
+
+void HistoryView::rebuildFilterQuery()
+{
+    filterQuery_     = currentQuery();
+    filterPlateText_ = plateSearchEdit_->text().trimmed();
+}
+
+bool HistoryView::matchesFilters(const HistoryRecord &rec)
+{
+    // 조건은 필터 패스마다 한 번 만든 것을 쓴다. 그 뒤에 들어온 레코드는
+    // 색인 검색 결과(plateIds)에 없으므로 번호판만 직접 대조해 넣는다
+    if (filterQuery_.filterByPlate && !filterQuery_.plateIds.contains(rec.id)
+        && PlateSearchIndex::matches(rec.plateNumber, filterPlateText_))
+        filterQuery_.plateIds.insert(rec.id);
+    return filterQuery_.matches(rec);
+}
+
+bool HistoryView::canUpdateIncrementally() const
+{
+    // 조회가 진행 중이면 그 결과가 덮어쓰므로, 정렬이 기본(최신 순)이 아니면 위치를 알 수 없으므로 불가
+    return !queryEngine_->isRunning() && sortKey_ == HistoryQuery::SortByDate
+           && sortOrder_ == Qt::DescendingOrder;
+}
+
+void HistoryView::applyFilters()
+{
+    // 저장된 전체 데이터에 대한 필터/정렬을 작업 스레드에서 실행 (진행 중인 조회는 취소)
+    rebuildFilterQuery();
+    queryEngine_->run(historyStore_.records(), filterQuery_);
+}
+
+void HistoryView::onFilterResults(const QList<HistoryRecord> &results)
+{
+    // 결과 목록을 한 번에 교체
+    filteredRecords_ = results;
+    if (currentPage * PAGE_SIZE >= filteredRecords_.size()) {
+        currentPage = 0;
+    }
+    refreshTable();
+}
+
+void HistoryView::onSortSectionClicked(int column)
+{
+    HistoryQuery::SortKey key;
+    switch (column) {
+    case 1: key = HistoryQuery::SortByDate;  break;
+    case 3: key = HistoryQuery::SortByType;  break;
+    case 6: key = HistoryQuery::SortByPlate; break;
+    case 7: key = HistoryQuery::SortBySpeed; break;
+    default: return;
+    }
+
+    // 같은 열을 다시 누르면 방향만 바꾼다
+    if (key == sortKey_) {
+        sortOrder_ = (sortOrder_ == Qt::AscendingOrder) ? Qt::DescendingOrder : Qt::AscendingOrder;
+    } else {
+        sortKey_ = key;
+        sortOrder_ = (key == HistoryQuery::SortByDate || key == HistoryQuery::SortBySpeed)
+                         ? Qt::DescendingOrder : Qt::AscendingOrder;
+    }
+    tableWidget->horizontalHeader()->setSortIndicator(column, sortOrder_);
+
+    currentPage = 0;
+    applyFilters();
+}
+
+void HistoryView::refreshTable()
+{
+    StallWatchdog::Scope stallScope("HistoryView::refreshTable");
+
+    tableWidget->clearContents();
+
     // 페이지네이션 적용
-    int totalFiltered = filteredArr.size();
+    int totalFiltered = filteredRecords_.size();
     int startIndex = currentPage * PAGE_SIZE;
     int endIndex = qMin(startIndex + PAGE_SIZE, totalFiltered);
-    
-    QJsonArray pageArr;
-    for (int i = startIndex; i < endIndex; ++i) {
-        pageArr.append(filteredArr.at(i));
-    }
-    
-    int count = pageArr.size();
+    int count = qMax(0, endIndex - startIndex);
     tableWidget->setRowCount(count);
 
-    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
     for (int i = 0; i < count; ++i) {
-        auto obj = pageArr.at(i).toObject();
-        int id = obj.value("id").toInt();
-        recordDataMap[id] = obj;
-
-        // 체크박스
-        QWidget* cell = new QWidget(this);
-        auto* cb = new QCheckBox(cell);
-        cb->setChecked(selectedRecordIds.contains(id));
-        auto* lay = new QHBoxLayout(cell);
-        lay->addWidget(cb);
-        lay->setAlignment(Qt::AlignCenter);
-        lay->setContentsMargins(0,0,0,0);
-        cell->setLayout(lay);
-        tableWidget->setCellWidget(i,0,cell);
-
-        connect(cb, &QCheckBox::toggled, this, [this,id,i](bool on){
-            if (on) {
-                selectedRecordIds.insert(id);
-            } else {
-                selectedRecordIds.remove(id);
-            }
-            // header 상태 동기화
-            bool all = true;
-            for (int r = 0; r < tableWidget->rowCount(); ++r) {
-                auto* c = tableWidget->cellWidget(r,0);
-                if (auto* box = c?c->findChild<QCheckBox*>():nullptr) {
-                    if (!box->isChecked()) { all = false; break; }
-                }
-            }
-            headerCheck->blockSignals(true);
-            headerCheck->setChecked(all);
-            headerCheck->blockSignals(false);
+        populateRow(i, filteredRecords_.at(startIndex + i));
+    }
 
-            // 배경색 업데이트 (체크박스 상태에 따라)
-            updateTypeColumnBackground();
-        });
+    updatePaginationControls();
 
-        // 유형 정보 먼저 가져오기
-        int et = obj.value("event_type").toInt();
-        QString eventTypeStr = (et>=0&&et<typeNames.size()?typeNames[et]:QString::number(et));
-
-        // 날짜 (ID 저장) - 커스텀 위젯으로 변경
-        QString imagePath = obj.value("image_path").toString();
-        QString parsedTime = parseTimestampFromPath(imagePath, eventTypeStr);
-        QString dateText = parsedTime.isEmpty() ? obj.value("date").toString() : parsedTime;
-
-        QWidget* dateCell = new QWidget(this);
-        QLabel* dateLabel = new QLabel(dateText, dateCell);
-        dateLabel->setAlignment(Qt::AlignCenter);
-
-        QHBoxLayout* dateLayout = new QHBoxLayout(dateCell);
-        dateLayout->addWidget(dateLabel);
-        dateLayout->setAlignment(Qt::AlignCenter);
-        dateLayout->setContentsMargins(0, 0, 0, 0);
-        dateCell->setLayout(dateLayout);
-
-        tableWidget->setCellWidget(i, 1, dateCell);
-
-        // 빈 아이템도 설정 (ID 저장용)
-        QTableWidgetItem* emptyDateItem = new QTableWidgetItem();
-        emptyDateItem->setData(Qt::UserRole, id);
-        tableWidget->setItem(i, 1, emptyDateItem);
-
-        // 2번 열은 투명 패딩 (빈 공간) - 커스텀 위젯으로 변경
-        QWidget* paddingCell2 = new QWidget(this);
-        tableWidget->setCellWidget(i, 2, paddingCell2);
-
-        // 유형
-        QWidget* tc = new QWidget(this);
-        QLabel* lb = new QLabel(eventTypeStr,tc);
-        lb->setStyleSheet("background-color:#E0E0E0;border-radius:8px;padding:2px 6px;");
-        lb->setAlignment(Qt::AlignCenter);
-        auto* tl = new QHBoxLayout(tc);
-        tl->addWidget(lb);
-        tl->setAlignment(Qt::AlignCenter);
-        tl->setContentsMargins(0,0,0,0);
-        tc->setLayout(tl);
-        tableWidget->setCellWidget(i,3,tc);
-
-        // 4번 열은 투명 패딩 (빈 공간) - 커스텀 위젯으로 변경
-        QWidget* paddingCell4 = new QWidget(this);
-        tableWidget->setCellWidget(i, 4, paddingCell4);
-
-        // 나머지 열 (인덱스 +2 이동)
-        // 이미지 열 (5번) - 아이콘 또는 "-" 표시
-        if (!imagePath.isEmpty()) {
-            // 커스텀 위젯으로 아이콘을 중앙에 배치
-            QWidget* imageCell = new QWidget(this);
-            QLabel* imageLabel = new QLabel(imageCell);
-            imageLabel->setPixmap(QIcon(":/images/image.png").pixmap(16, 16));
-            imageLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* imageLayout = new QHBoxLayout(imageCell);
-            imageLayout->addWidget(imageLabel);
-            imageLayout->setAlignment(Qt::AlignCenter);
-            imageLayout->setContentsMargins(0, 0, 0, 0);
-            imageCell->setLayout(imageLayout);
-
-            // 경로 정보를 위젯의 property로 저장
-            imageCell->setProperty("imagePath", imagePath);
-
-            tableWidget->setCellWidget(i, 5, imageCell);
-
-            // 빈 아이템도 설정 (클릭 이벤트를 위해)
-            QTableWidgetItem* emptyItem = new QTableWidgetItem();
-            emptyItem->setData(Qt::UserRole, imagePath);
-            tableWidget->setItem(i, 5, emptyItem);
-        } else {
-            // "-" 텍스트도 커스텀 위젯으로 변경
-            QWidget* imageCell = new QWidget(this);
-            QLabel* imageLabel = new QLabel("-", imageCell);
-            imageLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* imageLayout = new QHBoxLayout(imageCell);
-            imageLayout->addWidget(imageLabel);
-            imageLayout->setAlignment(Qt::AlignCenter);
-            imageLayout->setContentsMargins(0, 0, 0, 0);
-            imageCell->setLayout(imageLayout);
-
-            tableWidget->setCellWidget(i, 5, imageCell);
-        }
+    // 헤더 체크박스 리셋 & 동기화
+    syncHeaderCheck();
 
-        // 번호판 - 커스텀 위젯으로 변경
-        QString plateText = obj.value("plate_number").toString();
-        QWidget* plateCell = new QWidget(this);
-        QLabel* plateLabel = new QLabel(plateText, plateCell);
-        plateLabel->setAlignment(Qt::AlignCenter);
-
-        QHBoxLayout* plateLayout = new QHBoxLayout(plateCell);
-        plateLayout->addWidget(plateLabel);
-        plateLayout->setAlignment(Qt::AlignCenter);
-        plateLayout->setContentsMargins(0, 0, 0, 0);
-        plateCell->setLayout(plateLayout);
-
-        tableWidget->setCellWidget(i, 6, plateCell);
-        // 속도 - 커스텀 위젯으로 변경
-        QJsonValue sp = obj.value("speed");
-        QString speedText = sp.isDouble() ? QString::number(sp.toDouble(),'f',2) : QString("-");
-
-        QWidget* speedCell = new QWidget(this);
-        QLabel* speedLabel = new QLabel(speedText, speedCell);
-        speedLabel->setAlignment(Qt::AlignCenter);
-
-        QHBoxLayout* speedLayout = new QHBoxLayout(speedCell);
-        speedLayout->addWidget(speedLabel);
-        speedLayout->setAlignment(Qt::AlignCenter);
-        speedLayout->setContentsMargins(0, 0, 0, 0);
-        speedCell->setLayout(speedLayout);
-
-        tableWidget->setCellWidget(i, 7, speedCell);
-
-        // 정차 시작 이미지 열 (8번) - 주정차감지일 때만 빈 값도 아이콘 표시
-        QString startSnapshot = obj.value("start_snapshot").toString();
-        
-        // 주정차감지(event_type == 0)일 때는 빈 값이어도 아이콘 표시, 다른 유형은 빈 값일 때 "-" 표시
-        if (!startSnapshot.isEmpty() || et == 0) {
-            // 커스텀 위젯으로 아이콘을 중앙에 배치
-            QWidget* startCell = new QWidget(this);
-            QLabel* startLabel = new QLabel(startCell);
-            startLabel->setPixmap(QIcon(":/images/image.png").pixmap(16, 16));
-            startLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* startLayout = new QHBoxLayout(startCell);
-            startLayout->addWidget(startLabel);
-            startLayout->setAlignment(Qt::AlignCenter);
-            startLayout->setContentsMargins(0, 0, 0, 0);
-            startCell->setLayout(startLayout);
-
-            // 경로 정보를 위젯의 property로 저장
-            startCell->setProperty("imagePath", startSnapshot);
-            qDebug() << "row:" << i << "startSnapshot:" << startSnapshot;
-            tableWidget->setCellWidget(i, 8, startCell);
-
-            // 빈 아이템도 설정 (클릭 이벤트를 위해)
-            QTableWidgetItem* startEmptyItem = new QTableWidgetItem();
-            startEmptyItem->setData(Qt::UserRole, startSnapshot);
-            tableWidget->setItem(i, 8, startEmptyItem);
-        } else {
-            // "-" 텍스트도 커스텀 위젯으로 변경
-            QWidget* startCell = new QWidget(this);
-            QLabel* startLabel = new QLabel("-", startCell);
-            startLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* startLayout = new QHBoxLayout(startCell);
-            startLayout->addWidget(startLabel);
-            startLayout->setAlignment(Qt::AlignCenter);
-            startLayout->setContentsMargins(0, 0, 0, 0);
-            startCell->setLayout(startLayout);
-
-            tableWidget->setCellWidget(i, 8, startCell);
-        }
+    // 체크된 항목들의 배경색 업데이트 (페이지 변경이나 필터링 후에도 유지)
+    updateTypeColumnBackground();
+    
+    // 테이블 높이 동적 조정 (행 높이 고정)
+    // rowCount 만큼만 공간 할당, row 높이는 Fixed 모드로 uH로 설정됨
+    resizeEvent(nullptr);
+}
 
-        // 1분 경과 이미지 열 (9번) - 주정차감지일 때만 빈 값도 아이콘 표시
-        QString endSnapshot = obj.value("end_snapshot").toString();
-        
-        // 주정차감지(event_type == 0)일 때는 빈 값이어도 아이콘 표시, 다른 유형은 빈 값일 때 "-" 표시
-        if (!endSnapshot.isEmpty() || et == 0) {
-            // 커스텀 위젯으로 아이콘을 중앙에 배치
-            QWidget* endCell = new QWidget(this);
-            QLabel* endLabel = new QLabel(endCell);
-            endLabel->setPixmap(QIcon(":/images/image.png").pixmap(16, 16));
-            endLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* endLayout = new QHBoxLayout(endCell);
-            endLayout->addWidget(endLabel);
-            endLayout->setAlignment(Qt::AlignCenter);
-            endLayout->setContentsMargins(0, 0, 0, 0);
-            endCell->setLayout(endLayout);
-
-            // 경로 정보를 위젯의 property로 저장
-            endCell->setProperty("imagePath", endSnapshot);
-
-            tableWidget->setCellWidget(i, 9, endCell);
-
-            // 빈 아이템도 설정 (클릭 이벤트를 위해)
-            QTableWidgetItem* endEmptyItem = new QTableWidgetItem();
-            endEmptyItem->setData(Qt::UserRole, endSnapshot);
-            tableWidget->setItem(i, 9, endEmptyItem);
+void HistoryView::populateRow(int row, const HistoryRecord &rec)
+{
+    int id = rec.id;
+
+    // 체크박스
+    QWidget* cell = new QWidget(this);
+    auto* cb = new QCheckBox(cell);
+    cb->setChecked(selectedRecordIds.contains(id));
+    auto* lay = new QHBoxLayout(cell);
+    lay->addWidget(cb);
+    lay->setAlignment(Qt::AlignCenter);
+    lay->setContentsMargins(0,0,0,0);
+    cell->setLayout(lay);
+    tableWidget->setCellWidget(row,0,cell);
+
+    connect(cb, &QCheckBox::toggled, this, [this,id](bool on){
+        if (on) {
+            selectedRecordIds.insert(id);
         } else {
-            // "-" 텍스트도 커스텀 위젯으로 변경
-            QWidget* endCell = new QWidget(this);
-            QLabel* endLabel = new QLabel("-", endCell);
-            endLabel->setAlignment(Qt::AlignCenter);
-
-            QHBoxLayout* endLayout = new QHBoxLayout(endCell);
-            endLayout->addWidget(endLabel);
-            endLayout->setAlignment(Qt::AlignCenter);
-            endLayout->setContentsMargins(0, 0, 0, 0);
-            endCell->setLayout(endLayout);
-
-            tableWidget->setCellWidget(i, 9, endCell);
+            selectedRecordIds.remove(id);
         }
+        // header 상태 동기화
+        syncHeaderCheck();
+
+        // 배경색 업데이트 (체크박스 상태에 따라)
+        updateTypeColumnBackground();
+    });
+
+    // 유형 정보 먼저 가져오기
+    int et = rec.eventType;
+    QString eventTypeStr = eventTypeName(et);
+
+    // 날짜 (ID 저장) - 커스텀 위젯으로 변경 (파일명 시각은 수집 시 계산됨)
+    QString imagePath = rec.imagePath;
+    const QString &dateText = rec.displayTime;
+
+    QWidget* dateCell = new QWidget(this);
+    QLabel* dateLabel = new QLabel(dateText, dateCell);
+    dateLabel->setAlignment(Qt::AlignCenter);
+
+    QHBoxLayout* dateLayout = new QHBoxLayout(dateCell);
+    dateLayout->addWidget(dateLabel);
+    dateLayout->setAlignment(Qt::AlignCenter);
+    dateLayout->setContentsMargins(0, 0, 0, 0);
+    dateCell->setLayout(dateLayout);
+
+    tableWidget->setCellWidget(row, 1, dateCell);
+
+    // 빈 아이템도 설정 (ID 저장용)
+    QTableWidgetItem* emptyDateItem = new QTableWidgetItem();
+    emptyDateItem->setData(Qt::UserRole, id);
+    tableWidget->setItem(row, 1, emptyDateItem);
+
+    // 2번 열은 투명 패딩 (빈 공간) - 커스텀 위젯으로 변경
+    QWidget* paddingCell2 = new QWidget(this);
+    tableWidget->setCellWidget(row, 2, paddingCell2);
+
+    // 유형
+    QWidget* tc = new QWidget(this);
+    QLabel* lb = new QLabel(eventTypeStr,tc);
+    lb->setStyleSheet("background-color:#E0E0E0;border-radius:8px;padding:2px 6px;");
+    lb->setAlignment(Qt::AlignCenter);
+    auto* tl = new QHBoxLayout(tc);
+    tl->addWidget(lb);
+    tl->setAlignment(Qt::AlignCenter);
+    tl->setContentsMargins(0,0,0,0);
+    tc->setLayout(tl);
+    tableWidget->setCellWidget(row,3,tc);
+
+    // 4번 열은 투명 패딩 (빈 공간) - 커스텀 위젯으로 변경
+    QWidget* paddingCell4 = new QWidget(this);
+    tableWidget->setCellWidget(row, 4, paddingCell4);
+
+    // 나머지 열 (인덱스 +2 이동)
+    // 이미지 열 (5번) - 아이콘 또는 "-" 표시
+    if (!imagePath.isEmpty()) {
+        // 커스텀 위젯으로 아이콘을 중앙에 배치
+        QWidget* imageCell = new QWidget(this);
+        QLabel* imageLabel = new QLabel(imageCell);
+        imageLabel->setPixmap(IconCache::icon(":/images/image.png").pixmap(16, 16));
+        imageLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* imageLayout = new QHBoxLayout(imageCell);
+        imageLayout->addWidget(imageLabel);
+        imageLayout->setAlignment(Qt::AlignCenter);
+        imageLayout->setContentsMargins(0, 0, 0, 0);
+        imageCell->setLayout(imageLayout);
+
+        // 경로 정보를 위젯의 property로 저장
+        imageCell->setProperty("imagePath", imagePath);
+
+        tableWidget->setCellWidget(row, 5, imageCell);
+
+        // 빈 아이템도 설정 (클릭 이벤트를 위해)
+        QTableWidgetItem* emptyItem = new QTableWidgetItem();
+        emptyItem->setData(Qt::UserRole, imagePath);
+        tableWidget->setItem(row, 5, emptyItem);
+    } else {
+        // "-" 텍스트도 커스텀 위젯으로 변경
+        QWidget* imageCell = new QWidget(this);
+        QLabel* imageLabel = new QLabel("-", imageCell);
+        imageLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* imageLayout = new QHBoxLayout(imageCell);
+        imageLayout->addWidget(imageLabel);
+        imageLayout->setAlignment(Qt::AlignCenter);
+        imageLayout->setContentsMargins(0, 0, 0, 0);
+        imageCell->setLayout(imageLayout);
+
+        tableWidget->setCellWidget(row, 5, imageCell);
+    }
+
+    // 번호판 - 커스텀 위젯으로 변경
+    QString plateText = rec.plateNumber;
+    QWidget* plateCell = new QWidget(this);
+    QLabel* plateLabel = new QLabel(plateText, plateCell);
+    plateLabel->setAlignment(Qt::AlignCenter);
+
+    QHBoxLayout* plateLayout = new QHBoxLayout(plateCell);
+    plateLayout->addWidget(plateLabel);
+    plateLayout->setAlignment(Qt::AlignCenter);
+    plateLayout->setContentsMargins(0, 0, 0, 0);
+    plateCell->setLayout(plateLayout);
+
+    tableWidget->setCellWidget(row, 6, plateCell);
+    // 속도 - 커스텀 위젯으로 변경
+    QString speedText = rec.hasSpeed ? QString::number(rec.speed,'f',2) : QString("-");
+
+    QWidget* speedCell = new QWidget(this);
+    QLabel* speedLabel = new QLabel(speedText, speedCell);
+    speedLabel->setAlignment(Qt::AlignCenter);
+
+    QHBoxLayout* speedLayout = new QHBoxLayout(speedCell);
+    speedLayout->addWidget(speedLabel);
+    speedLayout->setAlignment(Qt::AlignCenter);
+    speedLayout->setContentsMargins(0, 0, 0, 0);
+    speedCell->setLayout(speedLayout);
+
+    tableWidget->setCellWidget(row, 7, speedCell);
+
+    // 정차 시작 이미지 열 (8번) - 주정차감지일 때만 빈 값도 아이콘 표시
+    QString startSnapshot = rec.startSnapshot;
+    
+    // 주정차감지(event_type == 0)일 때는 빈 값이어도 아이콘 표시, 다른 유형은 빈 값일 때 "-" 표시
+    if (!startSnapshot.isEmpty() || et == 0) {
+        // 커스텀 위젯으로 아이콘을 중앙에 배치
+        QWidget* startCell = new QWidget(this);
+        QLabel* startLabel = new QLabel(startCell);
+        startLabel->setPixmap(IconCache::icon(":/images/image.png").pixmap(16, 16));
+        startLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* startLayout = new QHBoxLayout(startCell);
+        startLayout->addWidget(startLabel);
+        startLayout->setAlignment(Qt::AlignCenter);
+        startLayout->setContentsMargins(0, 0, 0, 0);
+        startCell->setLayout(startLayout);
+
+        // 경로 정보를 위젯의 property로 저장
+        startCell->setProperty("imagePath", startSnapshot);
+        tableWidget->setCellWidget(row, 8, startCell);
+
+        // 빈 아이템도 설정 (클릭 이벤트를 위해)
+        QTableWidgetItem* startEmptyItem = new QTableWidgetItem();
+        startEmptyItem->setData(Qt::UserRole, startSnapshot);
+        tableWidget->setItem(row, 8, startEmptyItem);
+    } else {
+        // "-" 텍스트도 커스텀 위젯으로 변경
+        QWidget* startCell = new QWidget(this);
+        QLabel* startLabel = new QLabel("-", startCell);
+        startLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* startLayout = new QHBoxLayout(startCell);
+        startLayout->addWidget(startLabel);
+        startLayout->setAlignment(Qt::AlignCenter);
+        startLayout->setContentsMargins(0, 0, 0, 0);
+        startCell->setLayout(startLayout);
+
+        tableWidget->setCellWidget(row, 8, startCell);
     }
 
+    // 1분 경과 이미지 열 (9번) - 주정차감지일 때만 빈 값도 아이콘 표시
+    QString endSnapshot = rec.endSnapshot;
+    
+    // 주정차감지(event_type == 0)일 때는 빈 값이어도 아이콘 표시, 다른 유형은 빈 값일 때 "-" 표시
+    if (!endSnapshot.isEmpty() || et == 0) {
+        // 커스텀 위젯으로 아이콘을 중앙에 배치
+        QWidget* endCell = new QWidget(this);
+        QLabel* endLabel = new QLabel(endCell);
+        endLabel->setPixmap(IconCache::icon(":/images/image.png").pixmap(16, 16));
+        endLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* endLayout = new QHBoxLayout(endCell);
+        endLayout->addWidget(endLabel);
+        endLayout->setAlignment(Qt::AlignCenter);
+        endLayout->setContentsMargins(0, 0, 0, 0);
+        endCell->setLayout(endLayout);
+
+        // 경로 정보를 위젯의 property로 저장
+        endCell->setProperty("imagePath", endSnapshot);
+
+        tableWidget->setCellWidget(row, 9, endCell);
+
+        // 빈 아이템도 설정 (클릭 이벤트를 위해)
+        QTableWidgetItem* endEmptyItem = new QTableWidgetItem();
+        endEmptyItem->setData(Qt::UserRole, endSnapshot);
+        tableWidget->setItem(row, 9, endEmptyItem);
+    } else {
+        // "-" 텍스트도 커스텀 위젯으로 변경
+        QWidget* endCell = new QWidget(this);
+        QLabel* endLabel = new QLabel("-", endCell);
+        endLabel->setAlignment(Qt::AlignCenter);
+
+        QHBoxLayout* endLayout = new QHBoxLayout(endCell);
+        endLayout->addWidget(endLabel);
+        endLayout->setAlignment(Qt::AlignCenter);
+        endLayout->setContentsMargins(0, 0, 0, 0);
+        endCell->setLayout(endLayout);
+
+        tableWidget->setCellWidget(row, 9, endCell);
+    }
+}
+
+void HistoryView::updatePaginationControls()
+{
     // 페이징 업데이트 (필터링된 전체 데이터 기준)
     prevButton->setVisible(currentPage > 0);  // 1페이지일 때 숨김
-    bool hasNextPage = (startIndex + PAGE_SIZE) < totalFiltered;
+    bool hasNextPage = (currentPage + 1) * PAGE_SIZE < filteredRecords_.size();
     nextButton->setVisible(hasNextPage);  // 다음 페이지가 있을 때만 표시
     pageLabel->setText(QString::number(currentPage + 1));
+}
 
-    // 헤더 체크박스 리셋 & 동기화
-    headerCheck->blockSignals(true);
+void HistoryView::syncHeaderCheck()
+{
     bool allChecked = true;
     for (int r = 0; r < tableWidget->rowCount(); ++r) {
         auto* c = tableWidget->cellWidget(r,0);
@@ -966,15 +1266,61 @@ void HistoryView::onHistoryData(const QJsonObject &resp)
             if (!box->isChecked()) { allChecked = false; break; }
         }
     }
+    headerCheck->blockSignals(true);
     headerCheck->setChecked(allChecked);
     headerCheck->blockSignals(false);
+}
 
-    // 체크된 항목들의 배경색 업데이트 (페이지 변경이나 필터링 후에도 유지)
-    updateTypeColumnBackground();
-    
-    // 테이블 높이 동적 조정 (행 높이 고정)
-    // rowCount 만큼만 공간 할당, row 높이는 Fixed 모드로 uH로 설정됨
-    resizeEvent(nullptr);
+void HistoryView::handleMqttEvents(const QList<MqttEvent> &events)
+{
+    // 한 건이면 해당 행만 삽입
+    if (events.size() == 1) {
+        addLiveRecord(events.first().record);
+        return;
+    }
+
+    // 여러 건이 한꺼번에 오면 저장만 하고 필터/화면 갱신은 한 번
+    bool added = false;
+    for (const MqttEvent &event : events)
+        added |= historyStore_.prepend(event.record);
+    if (added)
+        applyFilters();
+}
+
+void HistoryView::addLiveRecord(const HistoryRecord &rec)
+{
+    // 이미 받은 이벤트면 무시 (새로고침 응답과 겹치는 경우)
+    if (!historyStore_.prepend(rec)) return;
+    if (!canUpdateIncrementally()) {
+        applyFilters();
+        return;
+    }
+    if (!matchesFilters(rec)) return;
+    // 늦게 도착한 이전 시각 이벤트는 맨 위가 아니므로 다시 정렬
+    if (!filteredRecords_.isEmpty() && rec.displayTime < filteredRecords_.first().displayTime) {
+        applyFilters();
+        return;
+    }
+
+    filteredRecords_.prepend(rec);
+
+    // 첫 페이지를 보고 있을 때만 맨 위에 한 줄 삽입 (다른 페이지는 화면 유지)
+    if (currentPage == 0) {
+        tableWidget->insertRow(0);
+        populateRow(0, rec);
+
+        int rows = tableWidget->rowCount();
+        if (rows > PAGE_SIZE) {
+            tableWidget->removeRow(rows - 1);
+        } else {
+            // 행이 늘어난 경우에만 테이블 높이 조정 (헤더 1행 + 데이터 rows)
+            int uH = tableWidget->verticalHeader()->defaultSectionSize();
+            tableWidget->resize(tableWidget->width(), uH * (1 + rows));
+        }
+        syncHeaderCheck();
+    }
+
+    updatePaginationControls();
 }
 
 void HistoryView::onHistoryError(const QString &err)
@@ -984,6 +1330,8 @@ void HistoryView::onHistoryError(const QString &err)
 
 void HistoryView::updateTypeColumnBackground()
 {
+    StallWatchdog::Scope stallScope("HistoryView::updateTypeColumnBackground");
+
     // 동적 스타일시트 생성
     QString dynamicStyle =
         "QTableWidget { border: none; selection-background-color: transparent; }"
@@ -1047,9 +1395,7 @@ void HistoryView::prevPage()
     if (currentPage > 0) { 
         --currentPage; 
         // 저장된 데이터로 페이지 업데이트 (서버 요청 없이)
-        QJsonObject dummyResp;
-        dummyResp["data"] = allHistoryData;
-        onHistoryData(dummyResp);
+        refreshTable();
     }
 }
 
@@ -1057,9 +1403,7 @@ void HistoryView::nextPage()
 {
     ++currentPage; 
     // 저장된 데이터로 페이지 업데이트 (서버 요청 없이)
-    QJsonObject dummyResp;
-    dummyResp["data"] = allHistoryData;
-    onHistoryData(dummyResp);
+    refreshTable();
 }
 
 void HistoryView::setupPaginationUI()
@@ -1082,16 +1426,24 @@ void HistoryView::setupPaginationUI()
 
 void HistoryView::resizeEvent(QResizeEvent *event)
 {
+    StallWatchdog::Scope stallScope("HistoryView::resizeEvent");
+
     QWidget::resizeEvent(event);
     int w = width();
     int h = height();
     double wu = w / 24.0;
     double hu = h / 21.0;
-    int uW = int(wu);
     int uH = int(hu);
 
     int yOffset = hu * 3;  // 올릴 높이
 
+    // 폰트/스타일시트/아이콘은 크기가 바뀔 때만 다시 만든다.
+    // refreshTable 등이 행 수만 바뀌어 resizeEvent(nullptr) 로 부를 때는 배치만 한다.
+    if (size() != styledSize_) {
+        styledSize_ = size();
+        applyScaledStyles();
+    }
+
     // 히스토리 제목의 실제 크기에 맞게 geometry 설정
     QPixmap titlePixmap = titleLabel->pixmap();
     int titleWidth = titlePixmap.isNull() ? int(wu*2) : qMax(titlePixmap.width() + 10, int(wu*2));
@@ -1102,20 +1454,6 @@ void HistoryView::resizeEvent(QResizeEvent *event)
     int tableH = uH * (1 + rows); // 헤더 1행 + 데이터 rows
     tableWidget->setGeometry(wu*1, hu*4 - yOffset, wu*22, tableH);
 
-    // 각 열 너비, 행 높이 고정 (2번, 4번 인덱스에 투명 패딩 열 추가)
-    static constexpr double cw[10] = {1.5,3,0.5,2,0.5,2,3,3,2,2};
-    for (int c = 0; c < 10; ++c)
-        tableWidget->setColumnWidth(c, int(cw[c] * uW));
-    tableWidget->verticalHeader()->setDefaultSectionSize(uH);
-    tableWidget->horizontalHeader()->setFixedHeight(uH);
-    // 폰트 크기도 해상도에 맞게 조정
-    int headerFontSize = int(hu*0.5);
-    tableWidget->horizontalHeader()->setStyleSheet(QString(
-        "QHeaderView::section { background:#FBB584; padding:4px; border:none; font-size:%1px; }"
-        "QHeaderView::section:nth-child(3) { background:transparent; }"
-        "QHeaderView::section:nth-child(5) { background:transparent; }"
-        ).arg(headerFontSize));
-
     // header checkbox 위치 - 더 명확하게 설정
     QHeaderView* hh = tableWidget->horizontalHeader();
     int x0 = hh->sectionPosition(0);
@@ -1123,26 +1461,93 @@ void HistoryView::resizeEvent(QResizeEvent *event)
     int hh_h = hh->height();
     int cbSize = qMin(hh_h - 4, 24); // 체크박스 크기 제한
     
-    // 체크박스를 헤더 영역에 직접 배치
-    headerCheck->setParent(this); // 부모를 this로 변경
+    // 체크박스를 헤더 영역에 직접 배치 (처음 한 번만 부모를 this로 변경)
+    if (headerCheck->parentWidget() != this) {
+        headerCheck->setParent(this);
+        headerCheck->show();
+        headerCheck->raise(); // 맨 앞으로 가져오기
+    }
     headerCheck->setGeometry(
         tableWidget->x() + x0 + (w0 - cbSize)/2,
         tableWidget->y() + (hh_h - cbSize)/2,
         cbSize, cbSize
     );
-    headerCheck->show();
-    headerCheck->raise(); // 맨 앞으로 가져오기
+
+    // 번호판 검색창 (시작일 버튼 왼쪽)
+    plateSearchEdit_->setGeometry(int(wu*10.5), int(hu*3 - yOffset + hu*0.15), int(wu*3.3), int(hu*0.7));
 
     // 시작일 버튼 위치와 크기 고정 (정확한 위치로 설정)
     int startButtonWidth = int(wu*3);
     int startButtonX = int(wu*14.0);
     startDateButton->setGeometry(startButtonX, hu*3 - yOffset, startButtonWidth, uH);
-    startDateButton->setIconSize(QSize(int(hu*0.5), int(hu*0.5)));
-    startDateButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-    startDateButton->setFixedSize(startButtonWidth, uH);
+    
+    arrowLabel->setGeometry(wu*17.2, hu*3 - yOffset, wu*0.5, uH);
+    
+    // 종료일 버튼 위치와 크기 고정 (화살표 다음에 정확히 배치)
+    int endButtonWidth = int(wu*3);
+    int endButtonX = int(wu*17.7);
+    endDateButton->setGeometry(endButtonX, hu*3 - yOffset, endButtonWidth, uH);
+    
+    int filterButtonWidth = int(wu*1.4);
+    filterButton->setGeometry(wu*19.6, hu*3 - yOffset, filterButtonWidth, uH);
+
+    // 세로 구분선 (필터 버튼과 다운로드 버튼 사이)
+    int separatorX = int(wu*21.4);
+    int separatorY = int(hu*3 - yOffset + hu*0.2);
+    int separatorHeight = int(hu*0.6);
+    separatorLine->setGeometry(separatorX, separatorY, 1, separatorHeight);
+    
+    downloadButton  ->setGeometry(wu*22.5 - uH - wu*0.2, hu*3 - yOffset, uH, uH);
+    refreshButton   ->setGeometry(wu*22.5, hu*3 - yOffset, uH, uH);
+
+    // 페이징: 가로 8칸, 중앙, row22
+    int navX = int(wu*8);
+    int navY = int(hu*22 - yOffset);
+    int navH = uH;
+    int btnSize = navH; // 정사각형으로 만들기 위해 높이와 동일하게 설정
+    int totalWidth = btnSize * 2 + int(wu*2); // 버튼 2개 + 라벨 너비
+    int startX = navX + (int(wu*8) - totalWidth) / 2; // 중앙 정렬
+
+    // 페이징 버튼 geometry 설정 (정사각형)
+    prevButton->setGeometry(startX,                    navY, btnSize, navH);
+    pageLabel ->setGeometry(startX + btnSize,          navY, int(wu*2), navH);
+    nextButton->setGeometry(startX + btnSize + int(wu*2), navY, btnSize, navH);
+}
+
+void HistoryView::applyScaledStyles()
+{
+    double wu = width() / 24.0;
+    double hu = height() / 21.0;
+    int uW = int(wu);
+    int uH = int(hu);
+
+    // 각 열 너비, 행 높이 고정 (2번, 4번 인덱스에 투명 패딩 열 추가)
+    static constexpr double cw[10] = {1.5,3,0.5,2,0.5,2,3,3,2,2};
+    for (int c = 0; c < 10; ++c)
+        tableWidget->setColumnWidth(c, int(cw[c] * uW));
+    tableWidget->verticalHeader()->setDefaultSectionSize(uH);
+    tableWidget->horizontalHeader()->setFixedHeight(uH);
+    // 폰트 크기도 해상도에 맞게 조정
+    int headerFontSize = int(hu*0.5);
+    setStyleSheetIfChanged(tableWidget->horizontalHeader(), QString(
+        "QHeaderView::section { background:#FBB584; padding:4px; border:none; font-size:%1px; }"
+        "QHeaderView::section:nth-child(3) { background:transparent; }"
+        "QHeaderView::section:nth-child(5) { background:transparent; }"
+        ).arg(headerFontSize));
+
+    setStyleSheetIfChanged(plateSearchEdit_, QString(
+        "QLineEdit { border:1px solid #D3D3D3; border-radius:4px; padding:0 4px; font-size:%1px; }"
+        "QLineEdit:focus { border:1px solid #FBB584; }"
+    ).arg(int(hu*0.35)));
+
+    // 날짜 버튼 크기/스타일
+    int startButtonWidth = int(wu*3);
     int buttonFontSize = int(hu*0.35);
     int iconSize = int(hu*0.5);
-    startDateButton->setStyleSheet(QString(
+    startDateButton->setIconSize(QSize(iconSize, iconSize));
+    startDateButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    startDateButton->setFixedSize(startButtonWidth, uH);
+    setStyleSheetIfChanged(startDateButton, QString(
         "QPushButton {"
         "    padding: 2px;"
         "    background: transparent;"
@@ -1156,21 +1561,15 @@ void HistoryView::resizeEvent(QResizeEvent *event)
         "    qproperty-iconSize: %4px %4px;"
         "}"
     ).arg(buttonFontSize).arg(startButtonWidth).arg(uH).arg(iconSize));
-    
-    // 버튼 위치를 강제로 고정
-    startDateButton->move(startButtonX, hu*3 - yOffset);
-    
-    arrowLabel->setGeometry(wu*17.2, hu*3 - yOffset, wu*0.5, uH);
-    arrowLabel->setPixmap(QPixmap(":/images/sign.png").scaled(int(hu*0.4), int(hu*0.4), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    
-    // 종료일 버튼 위치와 크기 고정 (화살표 다음에 정확히 배치)
+
+    // 화살표 그림 (크기별 축소본은 IconCache 가 재사용)
+    arrowLabel->setPixmap(IconCache::scaled(":/images/sign.png", QSize(int(hu*0.4), int(hu*0.4))));
+
     int endButtonWidth = int(wu*3);
-    int endButtonX = int(wu*17.7);
-    endDateButton->setGeometry(endButtonX, hu*3 - yOffset, endButtonWidth, uH);
-    endDateButton->setIconSize(QSize(int(hu*0.5), int(hu*0.5)));
+    endDateButton->setIconSize(QSize(iconSize, iconSize));
     endDateButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     endDateButton->setFixedSize(endButtonWidth, uH);
-    endDateButton->setStyleSheet(QString(
+    setStyleSheetIfChanged(endDateButton, QString(
         "QPushButton {"
         "    padding: 2px;"
         "    background: transparent;"
@@ -1185,12 +1584,8 @@ void HistoryView::resizeEvent(QResizeEvent *event)
         "}"
     ).arg(buttonFontSize).arg(endButtonWidth).arg(uH).arg(iconSize));
     
-    // 버튼 위치를 강제로 고정
-    endDateButton->move(endButtonX, hu*3 - yOffset);
-    
     int filterButtonWidth = int(wu*1.4);
-    filterButton->setGeometry(wu*19.6, hu*3 - yOffset, filterButtonWidth, uH);
-    filterButton->setStyleSheet(QString(R"(
+    setStyleSheetIfChanged(filterButton, QString(R"(
         QToolButton{
             background:white;
             border:1px solid #D3D3D3;
@@ -1219,7 +1614,7 @@ void HistoryView::resizeEvent(QResizeEvent *event)
     // 메뉴 크기를 버튼 크기에 맞게 설정
     if (filterButton->menu()) {
         filterButton->menu()->setFixedWidth(filterButtonWidth);  // 정확히 버튼 너비와 맞춤
-        filterButton->menu()->setStyleSheet(QString(R"(
+        setStyleSheetIfChanged(filterButton->menu(), QString(R"(
             QMenu{
                 background:#FBB584;
                 border:none;
@@ -1236,20 +1631,12 @@ void HistoryView::resizeEvent(QResizeEvent *event)
             }
         )").arg(filterButtonWidth));
     }
-    // 세로 구분선 (필터 버튼과 다운로드 버튼 사이)
-    int separatorX = int(wu*21.4);
-    int separatorY = int(hu*3 - yOffset + hu*0.2);
-    int separatorHeight = int(hu*0.6);
-    separatorLine->setGeometry(separatorX, separatorY, 1, separatorHeight);
-    
-    downloadButton  ->setGeometry(wu*22.5 - uH - wu*0.2, hu*3 - yOffset, uH, uH);
-    downloadButton->setIconSize(QSize(int(hu*0.7), int(hu*0.7)));
 
-    refreshButton   ->setGeometry(wu*22.5, hu*3 - yOffset, uH, uH);
+    downloadButton->setIconSize(QSize(int(hu*0.7), int(hu*0.7)));
     refreshButton->setIconSize(QSize(int(hu*0.7), int(hu*0.7)));
 
     // 캘린더 컨테이너 스타일 설정
-    calendarContainer->setStyleSheet(QString(R"(
+    setStyleSheetIfChanged(calendarContainer, QString(R"(
         QWidget {
             background-color: white;
             border: %1px solid #FBB584;
@@ -1257,24 +1644,11 @@ void HistoryView::resizeEvent(QResizeEvent *event)
         }
     )").arg(int(hu*0.1)));
 
-    // 페이징: 가로 8칸, 중앙, row22
-    int navX = int(wu*8);
-    int navY = int(hu*22 - yOffset);
-    int navH = uH;
-    int btnSize = navH; // 정사각형으로 만들기 위해 높이와 동일하게 설정
-    int totalWidth = btnSize * 2 + int(wu*2); // 버튼 2개 + 라벨 너비
-    int startX = navX + (int(wu*8) - totalWidth) / 2; // 중앙 정렬
-
-    // 페이징 버튼 geometry 설정 (정사각형)
-    prevButton->setGeometry(startX,                    navY, btnSize, navH);
-    pageLabel ->setGeometry(startX + btnSize,          navY, int(wu*2), navH);
-    nextButton->setGeometry(startX + btnSize + int(wu*2), navY, btnSize, navH);
-
     // 페이징 버튼 스타일 설정 (글씨 크기 키움)
     int fontSize = int(hu * 0.6); // 글씨 크기를 키움
     int pagingIconSize = int(hu * 0.7); // 아이콘 크기 (변수명 변경)
     
-    QString buttonStyle = QString(
+    const QString buttonStyle = QString(
         "QPushButton {"
         "    background-color: transparent;"
         "    border: none;"
@@ -1290,15 +1664,15 @@ void HistoryView::resizeEvent(QResizeEvent *event)
         "}"
         );
 
-    prevButton->setStyleSheet(buttonStyle);
-    nextButton->setStyleSheet(buttonStyle);
+    setStyleSheetIfChanged(prevButton, buttonStyle);
+    setStyleSheetIfChanged(nextButton, buttonStyle);
 
     // 아이콘 크기 설정
     prevButton->setIconSize(QSize(pagingIconSize, pagingIconSize));
     nextButton->setIconSize(QSize(pagingIconSize, pagingIconSize));
     
     // 페이지 라벨 스타일 설정 (테두리 제거)
-    pageLabel->setStyleSheet(QString(
+    setStyleSheetIfChanged(pageLabel, QString(
                                  "QLabel {"
                                  "    font-size: %1px;"
                                  "    font-weight: bold;"
@@ -1551,14 +1925,12 @@ void HistoryView::dateSelected()
     }
 
     // 하나라도 날짜가 설정되면 필터링 실행
-    qDebug() << "날짜 필터 설정 - 시작일:" << startDate << "종료일:" << endDate;
+    qCDebug(lcHistory) << "날짜 필터 설정 - 시작일:" << startDate << "종료일:" << endDate;
     currentPage = 0;
     
     // 저장된 데이터가 있으면 바로 필터링, 없으면 서버에서 데이터 요청
-    if (!allHistoryData.isEmpty()) {
-        QJsonObject dummyResp;
-        dummyResp["data"] = allHistoryData;
-        onHistoryData(dummyResp);
+    if (!historyStore_.isEmpty()) {
+        applyFilters();
     } else {
         requestPage();
     }
@@ -1597,6 +1969,10 @@ bool HistoryView::eventFilter(QObject *obj, QEvent *event)
 
 QString HistoryView::findConfigFile()
 {
+    // 이미지 요청마다 불리므로 한 번 찾은 경로는 다시 검색하지 않는다
+    if (!configPath_.isEmpty())
+        return configPath_;
+
     // config.ini 파일을 여러 경로에서 찾기
     QStringList searchPaths = {
         "config.ini",                    // 현재 디렉토리
@@ -1607,26 +1983,21 @@ QString HistoryView::findConfigFile()
         QDir::currentPath() + "/config.ini"  // 현재 작업 디렉토리
     };
 
-    qDebug() << "[History] config.ini 파일 검색 중...";
-    qDebug() << "[History] 현재 작업 디렉토리:" << QDir::currentPath();
-    qDebug() << "[History] 실행 파일 디렉토리:" << QCoreApplication::applicationDirPath();
-
     for (const QString &path : searchPaths) {
-        QFile file(path);
-        qDebug() << "[History] 검색 경로:" << path << "존재:" << file.exists();
-        if (file.exists()) {
-            qDebug() << "[History] config.ini 파일 발견:" << path;
-            return path;
+        if (QFile::exists(path)) {
+            qCDebug(lcConfig) << "config.ini 파일 발견:" << path;
+            configPath_ = path;
+            return configPath_;
         }
     }
 
-    qDebug() << "[History] config.ini 파일을 찾을 수 없습니다";
+    qCWarning(lcConfig) << "config.ini 파일을 찾을 수 없습니다. 검색 경로:" << searchPaths;
     return QString(); // 빈 문자열 반환
 }
 
 void HistoryView::loadDummyData()
 {
-    qDebug() << "히스토리 서버 연결 실패 - 더미 데이터 로드";
+    qCInfo(lcHistory) << "히스토리 서버 연결 실패 - 더미 데이터 로드";
     currentPage = 0; // 페이지를 0으로 초기화
     QJsonObject dummyResponse = createDummyHistoryResponse();
     onHistoryData(dummyResponse);
@@ -1722,79 +2093,3 @@ QJsonObject HistoryView::createDummyHistoryResponse()
 
     return response;
 }
-
-
-QDate HistoryView::extractDateFromFilename(const QString& filename) {
-    // 과속감지일 경우 뒷쪽 날짜 우선 시도 (YYYY-MM-DD 형식)
-    QRegularExpression backDateRegex(R"((\d{4})-(\d{2})-(\d{2}))");
-    QRegularExpressionMatch backMatch = backDateRegex.match(filename);
-    if (backMatch.hasMatch()) {
-        int year = backMatch.captured(1).toInt();
-        int month = backMatch.captured(2).toInt();
-        int day = backMatch.captured(3).toInt();
-        QDate result = QDate(year, month, day);
-        qDebug() << "뒷쪽 날짜 파싱:" << filename << "→" << result.toString("yyyy-MM-dd");
-        return result;
-    }
-    
-    // 앞쪽 날짜 시도 (YYYYMMDD 형식)
-    QRegularExpression frontDateRegex(R"((\d{8}))");
-    QRegularExpressionMatch frontMatch = frontDateRegex.match(filename);
-    if (frontMatch.hasMatch()) {
-        QString dateStr = frontMatch.captured(1);
-        if (dateStr.length() == 8) {
-            int year = dateStr.mid(0, 4).toInt();
-            int month = dateStr.mid(4, 2).toInt();
-            int day = dateStr.mid(6, 2).toInt();
-            QDate result = QDate(year, month, day);
-            qDebug() << "앞쪽 날짜 파싱:" << filename << "→" << result.toString("yyyy-MM-dd");
-            return result;
-        }
-    }
-    
-    qDebug() << "날짜 파싱 실패:" << filename;
-    return QDate(); // 유효하지 않은 날짜 반환
-}
-
-bool HistoryView::isDateInRange(const QDate& date, const QString& startDateStr, const QString& endDateStr) {
-    if (!date.isValid()) {
-        return false;
-    }
-    
-    // 날짜 범위가 전혀 설정되지 않은 경우 모든 날짜 허용
-    if (startDateStr.isEmpty() && endDateStr.isEmpty()) {
-        return true;
-    }
-    
-    QDate startDate = QDate::fromString(startDateStr, "yyyy-MM-dd");
-    QDate endDate = QDate::fromString(endDateStr, "yyyy-MM-dd");
-    
-    // 시작일만 설정된 경우
-    if (!startDateStr.isEmpty() && endDateStr.isEmpty()) {
-        if (startDate.isValid()) {
-            bool result = date >= startDate;
-            qDebug() << "시작일만 설정 - 날짜:" << date.toString("yyyy-MM-dd") << "시작일:" << startDateStr << "결과:" << result;
-            return result;
-        }
-        return true;
-    }
-    
-    // 종료일만 설정된 경우
-    if (startDateStr.isEmpty() && !endDateStr.isEmpty()) {
-        if (endDate.isValid()) {
-            bool result = date <= endDate;
-            qDebug() << "종료일만 설정 - 날짜:" << date.toString("yyyy-MM-dd") << "종료일:" << endDateStr << "결과:" << result;
-            return result;
-        }
-        return true;
-    }
-    
-    // 시작일과 종료일이 모두 설정된 경우
-    if (startDate.isValid() && endDate.isValid()) {
-        bool result = date >= startDate && date <= endDate;
-        qDebug() << "시작일+종료일 설정 - 날짜:" << date.toString("yyyy-MM-dd") << "범위:" << startDateStr << "~" << endDateStr << "결과:" << result;
-        return result;
-    }
-    
-    return true;
-}
\ No newline at end of file
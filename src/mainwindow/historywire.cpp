@@ -0,0 +1,226 @@
+// historywire.cpp
+#include "mainwindow/historywire.h"
+#include <QDateTime>
+#include <QTimeZone>
+
+namespace {
+
+// LEB128 varint. 데이터가 모자라면 0, 10바이트를 넘으면 -1
+int readVarint(const char *p, const char *end, quint64 &out)
+{
+    out = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (p + i >= end)
+            return 0;
+        const quint8 b = quint8(p[i]);
+        out |= quint64(b & 0x7F) << (7 * i);
+        if (!(b & 0x80))
+            return i + 1;
+    }
+    return -1;
+}
+
+qint64 unzigzag(quint64 v)
+{
+    return qint64(v >> 1) ^ -qint64(v & 1);
+}
+
+// 행 내부처럼 길이가 이미 확인된 구간에서 읽기 (부족하면 실패)
+bool takeVarint(const char *&p, const char *end, quint64 &out)
+{
+    const int n = readVarint(p, end, out);
+    if (n <= 0)
+        return false;
+    p += n;
+    return true;
+}
+
+bool takeString(const char *&p, const char *end, QString &out)
+{
+    quint64 len = 0;
+    if (!takeVarint(p, end, len) || len > quint64(end - p))
+        return false;
+    out = QString::fromUtf8(p, qsizetype(len));
+    p += len;
+    return true;
+}
+
+} // namespace
+
+HistoryWireDecoder::HistoryWireDecoder()
+{
+    reset();
+}
+
+void HistoryWireDecoder::reset()
+{
+    buffer_.resize(0);
+    magicSeen_   = false;
+    dict_.clear();
+    prevId_      = 0;
+    prevTs_      = 0;
+    pending_.clear();
+    header_      = QJsonObject();
+    recordCount_ = 0;
+    complete_    = false;
+    error_.clear();
+}
+
+QList<HistoryRecord> HistoryWireDecoder::takeRecords()
+{
+    QList<HistoryRecord> out;
+    out.swap(pending_);
+    return out;
+}
+
+qsizetype HistoryWireDecoder::feed(const char *data, qsizetype size)
+{
+    if (complete_ || hasError())
+        return 0;
+
+    const qsizetype carried = buffer_.size();
+    buffer_.append(data, size);
+
+    const char *base = buffer_.constData();
+    const char *end  = base + buffer_.size();
+    const char *p    = base;
+
+    if (!magicSeen_) {
+        if (end - p < 2) {
+            return size;
+        }
+        if (p[0] != HistoryWire::Magic0 || p[1] != HistoryWire::Magic1) {
+            error_ = QStringLiteral("바이너리 응답 헤더가 올바르지 않습니다");
+            return 0;
+        }
+        magicSeen_ = true;
+        p += 2;
+    }
+
+    while (p < end && !complete_) {
+        const qsizetype n = parseItem(p, end);
+        if (n < 0) {
+            buffer_.resize(0);
+            return qMax<qsizetype>(0, (p - base) - carried);
+        }
+        if (n == 0)
+            break;
+        p += n;
+    }
+
+    if (complete_) {
+        // END 뒤의 바이트는 다음 응답 몫이므로 돌려준다
+        const qsizetype consumed = (p - base) - carried;
+        buffer_.resize(0);
+        return consumed;
+    }
+
+    buffer_.remove(0, p - base);
+    return size;
+}
+
+qsizetype HistoryWireDecoder::parseItem(const char *p, const char *end)
+{
+    const char *start = p;
+    const quint8 tag = quint8(*p++);
+
+    quint64 a = 0, len = 0;
+    int n = 0;
+
+    switch (tag) {
+    case HistoryWire::TagDict:
+    case HistoryWire::TagEnd:
+        if ((n = readVarint(p, end, a)) <= 0) break;
+        p += n;
+        if ((n = readVarint(p, end, len)) <= 0) break;
+        p += n;
+        if (len > quint64(end - p)) return 0;
+
+        if (tag == HistoryWire::TagDict) {
+            if (a != quint64(dict_.size()) + 1) {
+                error_ = QStringLiteral("사전 항목 순서가 올바르지 않습니다");
+                return -1;
+            }
+            dict_.append(QString::fromUtf8(p, qsizetype(len)));
+        } else {
+            header_.insert("status", a == 200 ? "success" : "error");
+            header_.insert("code", int(a));
+            header_.insert("message", QString::fromUtf8(p, qsizetype(len)));
+            complete_ = true;
+        }
+        return (p + len) - start;
+
+    case HistoryWire::TagRow:
+        if ((n = readVarint(p, end, len)) <= 0) break;
+        p += n;
+        if (len > quint64(end - p)) return 0;
+        if (!decodeRow(p, p + len)) {
+            if (error_.isEmpty())
+                error_ = QStringLiteral("레코드 형식이 올바르지 않습니다");
+            return -1;
+        }
+        return (p + len) - start;
+
+    default:
+        error_ = QStringLiteral("알 수 없는 항목: 0x%1").arg(tag, 2, 16, QLatin1Char('0'));
+        return -1;
+    }
+
+    if (n < 0) {
+        error_ = QStringLiteral("varint 길이 초과");
+        return -1;
+    }
+    return 0;
+}
+
+bool HistoryWireDecoder::readPath(const char *&p, const char *end, QString &out)
+{
+    quint64 dictId = 0;
+    if (!takeVarint(p, end, dictId) || dictId > quint64(dict_.size()))
+        return false;
+    QString suffix;
+    if (!takeString(p, end, suffix))
+        return false;
+    out = dictId ? dict_.at(qsizetype(dictId) - 1) + suffix : suffix;
+    return true;
+}
+
+bool HistoryWireDecoder::decodeRow(const char *p, const char *end)
+{
+    HistoryRecord rec;
+    quint64 v = 0;
+
+    if (!takeVarint(p, end, v)) return false;
+    prevId_ += unzigzag(v);
+    rec.id = int(prevId_);
+
+    if (end - p < 2) return false;
+    const quint8 type  = quint8(*p++);
+    const quint8 flags = quint8(*p++);
+    rec.eventType = (type == 0xFF) ? -1 : int(type);
+
+    if (flags & HistoryWire::HasTimestamp) {
+        if (!takeVarint(p, end, v)) return false;
+        prevTs_ += unzigzag(v);
+        rec.date = QDateTime::fromSecsSinceEpoch(prevTs_, QTimeZone::UTC)
+                       .toString("yyyy-MM-dd hh:mm:ss");
+    } else if (flags & HistoryWire::HasRawDate) {
+        if (!takeString(p, end, rec.date)) return false;
+    }
+
+    if (flags & HistoryWire::HasSpeed) {
+        if (!takeVarint(p, end, v)) return false;
+        rec.hasSpeed = true;
+        rec.speed    = double(v) / 100.0;
+    }
+
+    if (!readPath(p, end, rec.imagePath))     return false;
+    if (!readPath(p, end, rec.startSnapshot)) return false;
+    if (!readPath(p, end, rec.endSnapshot))   return false;
+    if (!takeString(p, end, rec.plateNumber)) return false;
+
+    rec.precompute();
+    pending_.append(rec);
+    ++recordCount_;
+    return true;
+}
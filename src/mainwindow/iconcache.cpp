@@ -0,0 +1,83 @@
+// iconcache.cpp
+#include "mainwindow/iconcache.h"
+#include <QHash>
+#include <QPixmapCache>
+#include <QStyle>
+#include <QVariant>
+#include <QWidget>
+
+namespace {
+
+QHash<QString, QPixmap> &originals()
+{
+    static QHash<QString, QPixmap> cache;
+    return cache;
+}
+
+QHash<QString, QIcon> &icons()
+{
+    static QHash<QString, QIcon> cache;
+    return cache;
+}
+
+} // namespace
+
+QPixmap IconCache::pixmap(const QString &path)
+{
+    QHash<QString, QPixmap> &cache = originals();
+    auto it = cache.constFind(path);
+    if (it == cache.constEnd())
+        it = cache.insert(path, QPixmap(path));
+    return it.value();
+}
+
+QPixmap IconCache::scaled(const QString &path, const QSize &size)
+{
+    QPixmap result;
+    if (size.isEmpty())
+        return result;
+
+    const QString key = QStringLiteral("quadqt:%1@%2x%3").arg(path).arg(size.width()).arg(size.height());
+    if (QPixmapCache::find(key, &result))
+        return result;
+
+    const QPixmap original = pixmap(path);
+    if (original.isNull())
+        return result;
+    result = original.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmapCache::insert(key, result);
+    return result;
+}
+
+QPixmap IconCache::scaledBy(const QString &path, qreal factor)
+{
+    const QPixmap original = pixmap(path);
+    if (original.isNull())
+        return original;
+    return scaled(path, QSize(int(original.width() * factor), int(original.height() * factor)));
+}
+
+QIcon IconCache::icon(const QString &path)
+{
+    QHash<QString, QIcon> &cache = icons();
+    auto it = cache.constFind(path);
+    if (it == cache.constEnd())
+        it = cache.insert(path, QIcon(path));
+    return it.value();
+}
+
+namespace StyleState {
+
+void set(QWidget *widget, const char *property, bool on)
+{
+    const QVariant current = widget->property(property);
+    if (current.isValid() && current.toBool() == on)
+        return;
+    widget->setProperty(property, on);
+    // 동적 속성 선택자는 polish 할 때만 다시 평가된다
+    widget->style()->unpolish(widget);
+    widget->style()->polish(widget);
+    widget->update();
+}
+
+} // namespace StyleState
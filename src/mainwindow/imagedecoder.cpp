@@ -0,0 +1,62 @@
+// imagedecoder.cpp
+#include "mainwindow/imagedecoder.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QtConcurrent>
+
+namespace ImageDecoder {
+
+QByteArray detectFormat(const QByteArray &data)
+{
+    const auto *p = reinterpret_cast<const uchar *>(data.constData());
+    const qsizetype n = data.size();
+
+    if (n >= 3 && p[0] == 0xFF && p[1] == 0xD8 && p[2] == 0xFF)
+        return "jpeg";
+    if (n >= 8 && data.startsWith("\x89PNG\r\n\x1a\n"))
+        return "png";
+    if (n >= 6 && (data.startsWith("GIF87a") || data.startsWith("GIF89a")))
+        return "gif";
+    if (n >= 12 && data.startsWith("RIFF") && data.mid(8, 4) == "WEBP")
+        return "webp";
+    if (n >= 2 && p[0] == 'B' && p[1] == 'M')
+        return "bmp";
+    return QByteArray();
+}
+
+QImage decodeScaled(const QByteArray &data, const QSize &target)
+{
+    const QByteArray format = detectFormat(data);
+    if (format.isEmpty())
+        return QImage();
+
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer, format);
+    reader.setDecideFormatFromContent(false);   // 이미 판별했으므로 다시 추측하지 않음
+
+    const QSize original = reader.size();
+    if (original.isValid() && target.isValid()) {
+        // 원본 비율 유지하며 target 에 맞춤 (기존 KeepAspectRatio 동작과 동일, 확대 포함)
+        reader.setScaledSize(original.scaled(target, Qt::KeepAspectRatio));
+        reader.setQuality(90);   // JPEG 축소 시 부드러운 보간 사용
+    }
+
+    QImage image = reader.read();
+    if (image.isNull())
+        return image;
+
+    // QPixmap 변환 시 추가 변환이 없도록 화면 기본 형식으로 맞춘다
+    image.convertTo(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                            : QImage::Format_RGB32);
+    return image;
+}
+
+QFuture<QImage> decodeScaledAsync(const QByteArray &data, const QSize &target)
+{
+    return QtConcurrent::run(&decodeScaled, data, target);
+}
+
+} // namespace ImageDecoder
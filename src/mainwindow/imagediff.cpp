@@ -0,0 +1,104 @@
+// imagediff.cpp
+#include "mainwindow/imagediff.h"
+#include "mainwindow/imagedecoder.h"
+#include <QtConcurrent>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// 비교는 이 크기 안에서 한다 (노이즈가 줄고 4K 원본도 수 ms 안에 끝남)
+constexpr int kWorkWidth   = 960;
+constexpr int kWorkHeight  = 540;
+constexpr int kThreshold   = 30;      // 회색조 차이 임계값 (0~255)
+constexpr double kMinArea  = 0.002;   // 이보다 작은 영역(전체 대비)은 노이즈로 보고 버림
+
+// RGB32 QImage 를 복사 없이 BGRA Mat 으로
+cv::Mat wrap(const QImage &image)
+{
+    return cv::Mat(image.height(), image.width(), CV_8UC4,
+                   const_cast<uchar *>(image.constBits()), size_t(image.bytesPerLine()));
+}
+
+} // namespace
+
+namespace ImageDiff {
+
+Result compare(const QByteArray &startData, const QByteArray &endData, const QSize &target)
+{
+    Result result;
+
+    QImage start = ImageDecoder::decodeScaled(startData, QSize(kWorkWidth, kWorkHeight));
+    if (start.isNull())
+        return result;
+    QImage end = ImageDecoder::decodeScaled(endData, start.size());
+    if (end.isNull())
+        return result;
+    start.convertTo(QImage::Format_RGB32);
+    end.convertTo(QImage::Format_RGB32);
+
+    const cv::Mat startMat = wrap(start);
+    cv::Mat endMat = wrap(end);
+    if (endMat.size() != startMat.size()) {
+        // 비율이 다른 경우에만 (카메라 설정 변경 등)
+        cv::Mat resized;
+        cv::resize(endMat, resized, startMat.size(), 0, 0, cv::INTER_AREA);
+        endMat = resized;
+    }
+
+    // 회색조 + 흐림으로 압축 노이즈/미세한 흔들림 제거 후 차이
+    cv::Mat grayStart, grayEnd, diff, mask;
+    cv::cvtColor(startMat, grayStart, cv::COLOR_BGRA2GRAY);
+    cv::cvtColor(endMat, grayEnd, cv::COLOR_BGRA2GRAY);
+    cv::GaussianBlur(grayStart, grayStart, cv::Size(5, 5), 0);
+    cv::GaussianBlur(grayEnd, grayEnd, cv::Size(5, 5), 0);
+    cv::absdiff(grayStart, grayEnd, diff);
+
+    // 끊어진 조각을 하나의 영역으로 묶는다
+    cv::threshold(diff, mask, kThreshold, 255, cv::THRESH_BINARY);
+    cv::morphologyEx(mask, mask, cv::MORPH_CLOSE,
+                     cv::getStructuringElement(cv::MORPH_RECT, cv::Size(9, 9)));
+    result.changedRatio = double(cv::countNonZero(mask)) / double(mask.total());
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    // 변한 곳에만 히트맵을 섞고 영역 상자 표시
+    cv::Mat heat, canvas, blended;
+    diff.convertTo(diff, -1, 3.0);   // 작은 차이도 색이 보이도록 증폭 (포화)
+    cv::applyColorMap(diff, heat, cv::COLORMAP_JET);
+    cv::cvtColor(endMat, canvas, cv::COLOR_BGRA2BGR);
+    cv::addWeighted(canvas, 0.5, heat, 0.5, 0.0, blended);
+    blended.copyTo(canvas, mask);
+
+    const double minArea = double(mask.total()) * kMinArea;
+    std::vector<cv::Rect> boxes;
+    for (const auto &contour : contours) {
+        const cv::Rect box = cv::boundingRect(contour);
+        if (box.area() >= minArea)
+            boxes.push_back(box);
+    }
+    for (const cv::Rect &box : boxes)
+        cv::rectangle(canvas, box, cv::Scalar(0, 0, 255), 3);
+
+    // scaled() 가 새 버퍼를 만들므로 Mat 이 사라져도 안전
+    const QImage view(canvas.data, canvas.cols, canvas.rows, int(canvas.step), QImage::Format_BGR888);
+    result.image = target.isValid()
+                       ? view.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+                       : view.copy();
+    result.image.convertTo(QImage::Format_RGB32);
+
+    const double sx = double(result.image.width()) / canvas.cols;
+    const double sy = double(result.image.height()) / canvas.rows;
+    for (const cv::Rect &box : boxes)
+        result.regions.append(QRect(qRound(box.x * sx), qRound(box.y * sy),
+                                    qRound(box.width * sx), qRound(box.height * sy)));
+    return result;
+}
+
+QFuture<Result> compareAsync(const QByteArray &startData, const QByteArray &endData, const QSize &target)
+{
+    return QtConcurrent::run(&compare, startData, endData, target);
+}
+
+} // namespace ImageDiff
@@ -0,0 +1,296 @@
+// imagefetchpool.cpp
+#include "mainwindow/imagefetchpool.h"
+#include "mainwindow/tlscontext.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/logging.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QtEndian>
+#include <utility>
+
+namespace {
+
+constexpr int kMaxAttempts        = 3;    // 경로별 최대 요청 횟수
+constexpr int kMaxConnectFailures = 3;    // 연속 연결 실패 시 남은 요청 모두 실패 처리
+constexpr int kReconnectDelayMs   = 300;
+constexpr int kSizeHeaderBytes    = 8;    // GET_IMAGE 응답: u64 big-endian 크기 + 데이터
+
+QString serverMessage(const QByteArray &json)
+{
+    const QString msg = QJsonDocument::fromJson(json).object().value("message").toString();
+    return msg.isEmpty() ? QStringLiteral("Unknown server error") : msg;
+}
+
+} // namespace
+
+ImageFetchPool::ImageFetchPool(QObject *parent)
+    : QObject(parent)
+{
+}
+
+ImageFetchPool::~ImageFetchPool()
+{
+    cancel();
+}
+
+void ImageFetchPool::setServer(const QString &host, quint16 port)
+{
+    host_ = host;
+    port_ = port;
+}
+
+void ImageFetchPool::setConcurrency(int connections, int pipelineDepth)
+{
+    maxConnections_ = qMax(1, connections);
+    pipelineDepth_  = qMax(1, pipelineDepth);
+}
+
+void ImageFetchPool::fetch(const QStringList &paths)
+{
+    if (paths.isEmpty())
+        return;
+    if (!active_) {
+        elapsed_.start();
+        fetched_ = 0;
+        connectFailures_ = 0;
+    }
+    active_ = true;
+    for (const QString &path : paths)
+        queue_.enqueue(path);
+
+    for (Connection *conn : std::as_const(connections_))
+        pump(conn);
+    openConnections();
+}
+
+void ImageFetchPool::pause()
+{
+    paused_ = true;
+}
+
+void ImageFetchPool::resume()
+{
+    if (!paused_)
+        return;
+    paused_ = false;
+    for (Connection *conn : std::as_const(connections_))
+        pump(conn);
+    openConnections();
+}
+
+void ImageFetchPool::cancel()
+{
+    queue_.clear();
+    attempts_.clear();
+    active_ = false;
+
+    const QList<Connection*> dead = std::exchange(connections_, {});
+    for (Connection *conn : dead) {
+        conn->socket->disconnect(this);
+        conn->socket->abort();
+        conn->socket->deleteLater();
+    }
+    // 시그널 처리 도중 취소될 수 있으므로 구조체 해제는 이벤트 루프로 미룬다
+    if (!dead.isEmpty())
+        QMetaObject::invokeMethod(this, [dead]() { qDeleteAll(dead); }, Qt::QueuedConnection);
+}
+
+bool ImageFetchPool::isIdle() const
+{
+    if (!queue_.isEmpty())
+        return false;
+    for (const Connection *conn : connections_) {
+        if (!conn->inFlight.isEmpty())
+            return false;
+    }
+    return true;
+}
+
+double ImageFetchPool::imagesPerSecond() const
+{
+    if (!elapsed_.isValid())
+        return 0.0;
+    return fetched_ * 1000.0 / qMax<qint64>(1, elapsed_.elapsed());
+}
+
+void ImageFetchPool::openConnections()
+{
+    if (paused_ || queue_.isEmpty())
+        return;
+    // 큐를 파이프라인 깊이로 나눈 만큼만 연결 (최대 maxConnections_)
+    const qsizetype wanted = qMin<qsizetype>(maxConnections_,
+                                             (queue_.size() + pipelineDepth_ - 1) / pipelineDepth_);
+    while (connections_.size() < wanted)
+        openConnection();
+}
+
+void ImageFetchPool::openConnection()
+{
+    auto *conn = new Connection;
+    conn->socket = new QSslSocket(this);
+    conn->socket->setSslConfiguration(TlsContext::clientConfiguration());
+
+    connect(conn->socket, &QSslSocket::encrypted, this, [this, conn]() {
+        conn->ready = true;
+        connectFailures_ = 0;
+        MetricsRegistry::finish(MetricsRegistry::TlsHandshake, std::exchange(conn->handshakeStartUs, 0));
+        pump(conn);
+    });
+    connect(conn->socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
+            this, [conn](const QList<QSslError> &) {
+                // TcpImageHandler 와 동일하게 자체 서명 인증서 허용
+                conn->socket->ignoreSslErrors();
+            });
+    connect(conn->socket, &QSslSocket::readyRead, this, [this, conn]() { onReadyRead(conn); });
+    connect(conn->socket, &QAbstractSocket::stateChanged, this,
+            [this, conn](QAbstractSocket::SocketState state) {
+                if (state == QAbstractSocket::ConnectedState)
+                    conn->handshakeStartUs = MetricsRegistry::start();
+                else if (state == QAbstractSocket::UnconnectedState)
+                    onClosed(conn);
+            });
+
+    connections_.append(conn);
+    conn->socket->connectToHostEncrypted(host_, port_);
+}
+
+void ImageFetchPool::pump(Connection *conn)
+{
+    if (!conn->ready || paused_)
+        return;
+
+    QByteArray out;
+    while (conn->inFlight.size() < pipelineDepth_ && !queue_.isEmpty()) {
+        const QString path = queue_.dequeue();
+        conn->inFlight.enqueue(path);
+        out += "GET_IMAGE " + path.toUtf8() + "\n";
+    }
+    if (!out.isEmpty())
+        conn->socket->write(out);
+}
+
+void ImageFetchPool::onReadyRead(Connection *conn)
+{
+    conn->buffer.append(conn->socket->readAll());
+
+    while (!conn->inFlight.isEmpty()) {
+        if (!conn->headerParsed) {
+            if (conn->buffer.isEmpty())
+                break;
+            if (conn->buffer.startsWith('{')) {
+                // 오류 응답 (JSON 한 줄). 줄 끝이 없으면 연결 종료 시 처리
+                const qsizetype nl = conn->buffer.indexOf('\n');
+                if (nl < 0)
+                    break;
+                const QString msg = serverMessage(conn->buffer.left(nl));
+                conn->buffer.remove(0, nl + 1);
+                ++conn->served;
+                emit imageFailed(conn->inFlight.dequeue(), msg);
+                if (!connections_.contains(conn))
+                    return;   // 슬롯에서 취소됨
+                continue;
+            }
+            if (conn->buffer.size() < kSizeHeaderBytes)
+                break;
+            conn->expected = qFromBigEndian<quint64>(conn->buffer.constData());
+            conn->buffer.remove(0, kSizeHeaderBytes);
+            conn->headerParsed = true;
+        }
+
+        if (quint64(conn->buffer.size()) < conn->expected)
+            break;
+
+        const QByteArray data = conn->buffer.left(qsizetype(conn->expected));
+        conn->buffer.remove(0, qsizetype(conn->expected));
+        conn->headerParsed = false;
+        ++conn->served;
+        ++fetched_;
+        emit imageFetched(conn->inFlight.dequeue(), data);
+        if (!connections_.contains(conn))
+            return;
+    }
+
+    pump(conn);
+    checkFinished();
+}
+
+void ImageFetchPool::onClosed(Connection *conn)
+{
+    if (!connections_.contains(conn))
+        return;
+
+    // 실패 알림은 연결을 정리한 뒤에 보낸다. 슬롯에서 cancel() 을 불러도
+    // 이미 목록에서 빠진 연결을 다시 해제하지 않는다
+    QList<std::pair<QString, QString>> failures;
+
+    // 구형 서버는 오류 JSON 을 보내고 줄바꿈 없이 연결을 끊는다
+    if (!conn->headerParsed && conn->buffer.startsWith('{') && !conn->inFlight.isEmpty()) {
+        failures.append({conn->inFlight.dequeue(), serverMessage(conn->buffer)});
+        conn->buffer.clear();
+    }
+    if (!conn->ready)
+        ++connectFailures_;
+    // 응답 하나 뒤에 연결을 끊는 서버는 파이프라이닝을 지원하지 않는 것으로 본다
+    if (conn->served > 0 && !conn->inFlight.isEmpty() && pipelineDepth_ > 1) {
+        qCDebug(lcImage) << "서버가 파이프라이닝을 지원하지 않아 요청을 하나씩 보냅니다";
+        pipelineDepth_ = 1;
+    }
+
+    const QString reason = conn->socket->errorString();
+    const bool served = conn->served > 0;
+    release(conn);      // 구조체 해제는 이벤트 루프로 미뤄져 아래에서 읽어도 된다
+    for (const QString &path : requeue(conn))
+        failures.append({path, reason});
+
+    if (connectFailures_ >= kMaxConnectFailures) {
+        qCWarning(lcImage) << "서버에 연결할 수 없습니다:" << host_ << port_;
+        const QQueue<QString> failed = std::exchange(queue_, {});
+        for (const QString &path : failed)
+            failures.append({path, QStringLiteral("서버에 연결할 수 없습니다")});
+    } else if (!queue_.isEmpty()) {
+        // 정상적으로 응답한 뒤 끊긴 연결은 바로 다시 연다
+        QTimer::singleShot(served ? 0 : kReconnectDelayMs,
+                           this, &ImageFetchPool::openConnections);
+    }
+
+    for (const auto &[path, error] : std::as_const(failures)) {
+        emit imageFailed(path, error);
+        if (!active_)
+            return;     // 슬롯에서 취소됨
+    }
+    checkFinished();
+}
+
+QStringList ImageFetchPool::requeue(Connection *conn)
+{
+    // 보낸 순서를 유지하도록 뒤에서부터 큐 앞에 되돌린다.
+    // 응답을 하나라도 받은 연결이면 요청 자체의 문제가 아니므로 재시도 횟수에 넣지 않는다.
+    // 재시도 횟수를 넘긴 경로는 돌려준다 (호출한 쪽이 실패를 알림)
+    QStringList exhausted;
+    for (qsizetype i = conn->inFlight.size() - 1; i >= 0; --i) {
+        const QString &path = conn->inFlight.at(i);
+        if (conn->served == 0 && ++attempts_[path] >= kMaxAttempts)
+            exhausted.prepend(path);
+        else
+            queue_.prepend(path);
+    }
+    conn->inFlight.clear();
+    return exhausted;
+}
+
+void ImageFetchPool::release(Connection *conn)
+{
+    connections_.removeOne(conn);
+    conn->socket->disconnect(this);
+    conn->socket->deleteLater();
+    QMetaObject::invokeMethod(this, [conn]() { delete conn; }, Qt::QueuedConnection);
+}
+
+void ImageFetchPool::checkFinished()
+{
+    if (active_ && isIdle()) {
+        active_ = false;
+        emit finished();
+    }
+}
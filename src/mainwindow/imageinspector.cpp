@@ -0,0 +1,323 @@
+// imageinspector.cpp
+#include "mainwindow/imageinspector.h"
+#include "mainwindow/imagedecoder.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QtConcurrent>
+#include <cmath>
+
+namespace {
+
+constexpr double kMaxScale  = 16.0;
+constexpr double kZoomStep  = 1.25;
+
+// src 를 1/2 씩 count 번 줄인 단계들 (작업 스레드에서 실행)
+QList<QImage> buildLevels(QImage src, int count)
+{
+    QList<QImage> out;
+    out.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        src = src.scaled(qMax(1, src.width() / 2), qMax(1, src.height() / 2),
+                         Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        out.append(src);
+    }
+    return out;
+}
+
+} // namespace
+
+ImageInspector::ImageInspector(QWidget *parent)
+    : QWidget(parent),
+    tiles_(96 * 1024)   // KB 단위, 타일 약 380개
+{
+    setFocusPolicy(Qt::StrongFocus);
+    setMouseTracking(false);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(320, 240);
+}
+
+void ImageInspector::clear()
+{
+    ++seq_;
+    levels_.clear();
+    tiles_.clear();
+    loading_  = false;
+    failed_   = false;
+    building_ = false;
+    update();
+}
+
+void ImageInspector::setImageData(const QByteArray &data)
+{
+    clear();
+    if (data.isEmpty()) {
+        failed_ = true;
+        return;
+    }
+
+    loading_ = true;
+    const int seq = seq_;
+    // 크기를 지정하지 않으면 원본 해상도로 디코딩
+    ImageDecoder::decodeScaledAsync(data, QSize())
+        .then(this, [this, seq](const QImage &image) {
+            if (seq != seq_) return;   // 그 사이 새 이미지가 들어옴
+            loading_ = false;
+            if (image.isNull()) {
+                failed_ = true;
+                update();
+                return;
+            }
+
+            // 긴 변이 타일 하나에 들어갈 때까지 단계 수 계산 (0단계만 준비됨)
+            int count = 1;
+            for (int side = qMax(image.width(), image.height()); side > TileSize; side /= 2)
+                ++count;
+            levels_.fill(QImage(), count);
+            levels_[0] = image;
+
+            fitToWindow();
+        });
+}
+
+void ImageInspector::fitToWindow()
+{
+    const QSize size = imageSize();
+    if (size.isEmpty()) return;
+
+    fitScale_ = qMin(double(width()) / size.width(), double(height()) / size.height());
+    scale_    = fitScale_;
+    fitted_   = true;
+    clampOrigin();
+    update();
+}
+
+void ImageInspector::zoomTo(double scale, const QPointF &anchor)
+{
+    if (imageSize().isEmpty()) return;
+
+    // anchor 아래의 원본 좌표가 그대로 유지되도록 origin 이동
+    const QPointF fixed = origin_ + anchor / scale_;
+    scale_  = qBound(qMin(fitScale_, 1.0), scale, kMaxScale);
+    origin_ = fixed - anchor / scale_;
+    fitted_ = false;
+    clampOrigin();
+    update();
+}
+
+void ImageInspector::clampOrigin()
+{
+    const QSize size = imageSize();
+    if (size.isEmpty()) return;
+
+    // 보이는 영역이 이미지보다 크면 가운데, 아니면 이미지 밖으로 나가지 않게
+    const double viewW = width() / scale_;
+    const double viewH = height() / scale_;
+    origin_.setX(viewW >= size.width()  ? (size.width()  - viewW) / 2
+                                        : qBound(0.0, origin_.x(), size.width()  - viewW));
+    origin_.setY(viewH >= size.height() ? (size.height() - viewH) / 2
+                                        : qBound(0.0, origin_.y(), size.height() - viewH));
+}
+
+int ImageInspector::levelForScale(double scale) const
+{
+    // 축소 배율 2^n 이 1/scale 을 넘지 않는 가장 작은 단계 (화면보다 거친 단계는 쓰지 않음)
+    if (scale >= 1.0 || levels_.isEmpty())
+        return 0;
+    const int level = int(std::floor(std::log2(1.0 / scale)));
+    return qBound(0, level, int(levels_.size()) - 1);
+}
+
+int ImageInspector::readyLevelNear(int level) const
+{
+    // 원하는 단계가 아직 없으면 가까운 더 거친 단계, 그것도 없으면 더 고운 단계 (0단계는 항상 있음)
+    for (int l = level; l < levels_.size(); ++l)
+        if (!levels_.at(l).isNull())
+            return l;
+    for (int l = level - 1; l > 0; --l)
+        if (!levels_.at(l).isNull())
+            return l;
+    return 0;
+}
+
+void ImageInspector::requestLevel(int level)
+{
+    if (building_ || !levels_.at(level).isNull())
+        return;
+
+    // 가장 가까운 더 고운 단계에서 필요한 단계까지 한 번에 만든다
+    int source = level - 1;
+    while (levels_.at(source).isNull())
+        --source;
+
+    building_ = true;
+    const int seq = seq_;
+    QtConcurrent::run(&buildLevels, levels_.at(source), level - source)
+        .then(this, [this, seq, source](const QList<QImage> &built) {
+            if (seq != seq_) return;
+            building_ = false;
+            for (int i = 0; i < built.size(); ++i)
+                levels_[source + 1 + i] = built.at(i);
+            update();
+        });
+}
+
+QPixmap ImageInspector::tile(int level, int tx, int ty)
+{
+    const quint64 key = (quint64(level) << 48) | (quint64(ty) << 24) | quint64(tx);
+    if (QPixmap *cached = tiles_.object(key))
+        return *cached;
+
+    const QImage &image = levels_.at(level);
+    const QRect rect = QRect(tx * TileSize, ty * TileSize, TileSize, TileSize) & image.rect();
+    auto *pixmap = new QPixmap(QPixmap::fromImage(image.copy(rect)));
+    const QPixmap result = *pixmap;
+    tiles_.insert(key, pixmap, qMax(1, rect.width() * rect.height() * 4 / 1024));
+    return result;
+}
+
+void ImageInspector::drawLevel(QPainter &painter, int level)
+{
+    const QImage &image = levels_.at(level);
+    const double factor = double(1 << level);   // 이 단계 1px = 원본 factor px
+    const double k = scale_ * factor;           // 이 단계 1px = 화면 k px
+
+    // 보이는 영역을 이 단계 좌표로
+    const QRectF visible = QRectF(origin_ / factor, QSizeF(width(), height()) / k)
+                               .intersected(QRectF(image.rect()));
+    if (visible.isEmpty()) return;
+
+    // 크게 확대했을 때는 번호판 글자 픽셀이 보이도록 보간하지 않는다
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, k < 4.0);
+
+    const int tx0 = int(visible.left()) / TileSize;
+    const int ty0 = int(visible.top()) / TileSize;
+    const int tx1 = int(std::ceil(visible.right())) / TileSize;
+    const int ty1 = int(std::ceil(visible.bottom())) / TileSize;
+
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const QRect rect = QRect(tx * TileSize, ty * TileSize, TileSize, TileSize) & image.rect();
+            if (rect.isEmpty()) continue;
+            const QRectF target((rect.x() * factor - origin_.x()) * scale_,
+                                (rect.y() * factor - origin_.y()) * scale_,
+                                rect.width() * k, rect.height() * k);
+            const QPixmap pixmap = tile(level, tx, ty);
+            painter.drawPixmap(target, pixmap, QRectF(pixmap.rect()));
+        }
+    }
+}
+
+void ImageInspector::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#222"));
+
+    if (levels_.isEmpty()) {
+        painter.setPen(QColor("#aaa"));
+        painter.drawText(rect(), Qt::AlignCenter,
+                         loading_ ? "불러오는 중..." : failed_ ? "이미지 없음" : QString());
+        return;
+    }
+
+    const int wanted = levelForScale(scale_);
+    if (levels_.at(wanted).isNull())
+        requestLevel(wanted);
+    drawLevel(painter, readyLevelNear(wanted));
+
+    // 배율 표시
+    const QString zoomText = QString("%1%  (%2 x %3)")
+                                 .arg(qRound(scale_ * 100))
+                                 .arg(imageSize().width())
+                                 .arg(imageSize().height());
+    const QRect textRect(8, height() - 28, 200, 20);
+    painter.fillRect(textRect, QColor(0, 0, 0, 140));
+    painter.setPen(Qt::white);
+    painter.drawText(textRect, Qt::AlignCenter, zoomText);
+}
+
+void ImageInspector::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    if (fitted_)
+        fitToWindow();
+    else
+        clampOrigin();
+}
+
+void ImageInspector::wheelEvent(QWheelEvent *event)
+{
+    const double steps = event->angleDelta().y() / 120.0;
+    if (steps == 0) return;
+    zoomTo(scale_ * std::pow(kZoomStep, steps), event->position());
+    event->accept();
+}
+
+void ImageInspector::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        panning_ = true;
+        lastMousePos_ = event->pos();
+        setCursor(Qt::ClosedHandCursor);
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void ImageInspector::mouseMoveEvent(QMouseEvent *event)
+{
+    if (panning_) {
+        const QPoint delta = event->pos() - lastMousePos_;
+        lastMousePos_ = event->pos();
+        origin_ -= QPointF(delta) / scale_;
+        fitted_ = false;
+        clampOrigin();
+        update();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void ImageInspector::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        panning_ = false;
+        unsetCursor();
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void ImageInspector::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    // 맞춤 상태면 클릭 위치를 원본 크기로, 아니면 다시 맞춤
+    if (fitted_)
+        zoomTo(1.0, event->position());
+    else
+        fitToWindow();
+}
+
+void ImageInspector::keyPressEvent(QKeyEvent *event)
+{
+    const QPointF center(width() / 2.0, height() / 2.0);
+    switch (event->key()) {
+    case Qt::Key_Plus:
+    case Qt::Key_Equal:
+        zoomTo(scale_ * kZoomStep, center);
+        break;
+    case Qt::Key_Minus:
+        zoomTo(scale_ / kZoomStep, center);
+        break;
+    case Qt::Key_0:
+        fitToWindow();
+        break;
+    case Qt::Key_1:
+        zoomTo(1.0, center);
+        break;
+    case Qt::Key_Escape:
+        if (isWindow()) close();
+        break;
+    default:
+        QWidget::keyPressEvent(event);
+    }
+}
@@ -0,0 +1,118 @@
+// latencypanel.cpp
+#include "mainwindow/latencypanel.h"
+#include "mainwindow/latencytracker.h"
+#include <QDateTime>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+namespace {
+
+enum Column { StageColumn, CountColumn, P50Column, P95Column, P99Column, MaxColumn, ColumnCount };
+
+QString formatMs(double ms)
+{
+    return ms < 10.0 ? QString::number(ms, 'f', 2) : QString::number(ms, 'f', 0);
+}
+
+} // namespace
+
+LatencyPanel::LatencyPanel(QWidget *parent)
+    : QWidget(parent)
+{
+    this->setStyleSheet("background-color: #FFFFFF;");
+
+    auto *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(12, 12, 12, 12);
+    layout->setSpacing(8);
+
+    auto *title = new QLabel("구간별 지연 (최근 1분, ms)", this);
+    title->setStyleSheet("font-weight: bold; font-size: 14px;");
+    layout->addWidget(title);
+
+    table_ = new QTableWidget(LatencyTracker::StageCount, ColumnCount, this);
+    table_->setHorizontalHeaderLabels({"구간", "건수", "p50", "p95", "p99", "최대"});
+    table_->verticalHeader()->setVisible(false);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setSelectionMode(QAbstractItemView::NoSelection);
+    table_->setFocusPolicy(Qt::NoFocus);
+    table_->horizontalHeader()->setSectionResizeMode(StageColumn, QHeaderView::Stretch);
+    for (int c = CountColumn; c < ColumnCount; ++c)
+        table_->horizontalHeader()->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+
+    for (int row = 0; row < LatencyTracker::StageCount; ++row) {
+        table_->setItem(row, StageColumn,
+                        new QTableWidgetItem(LatencyTracker::stageLabel(LatencyTracker::Stage(row))));
+        for (int c = CountColumn; c < ColumnCount; ++c) {
+            auto *item = new QTableWidgetItem("-");
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            table_->setItem(row, c, item);
+        }
+    }
+    layout->addWidget(table_, 1);
+
+    auto *buttons = new QHBoxLayout;
+    buttons->addStretch();
+    auto *resetButton  = new QPushButton("초기화", this);
+    auto *exportButton = new QPushButton("JSON 내보내기", this);
+    buttons->addWidget(resetButton);
+    buttons->addWidget(exportButton);
+    layout->addLayout(buttons);
+
+    connect(resetButton, &QPushButton::clicked, this, &LatencyPanel::resetStats);
+    connect(exportButton, &QPushButton::clicked, this, &LatencyPanel::exportJson);
+
+    refreshTimer_.setInterval(RefreshIntervalMs);
+    connect(&refreshTimer_, &QTimer::timeout, this, &LatencyPanel::refresh);
+}
+
+void LatencyPanel::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refresh();
+    refreshTimer_.start();
+}
+
+void LatencyPanel::hideEvent(QHideEvent *event)
+{
+    refreshTimer_.stop();
+    QWidget::hideEvent(event);
+}
+
+void LatencyPanel::refresh()
+{
+    LatencyTracker &tracker = LatencyTracker::instance();
+    for (int row = 0; row < LatencyTracker::StageCount; ++row) {
+        const LatencyHistogram::Summary s = tracker.summary(LatencyTracker::Stage(row));
+        const bool empty = s.count == 0;
+        table_->item(row, CountColumn)->setText(QString::number(s.count));
+        table_->item(row, P50Column)->setText(empty ? "-" : formatMs(s.p50Ms));
+        table_->item(row, P95Column)->setText(empty ? "-" : formatMs(s.p95Ms));
+        table_->item(row, P99Column)->setText(empty ? "-" : formatMs(s.p99Ms));
+        table_->item(row, MaxColumn)->setText(empty ? "-" : formatMs(s.maxMs));
+    }
+}
+
+void LatencyPanel::exportJson()
+{
+    const QString suggested = QString("latency_%1.json")
+                                  .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+    const QString path = QFileDialog::getSaveFileName(this, tr("지연 측정값 저장"), suggested,
+                                                      tr("JSON Files (*.json)"));
+    if (path.isEmpty()) return;
+
+    QString error;
+    if (!LatencyTracker::instance().exportJson(path, &error))
+        QMessageBox::warning(this, tr("지연 측정"), tr("저장하지 못했습니다: %1").arg(error));
+}
+
+void LatencyPanel::resetStats()
+{
+    LatencyTracker::instance().reset();
+    refresh();
+}
@@ -0,0 +1,255 @@
+// latencytracker.cpp
+#include "mainwindow/latencytracker.h"
+#include "mainwindow/metricsregistry.h"
+#include <QDateTime>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QWidget>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double FirstBucketMs = 0.05;
+constexpr double BucketRatio   = 1.1;
+
+const std::array<double, LatencyHistogram::BucketCount> &bucketBounds()
+{
+    static const auto bounds = [] {
+        std::array<double, LatencyHistogram::BucketCount> b{};
+        double upper = FirstBucketMs;
+        for (double &v : b) {
+            v = upper;
+            upper *= BucketRatio;
+        }
+        return b;
+    }();
+    return bounds;
+}
+
+} // namespace
+
+// ===== LatencyHistogram =====
+
+double LatencyHistogram::bucketUpperMs(int index)
+{
+    return bucketBounds()[std::clamp(index, 0, BucketCount - 1)];
+}
+
+int LatencyHistogram::bucketFor(double ms)
+{
+    const auto &bounds = bucketBounds();
+    const auto it = std::lower_bound(bounds.begin(), bounds.end(), ms);
+    return it == bounds.end() ? BucketCount - 1 : int(it - bounds.begin());
+}
+
+void LatencyHistogram::advance(qint64 nowMs)
+{
+    const qint64 slot = nowMs / SlotMs;
+    if (slot == current_)
+        return;
+
+    // 건너뛴 칸은 비운다 (창 전체를 넘었으면 모두)
+    if (current_ < 0 || slot - current_ >= SlotCount || slot < current_) {
+        clear();
+    } else {
+        for (qint64 s = current_ + 1; s <= slot; ++s)
+            slots_[s % SlotCount] = Slot{};
+    }
+    current_ = slot;
+}
+
+void LatencyHistogram::add(double ms, qint64 nowMs)
+{
+    if (!std::isfinite(ms))
+        return;
+    ms = std::max(ms, 0.0);
+
+    advance(nowMs);
+    Slot &slot = slots_[current_ % SlotCount];
+    ++slot.counts[bucketFor(ms)];
+    ++slot.total;
+    slot.sum += ms;
+    slot.max  = std::max(slot.max, ms);
+}
+
+void LatencyHistogram::clear()
+{
+    slots_.fill(Slot{});
+    current_ = -1;
+}
+
+std::array<quint64, LatencyHistogram::BucketCount> LatencyHistogram::buckets(qint64 nowMs)
+{
+    advance(nowMs);
+    std::array<quint64, BucketCount> merged{};
+    for (const Slot &slot : slots_) {
+        for (int i = 0; i < BucketCount; ++i)
+            merged[i] += slot.counts[i];
+    }
+    return merged;
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary(qint64 nowMs)
+{
+    const auto merged = buckets(nowMs);
+
+    Summary s;
+    double sum = 0;
+    for (const Slot &slot : slots_) {
+        s.count += slot.total;
+        sum     += slot.sum;
+        s.maxMs  = std::max(s.maxMs, slot.max);
+    }
+    if (s.count == 0)
+        return s;
+    s.meanMs = sum / double(s.count);
+
+    // 누적 건수가 순위를 넘는 버킷의 상한 (실제 최대값을 넘지 않게)
+    const auto percentile = [&](double p) {
+        const quint64 rank = std::max<quint64>(1, quint64(std::ceil(p * double(s.count))));
+        quint64 seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += merged[i];
+            if (seen >= rank)
+                return std::min(bucketUpperMs(i), s.maxMs);
+        }
+        return s.maxMs;
+    };
+    s.p50Ms = percentile(0.50);
+    s.p95Ms = percentile(0.95);
+    s.p99Ms = percentile(0.99);
+    return s;
+}
+
+// ===== LatencyTracker =====
+
+LatencyTracker &LatencyTracker::instance()
+{
+    static LatencyTracker tracker;
+    return tracker;
+}
+
+qint64 LatencyTracker::nowUs()
+{
+    // 진단 지표와 같은 시계를 써야 한 경로에서 두 값을 섞어도 어긋나지 않는다
+    return MetricsRegistry::nowUs();
+}
+
+void LatencyTracker::record(Stage stage, double ms)
+{
+    if (stage < 0 || stage >= StageCount)
+        return;
+    stages_[stage].add(ms, QDateTime::currentMSecsSinceEpoch());
+}
+
+LatencyHistogram::Summary LatencyTracker::summary(Stage stage)
+{
+    if (stage < 0 || stage >= StageCount)
+        return {};
+    return stages_[stage].summary(QDateTime::currentMSecsSinceEpoch());
+}
+
+void LatencyTracker::reset()
+{
+    for (LatencyHistogram &h : stages_)
+        h.clear();
+}
+
+QString LatencyTracker::stageName(Stage stage)
+{
+    switch (stage) {
+    case MqttPublishToReceive:    return QStringLiteral("mqtt.publish_to_receive");
+    case MqttReceiveToPaint:      return QStringLiteral("mqtt.receive_to_paint");
+    case MqttEndToEnd:            return QStringLiteral("mqtt.end_to_end");
+    case RtspCaptureToFrameReady: return QStringLiteral("rtsp.capture_to_frame_ready");
+    case RtspFrameReadyToPaint:   return QStringLiteral("rtsp.frame_ready_to_paint");
+    case RtspEndToEnd:            return QStringLiteral("rtsp.end_to_end");
+    default:                      return QString();
+    }
+}
+
+QString LatencyTracker::stageLabel(Stage stage)
+{
+    switch (stage) {
+    case MqttPublishToReceive:    return QStringLiteral("알림 발생 → 수신");
+    case MqttReceiveToPaint:      return QStringLiteral("알림 수신 → 표시");
+    case MqttEndToEnd:            return QStringLiteral("알림 발생 → 표시");
+    case RtspCaptureToFrameReady: return QStringLiteral("영상 수신 → frameReady");
+    case RtspFrameReadyToPaint:   return QStringLiteral("frameReady → 표시");
+    case RtspEndToEnd:            return QStringLiteral("영상 수신 → 표시");
+    default:                      return QString();
+    }
+}
+
+QJsonObject LatencyTracker::toJson()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QJsonArray stages;
+    for (int i = 0; i < StageCount; ++i) {
+        LatencyHistogram &h = stages_[i];
+        const LatencyHistogram::Summary s = h.summary(now);
+        const auto counts = h.buckets(now);
+
+        // 비어 있지 않은 버킷만 (상한 ms, 건수)
+        QJsonArray buckets;
+        for (int b = 0; b < LatencyHistogram::BucketCount; ++b) {
+            if (counts[b] == 0)
+                continue;
+            buckets.append(QJsonObject{
+                {"leMs",  LatencyHistogram::bucketUpperMs(b)},
+                {"count", double(counts[b])},
+            });
+        }
+
+        stages.append(QJsonObject{
+            {"name",    stageName(Stage(i))},
+            {"count",   double(s.count)},
+            {"meanMs",  s.meanMs},
+            {"p50Ms",   s.p50Ms},
+            {"p95Ms",   s.p95Ms},
+            {"p99Ms",   s.p99Ms},
+            {"maxMs",   s.maxMs},
+            {"buckets", buckets},
+        });
+    }
+
+    return QJsonObject{
+        {"generatedAt",   QDateTime::fromMSecsSinceEpoch(now).toString(Qt::ISODateWithMs)},
+        {"windowSeconds", int(LatencyHistogram::SlotCount * LatencyHistogram::SlotMs / 1000)},
+        {"stages",        stages},
+    };
+}
+
+bool LatencyTracker::exportJson(const QString &path, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    const QByteArray json = QJsonDocument(toJson()).toJson(QJsonDocument::Indented);
+    if (file.write(json) != json.size()) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// ===== PaintProbe =====
+
+PaintProbe::PaintProbe(QWidget *target, std::function<void()> onPaint)
+    : QObject(target), onPaint_(std::move(onPaint))
+{
+    target->installEventFilter(this);
+}
+
+bool PaintProbe::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint && onPaint_)
+        onPaint_();
+    return QObject::eventFilter(watched, event);
+}
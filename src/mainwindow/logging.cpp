@@ -0,0 +1,335 @@
+// logging.cpp
+#include "mainwindow/logging.h"
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+Q_LOGGING_CATEGORY(lcTcp,     "quadqt.tcp")
+Q_LOGGING_CATEGORY(lcImage,   "quadqt.image")
+Q_LOGGING_CATEGORY(lcHistory, "quadqt.history")
+Q_LOGGING_CATEGORY(lcMqtt,    "quadqt.mqtt")
+Q_LOGGING_CATEGORY(lcRtsp,    "quadqt.rtsp")
+Q_LOGGING_CATEGORY(lcConfig,  "quadqt.config")
+Q_LOGGING_CATEGORY(lcUi,      "quadqt.ui")
+Q_LOGGING_CATEGORY(lcStartup, "quadqt.startup")
+
+namespace {
+
+constexpr int    FlushIntervalMs  = 100;   // 쓰기 스레드가 깨어나는 주기
+constexpr int    SweepIntervalMs  = 1000;  // 생략 건수 보고 주기
+constexpr qint64 RateIdleSeconds  = 60;    // 이 시간 동안 조용한 위치는 잊는다
+
+struct LogEntry
+{
+    qint64     timeMs = 0;
+    QtMsgType  type = QtDebugMsg;
+    QByteArray category;
+    QString    message;
+    quintptr   threadId = 0;
+};
+
+/// 메시지 위치(파일:줄 또는 분류+앞부분)별 초당 건수
+struct RateState
+{
+    qint64     second = 0;
+    int        count = 0;
+    int        suppressed = 0;
+    QtMsgType  type = QtDebugMsg;
+    QByteArray category;
+    QString    sample;      // 생략 보고에 붙일 메시지 앞부분
+};
+
+class AsyncLogSink;
+
+class LogWriterThread : public QThread
+{
+public:
+    explicit LogWriterThread(AsyncLogSink *sink) : sink_(sink) {}
+
+protected:
+    void run() override;
+
+private:
+    AsyncLogSink *sink_;
+};
+
+class AsyncLogSink
+{
+public:
+    explicit AsyncLogSink(const QString &filePath)
+        : ring_(Logging::RingCapacity), writer_(this)
+    {
+        if (!filePath.isEmpty()) {
+            file_.setFileName(filePath);
+            if (!file_.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+                std::fprintf(stderr, "log file open failed: %s\n", qPrintable(filePath));
+        }
+        writer_.setObjectName(QStringLiteral("LogWriter"));
+        writer_.start(QThread::LowPriority);
+    }
+
+    ~AsyncLogSink()
+    {
+        {
+            QMutexLocker lock(&mutex_);
+            stopping_ = true;
+        }
+        wake_.wakeAll();
+        writer_.wait();
+        flushNow();
+    }
+
+    void handle(QtMsgType type, const QMessageLogContext &context, const QString &message)
+    {
+        LogEntry entry;
+        entry.timeMs   = QDateTime::currentMSecsSinceEpoch();
+        entry.type     = type;
+        entry.category = context.category ? QByteArray(context.category) : QByteArray("default");
+        entry.message  = message;
+        entry.threadId = quintptr(QThread::currentThreadId());
+
+        bool wakeWriter = false;
+        {
+            QMutexLocker lock(&mutex_);
+            if (!allow(entry, context))
+                return;
+            if (count_ == int(ring_.size())) {
+                ++dropped_;        // 쓰기가 못 따라가면 새 메시지를 버린다
+            } else {
+                ring_[(head_ + count_) % ring_.size()] = std::move(entry);
+                ++count_;
+            }
+            // 평소에는 주기적으로 묶어 쓰고, 경고 이상이나 버퍼가 반쯤 차면 바로 깨운다
+            wakeWriter = (type != QtDebugMsg && type != QtInfoMsg)
+                      || count_ >= int(ring_.size()) / 2;
+        }
+        if (wakeWriter)
+            wake_.wakeOne();
+
+        // 치명적 오류는 Qt 가 곧 프로세스를 끝내므로 여기서 바로 쓴다
+        if (type == QtFatalMsg)
+            flushNow();
+    }
+
+    /// 쓰기 스레드 본체
+    void writerLoop()
+    {
+        qint64 lastSweep = QDateTime::currentMSecsSinceEpoch();
+        for (;;) {
+            std::vector<LogEntry> batch;
+            quint64 dropped = 0;
+            bool stop = false;
+            {
+                QMutexLocker lock(&mutex_);
+                if (count_ == 0 && !stopping_)
+                    wake_.wait(&mutex_, FlushIntervalMs);
+                takeAll(batch);
+                dropped = std::exchange(dropped_, 0);
+
+                const qint64 now = QDateTime::currentMSecsSinceEpoch();
+                if (now - lastSweep >= SweepIntervalMs) {
+                    sweepRates(now / 1000, batch);
+                    lastSweep = now;
+                }
+                stop = stopping_;
+            }
+            write(batch, dropped);
+            if (stop)
+                return;
+        }
+    }
+
+    void flushNow()
+    {
+        std::vector<LogEntry> batch;
+        quint64 dropped = 0;
+        {
+            QMutexLocker lock(&mutex_);
+            takeAll(batch);
+            dropped = std::exchange(dropped_, 0);
+        }
+        write(batch, dropped);
+    }
+
+private:
+    bool allow(const LogEntry &entry, const QMessageLogContext &context)
+    {
+        // 위치 정보가 있으면 파일:줄, 없으면 분류와 메시지 앞부분으로 같은 로그를 구분
+        const size_t key = context.file
+            ? qHashMulti(0, quintptr(context.file), context.line)
+            : qHashMulti(0, entry.category, QStringView(entry.message).left(32));
+
+        const qint64 second = entry.timeMs / 1000;
+        RateState &state = rates_[key];
+        if (state.second != second) {
+            if (state.suppressed > 0)
+                pushSummary(state);
+            state.second = second;
+            state.count  = 0;
+        }
+        if (++state.count <= Logging::RateLimitPerSecond)
+            return true;
+
+        if (state.suppressed++ == 0) {
+            state.type     = entry.type;
+            state.category = entry.category;
+            state.sample   = entry.message.left(60);
+        }
+        return false;
+    }
+
+    void pushSummary(RateState &state)
+    {
+        LogEntry summary;
+        summary.timeMs   = QDateTime::currentMSecsSinceEpoch();
+        summary.type     = state.type;
+        summary.category = state.category;
+        summary.message  = QStringLiteral("(같은 메시지 %1건 생략) %2")
+                               .arg(state.suppressed).arg(state.sample);
+        state.suppressed = 0;
+        if (count_ < int(ring_.size())) {
+            ring_[(head_ + count_) % ring_.size()] = std::move(summary);
+            ++count_;
+        }
+    }
+
+    // mutex_ 를 잡은 상태에서 호출
+    void takeAll(std::vector<LogEntry> &out)
+    {
+        out.reserve(size_t(count_));
+        for (; count_ > 0; --count_) {
+            out.push_back(std::move(ring_[head_]));
+            head_ = (head_ + 1) % int(ring_.size());
+        }
+    }
+
+    // mutex_ 를 잡은 상태에서 호출. 지난 초에 생략된 건수를 보고하고 오래된 위치는 지운다
+    void sweepRates(qint64 second, std::vector<LogEntry> &out)
+    {
+        for (auto it = rates_.begin(); it != rates_.end();) {
+            RateState &state = it.value();
+            if (state.second < second && state.suppressed > 0) {
+                pushSummary(state);
+                takeAll(out);
+            }
+            if (second - state.second > RateIdleSeconds)
+                it = rates_.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    static char levelChar(QtMsgType type)
+    {
+        switch (type) {
+        case QtDebugMsg:    return 'D';
+        case QtInfoMsg:     return 'I';
+        case QtWarningMsg:  return 'W';
+        case QtCriticalMsg: return 'C';
+        case QtFatalMsg:    return 'F';
+        }
+        return '?';
+    }
+
+    void write(const std::vector<LogEntry> &batch, quint64 dropped)
+    {
+        if (batch.empty() && dropped == 0)
+            return;
+
+        QString text;
+        text.reserve(int(batch.size()) * 96);
+        for (const LogEntry &e : batch) {
+            text += QDateTime::fromMSecsSinceEpoch(e.timeMs).toString(QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"));
+            text += QLatin1Char(' ');
+            text += QLatin1Char(levelChar(e.type));
+            text += QLatin1Char(' ');
+            text += QString::number(e.threadId, 16);
+            text += QLatin1Char(' ');
+            text += QLatin1StringView(e.category);
+            text += QLatin1String(": ");
+            text += e.message;
+            text += QLatin1Char('\n');
+        }
+        if (dropped > 0)
+            text += QStringLiteral("(로그 버퍼가 가득 차 %1건을 버림)\n").arg(dropped);
+
+        // 치명적 오류 경로와 쓰기 스레드가 동시에 쓸 수 있다
+        QMutexLocker lock(&sinkMutex_);
+        const QByteArray utf8 = text.toUtf8();
+        std::fwrite(utf8.constData(), 1, size_t(utf8.size()), stderr);
+        std::fflush(stderr);
+#ifdef Q_OS_WIN
+        // 디버거가 없을 때 OutputDebugString 은 쓸모없이 느리기만 하다
+        if (IsDebuggerPresent())
+            OutputDebugStringW(reinterpret_cast<const wchar_t *>(text.utf16()));
+#endif
+        if (file_.isOpen()) {
+            file_.write(utf8);
+            file_.flush();
+        }
+    }
+
+    QMutex                 mutex_;
+    QWaitCondition         wake_;
+    std::vector<LogEntry>  ring_;
+    int                    head_ = 0;
+    int                    count_ = 0;
+    quint64                dropped_ = 0;
+    QHash<size_t, RateState> rates_;
+    bool                   stopping_ = false;
+
+    QMutex                 sinkMutex_;
+    QFile                  file_;
+    LogWriterThread        writer_;
+};
+
+void LogWriterThread::run()
+{
+    sink_->writerLoop();
+}
+
+AsyncLogSink    *g_sink = nullptr;
+QtMessageHandler g_previousHandler = nullptr;
+
+void asyncMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (g_sink)
+        g_sink->handle(type, context, message);
+    else if (g_previousHandler)
+        g_previousHandler(type, context, message);
+}
+
+} // namespace
+
+namespace Logging {
+
+void install(const QString &rules, const QString &filePath)
+{
+    if (g_sink)
+        return;
+    if (!rules.isEmpty())
+        QLoggingCategory::setFilterRules(QString(rules).replace(QLatin1Char(';'), QLatin1Char('\n')));
+
+    g_sink = new AsyncLogSink(filePath);
+    g_previousHandler = qInstallMessageHandler(asyncMessageHandler);
+}
+
+void shutdown()
+{
+    if (!g_sink)
+        return;
+    qInstallMessageHandler(g_previousHandler);
+    delete std::exchange(g_sink, nullptr);
+}
+
+} // namespace Logging
@@ -4,6 +4,12 @@
 #include "mainwindow/procsettingbox.h"
 #include "mainwindow/notificationpanel.h"
 #include "mainwindow/mqttmanager.h"
+#include "mainwindow/latencytracker.h"
+#include "mainwindow/diagnosticspage.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/stallwatchdog.h"
+#include "mainwindow/startuptrace.h"
+#include "mainwindow/tlscontext.h"
 #include "login/networkmanager.h"
 #include "login/custommessagebox.h"
 
@@ -25,6 +31,19 @@
 #include <QPalette>
 #include <QFontDatabase>
 
+namespace {
+
+// 위치/크기가 실제로 바뀐 위젯만 건드린다. 바뀌면 Qt 가 알아서 다시 그린다
+bool setGeometryIfChanged(QWidget *widget, const QRect &rect)
+{
+    if (!widget || widget->geometry() == rect)
+        return false;
+    widget->setGeometry(rect);
+    return true;
+}
+
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
     topBar(nullptr),
@@ -50,6 +69,11 @@ MainWindow::MainWindow(QWidget *parent)
     sslConf.setPeerVerifyMode(QSslSocket::VerifyNone);
     QSslConfiguration::setDefaultConfiguration(sslConf);
 
+    // 시작 단계: 영상 페이지와 RTSP 를 먼저 띄우고, 인증서 읽기는 작업 스레드에서,
+    // MQTT/명령 채널 연결은 이벤트 루프가 돈 뒤에, 히스토리 페이지는 처음 열 때 만든다.
+    // 기본 SSL 설정을 바꾼 뒤여야 TlsContext 가 만드는 설정에 반영된다
+    TlsContext::preload();
+
     // 중앙 위젯 설정
     QWidget *centralW = new QWidget(this);
     centralW->setStyleSheet("background-color: #FFFFFF;");
@@ -63,12 +87,12 @@ MainWindow::MainWindow(QWidget *parent)
     setMinimumSize(1600, 900);
     showMaximized();
 
-    // TCP 네트워크 매니저 초기화
+    // TCP 네트워크 매니저 초기화 (연결은 첫 화면 구성 뒤에)
     networkManager = new NetworkManager(this);
-    networkManager->connectToServer();
 
     // TCP 연결 상태 모니터링
     connect(networkManager, &NetworkManager::connected, this, []() {
+        StartupTrace::mark("tcp.connected");
         qDebug() << "[TCP] 서버 연결 성공";
     });
     connect(networkManager, &NetworkManager::disconnected, this, []() {
@@ -83,9 +107,14 @@ MainWindow::MainWindow(QWidget *parent)
     setupFonts();
     setupPages();
     showPage(PageType::Camera);
+    StartupTrace::mark("camera_page.built");
 
-    // 레이아웃 초기화
-    QTimer::singleShot(100, this, &MainWindow::forceLayoutUpdate);
+    // 레이아웃 요청은 한 프레임에 한 번으로 모은다 (리사이즈 중 연속 요청 병합)
+    layoutTimer = new QTimer(this);
+    layoutTimer->setSingleShot(true);
+    layoutTimer->setInterval(LayoutFrameMs);
+    connect(layoutTimer, &QTimer::timeout, this, &MainWindow::performLayout);
+    scheduleLayout();
 
     // RTSP 스트리밍 초기화
     QSettings settings("config.ini", QSettings::IniFormat);
@@ -94,28 +123,63 @@ MainWindow::MainWindow(QWidget *parent)
     rtspThread = new RtspThread(rtspUrl, this);
 
     // RTSP 프레임 수신 처리
-    connect(rtspThread, &RtspThread::frameReady, this, [this](const QImage &img) {
-        if (rtspLabel)
-            rtspLabel->setPixmap(QPixmap::fromImage(img).scaled(rtspLabel->size(), Qt::KeepAspectRatio));
+    connect(rtspThread, &RtspThread::frameReady, this, [this](const QImage &img, qint64 captureUs) {
+        if (!rtspLabel) return;
+        StartupTrace::mark("rtsp.first_frame");
+
+        const qint64 nowUs = LatencyTracker::nowUs();
+        LatencyTracker::instance().record(LatencyTracker::RtspCaptureToFrameReady, (nowUs - captureUs) / 1000.0);
+
+        rtspLabel->setPixmap(QPixmap::fromImage(img).scaled(rtspLabel->size(), Qt::KeepAspectRatio));
+
+        // 그리기 전에 다음 프레임이 오면 마지막 프레임만 표시되므로 덮어쓴다
+        if (pendingFrameCaptureUs != 0)
+            MetricsRegistry::add(MetricsRegistry::RtspDropped);
+        pendingFrameCaptureUs = captureUs;
+        pendingFrameReadyUs   = nowUs;
+    });
+
+    // 영상 라벨이 새 프레임을 그리는 시점에 지연 기록
+    new PaintProbe(rtspLabel, [this] {
+        if (pendingFrameCaptureUs == 0) return;
+        StartupTrace::finish("rtsp.first_paint");
+        const qint64 nowUs = LatencyTracker::nowUs();
+        LatencyTracker &tracker = LatencyTracker::instance();
+        tracker.record(LatencyTracker::RtspFrameReadyToPaint, (nowUs - pendingFrameReadyUs) / 1000.0);
+        tracker.record(LatencyTracker::RtspEndToEnd, (nowUs - pendingFrameCaptureUs) / 1000.0);
+        pendingFrameCaptureUs = 0;
     });
 
     rtspThread->start();
+    StartupTrace::mark("rtsp.started");
 
-    // MQTT 매니저 초기화
+    // MQTT 매니저 초기화 (인증서는 첫 연결 때 네트워크 스레드에서 붙인다)
     mqttManager = new MqttManager(this);
+    connect(mqttManager, &MqttManager::connected, this, []() {
+        StartupTrace::mark("mqtt.connected");
+    });
+    diagnosticsPage->setMqttManager(mqttManager);
 
-    // MQTT 메시지를 알림 패널로 전달
-    connect(mqttManager, &MqttManager::messageReceived,
-            notificationPanel, &NotificationPanel::handleMqttMessage);
+    // MQTT 이벤트를 알림 패널로 전달 (패널이 사라지면 경로도 해제)
+    mqttManager->addRoute(mqttManager->notificationFilter(), notificationPanel,
+                          [panel = notificationPanel](const QList<MqttEvent> &events) {
+                              panel->handleMqttEvents(events);
+                          });
 
-    // MQTT 브로커 연결
+    // MQTT 브로커와 명령 채널 연결은 첫 화면이 뜬 뒤에
     QTimer::singleShot(0, this, [this]() {
         mqttManager->connectToBroker();
+        networkManager->connectToServer();
     });
+
+    StartupTrace::mark("mainwindow.constructed");
 }
 
 MainWindow::~MainWindow()
 {
+    // 첫 프레임 전에 닫혀도 어디까지 갔는지 남긴다
+    StartupTrace::finish("mainwindow.closed");
+
     if (rtspThread) {
         rtspThread->stop();
         rtspThread->wait();
@@ -182,6 +246,7 @@ void MainWindow::setupPages()
 
     stackedWidget->addWidget(cameraPage);
     stackedWidget->addWidget(documentPage);
+    stackedWidget->addWidget(createDiagnosticsPage());
 }
 
 QWidget* MainWindow::createCameraPage()
@@ -270,24 +335,47 @@ QWidget* MainWindow::createDocumentPage()
     QWidget *page = new QWidget();
     page->setStyleSheet("background-color: #FFFFFF;");
 
-    // 히스토리 뷰 생성
-    historyView = new HistoryView(page);
-
-    // 레이아웃 설정
+    // 히스토리 뷰는 페이지를 처음 열 때 만든다 (ensureHistoryView)
     QVBoxLayout *layout = new QVBoxLayout(page);
     layout->setContentsMargins(0, 0, 0, 0);
-    layout->addWidget(historyView);
 
     page->setLayout(layout);
     return page;
 }
 
+void MainWindow::ensureHistoryView()
+{
+    if (historyView || !documentPage)
+        return;
+
+    StallWatchdog::Scope stallScope("MainWindow::ensureHistoryView");
+
+    // 만들어지면서 히스토리 서버에 연결하고 첫 페이지를 요청한다
+    historyView = new HistoryView(documentPage);
+    documentPage->layout()->addWidget(historyView);
+
+    // MQTT 이벤트를 히스토리 뷰에 실시간 반영 (새로고침 없이 해당 행만 추가)
+    if (mqttManager) {
+        mqttManager->addRoute(mqttManager->historyFilter(), historyView,
+                              [view = historyView](const QList<MqttEvent> &events) {
+                                  view->handleMqttEvents(events);
+                              });
+    }
+
+    StartupTrace::mark("history.page_built");
+}
+
+QWidget* MainWindow::createDiagnosticsPage()
+{
+    diagnosticsPage = new DiagnosticsPage();
+    return diagnosticsPage;
+}
 
 void MainWindow::resizeEvent(QResizeEvent *event)
 {
     QMainWindow::resizeEvent(event);
-    // 약간의 지연을 두고 레이아웃 업데이트 (리사이즈 완료 후)
-    QTimer::singleShot(10, this, &MainWindow::forceLayoutUpdate);
+    // 드래그 중에는 매 이벤트가 아니라 프레임마다 한 번만 배치
+    scheduleLayout();
 }
 
 void MainWindow::keyPressEvent(QKeyEvent *event)
@@ -311,21 +399,38 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
         move(x, y);
         
         // 레이아웃 업데이트
-        QTimer::singleShot(50, this, &MainWindow::forceLayoutUpdate);
+        scheduleLayout();
         
         event->accept();
         return;
     }
+
+    // F12로 성능 진단 페이지 열기/닫기
+    if (event->key() == Qt::Key_F12 && event->modifiers() == Qt::NoModifier) {
+        toggleDiagnosticsPage();
+        event->accept();
+        return;
+    }
     
     // 기본 키 이벤트 처리
     QMainWindow::keyPressEvent(event);
 }
 
+void MainWindow::toggleDiagnosticsPage()
+{
+    if (currentPageType == PageType::Diagnostics) {
+        showPage(pageBeforeDiagnostics);
+    } else {
+        pageBeforeDiagnostics = currentPageType;
+        showPage(PageType::Diagnostics);
+    }
+}
+
 void MainWindow::showEvent(QShowEvent *event)
 {
     QMainWindow::showEvent(event);
-    // 윈도우가 표시될 때 레이아웃 강제 업데이트
-    QTimer::singleShot(50, this, &MainWindow::forceLayoutUpdate);
+    // 윈도우가 표시될 때 레이아웃 업데이트
+    scheduleLayout();
 }
 
 
@@ -363,36 +468,36 @@ void MainWindow::showPage(PageType pageType)
 
     switch (pageType) {
     case PageType::Camera:   stackedWidget->setCurrentWidget(cameraPage); break;
-    case PageType::Document: stackedWidget->setCurrentWidget(documentPage); break;
+    case PageType::Document:
+        ensureHistoryView();
+        stackedWidget->setCurrentWidget(documentPage);
+        break;
+    case PageType::Diagnostics: stackedWidget->setCurrentWidget(diagnosticsPage); break;
     }
+    currentPageType = pageType;
     
-    // 페이지 전환 후 레이아웃 강제 업데이트
-    QTimer::singleShot(0, this, [this]() {
-        updateLayout();
-        // 현재 페이지의 모든 자식 위젯들도 업데이트
-        if (stackedWidget->currentWidget()) {
-            stackedWidget->currentWidget()->update();
-            stackedWidget->currentWidget()->repaint();
-        }
-    });
+    // 페이지 전환 후 레이아웃 업데이트
+    scheduleLayout();
 }
 
 void MainWindow::updateLayout()
 {
+    StallWatchdog::Scope stallScope("MainWindow::updateLayout");
+
     int w = width();
     int h = height();
 
     double h_unit = h / 24.0;
 
-    // 상단 바 레이아웃 업데이트
+    // 상단 바 레이아웃 업데이트 (크기가 같으면 내부에서 바로 돌아감)
     if (topBar) {
-        topBar->setGeometry(0, 0, w, h_unit * 3);
+        setGeometryIfChanged(topBar, QRect(0, 0, w, int(h_unit * 3)));
         topBar->updateLayout(w, h);
     }
 
     // 스택 위젯 레이아웃 업데이트
     if (stackedWidget) {
-        stackedWidget->setGeometry(0, h_unit * 3, w, h - h_unit * 3);
+        setGeometryIfChanged(stackedWidget, QRect(0, int(h_unit * 3), w, int(h - h_unit * 3)));
         
         // 현재 페이지에 따라 레이아웃 업데이트
         QWidget* currentPage = stackedWidget->currentWidget();
@@ -400,14 +505,7 @@ void MainWindow::updateLayout()
             updateCameraPageLayout();
         } else if (currentPage == documentPage && historyView) {
             // 문서 페이지 레이아웃 업데이트
-            historyView->setGeometry(0, 0, stackedWidget->width(), stackedWidget->height());
-            historyView->update();
-        }
-        
-        // 현재 페이지 강제 업데이트
-        if (currentPage) {
-            currentPage->updateGeometry();
-            currentPage->update();
+            setGeometryIfChanged(historyView, QRect(0, 0, stackedWidget->width(), stackedWidget->height()));
         }
     }
 }
@@ -423,6 +521,11 @@ void MainWindow::updateCameraPageLayout()
     double w_unit = w / 24.0;
     double h_unit = h / 21.0;
 
+    // 실수 좌표는 setGeometry(int, ...) 와 같게 버림
+    const auto rect = [](double x, double y, double width, double height) {
+        return QRect(int(x), int(y), int(width), int(height));
+    };
+
     // 레이아웃 계산
     double cctv_w = w_unit * 16.5;
     double padding = w_unit * 1;
@@ -432,85 +535,49 @@ void MainWindow::updateCameraPageLayout()
     double notif_x = cctv_x + cctv_w + middle_pad;
 
     // 제목 라벨들 배치
-    cameraTitle->setGeometry(cctv_x, h_unit * 0, cctv_w, h_unit);
-    cameraTitle->update();
-    
-    notifTitleLabel->setGeometry(notif_x, h_unit * 0, notif_w, h_unit);
-    notifTitleLabel->update();
+    setGeometryIfChanged(cameraTitle, rect(cctv_x, h_unit * 0, cctv_w, h_unit));
+    setGeometryIfChanged(notifTitleLabel, rect(notif_x, h_unit * 0, notif_w, h_unit));
 
     // RTSP 영상 라벨 배치
-    if (rtspLabel) {
-        rtspLabel->setGeometry(cctv_x, h_unit * 1, cctv_w, h_unit * 13);
-        rtspLabel->update();
-    }
+    setGeometryIfChanged(rtspLabel, rect(cctv_x, h_unit * 1, cctv_w, h_unit * 13));
     
     // 알림 패널 배치 (영상처리 박스 아래까지 확장)
     double notifHeight = h_unit * 19;
-    notificationPanel->setGeometry(notif_x, h_unit * 1, notif_w, notifHeight);
-    notificationPanel->setMinimumHeight(notifHeight);
-    notificationPanel->setMaximumHeight(notifHeight);
-    notificationPanel->updateGeometry();
-    notificationPanel->update();
+    if (notificationPanel->minimumHeight() != int(notifHeight) || notificationPanel->maximumHeight() != int(notifHeight)) {
+        notificationPanel->setMinimumHeight(notifHeight);
+        notificationPanel->setMaximumHeight(notifHeight);
+    }
+    setGeometryIfChanged(notificationPanel, rect(notif_x, h_unit * 1, notif_w, notifHeight));
 
     // 영상 설정 영역 배치
     double settingTop = h_unit * 14;
     double labelTop   = h_unit * 15;
     double boxTop     = h_unit * 16;
 
-    if (videoSettingTitle) {
-        videoSettingTitle->setGeometry(cctv_x, settingTop, cctv_w, h_unit);
-        videoSettingTitle->update();
-    }
-    if (videoSettingLine) {
-        videoSettingLine->setGeometry(cctv_x, settingTop + h_unit - 1, cctv_w, 1);
-        videoSettingLine->update();
-    }
-    if (displayTitle) {
-        displayTitle->setGeometry(cctv_x, labelTop, w_unit * 6, h_unit);
-        displayTitle->update();
-    }
-    if (procTitle) {
-        procTitle->setGeometry(cctv_x + w_unit * (6 + 0.5), labelTop, w_unit * 10, h_unit);
-        procTitle->update();
-    }
-    if (displayBox) {
-        displayBox->setGeometry(cctv_x, boxTop, w_unit * 6, h_unit * 4);
-        displayBox->updateGeometry();
-        displayBox->update();
-    }
-    if (procBox) {
-        procBox->setGeometry(cctv_x + w_unit * (6 + 0.5), boxTop, w_unit * 10, h_unit * 4);
-        procBox->updateGeometry();
-        procBox->update();
-    }
+    setGeometryIfChanged(videoSettingTitle, rect(cctv_x, settingTop, cctv_w, h_unit));
+    setGeometryIfChanged(videoSettingLine,  rect(cctv_x, settingTop + h_unit - 1, cctv_w, 1));
+    setGeometryIfChanged(displayTitle,      rect(cctv_x, labelTop, w_unit * 6, h_unit));
+    setGeometryIfChanged(procTitle,         rect(cctv_x + w_unit * (6 + 0.5), labelTop, w_unit * 10, h_unit));
+    setGeometryIfChanged(displayBox,        rect(cctv_x, boxTop, w_unit * 6, h_unit * 4));
+    setGeometryIfChanged(procBox,           rect(cctv_x + w_unit * (6 + 0.5), boxTop, w_unit * 10, h_unit * 4));
+}
+
+void MainWindow::scheduleLayout()
+{
+    // 이미 예약돼 있으면 그 배치에 합친다 (다시 시작하면 드래그 내내 밀리므로 그대로 둠)
+    if (layoutTimer && !layoutTimer->isActive())
+        layoutTimer->start();
 }
 
-void MainWindow::forceLayoutUpdate()
+void MainWindow::performLayout()
 {
-    // 현재 윈도우 상태 확인
+    StallWatchdog::Scope stallScope("MainWindow::performLayout");
+
+    // 보이지 않는 동안의 요청은 showEvent 가 다시 예약한다
     if (!isVisible() || isMinimized()) {
         return;
     }
-    
+
+    // 바뀐 위젯만 setGeometry 하므로 전체 자식 순회나 강제 repaint 는 필요 없다
     updateLayout();
-    
-    // 모든 자식 위젯들의 geometry 강제 업데이트
-    if (stackedWidget && stackedWidget->currentWidget()) {
-        QWidget* currentPage = stackedWidget->currentWidget();
-        
-        // 현재 페이지의 모든 자식 위젯들 업데이트
-        QList<QWidget*> allChildren = currentPage->findChildren<QWidget*>();
-        for (QWidget* child : allChildren) {
-            child->updateGeometry();
-            child->update();
-        }
-        
-        currentPage->updateGeometry();
-        currentPage->update();
-        currentPage->repaint();
-    }
-    
-    // 전체 윈도우 repaint
-    update();
-    repaint();
 }
@@ -0,0 +1,158 @@
+// metricsregistry.cpp
+#include "mainwindow/metricsregistry.h"
+#include <QFile>
+#include <QtGlobal>
+#include <chrono>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct TcpCommand
+{
+    const char             *name;
+    MetricsRegistry::Timing timing;
+};
+
+// 첫 단어 전체를 비교하므로 GET_HISTORY 와 GET_HISTORY_BY_* 가 섞이지 않는다
+constexpr TcpCommand kTcpCommands[] = {
+    {"HELLO",                                    MetricsRegistry::TcpHello},
+    {"LOGIN",                                    MetricsRegistry::TcpLogin},
+    {"REGISTER",                                 MetricsRegistry::TcpRegister},
+    {"RESET_PASSWORD",                           MetricsRegistry::TcpResetPassword},
+    {"GET_HISTORY",                              MetricsRegistry::TcpGetHistory},
+    {"GET_HISTORY_BY_EVENT_TYPE",                MetricsRegistry::TcpGetHistoryByEventType},
+    {"GET_HISTORY_BY_DATE_RANGE",                MetricsRegistry::TcpGetHistoryByDateRange},
+    {"GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE", MetricsRegistry::TcpGetHistoryByEventTypeAndDateRange},
+    {"ADD_HISTORY",                              MetricsRegistry::TcpAddHistory},
+    {"CHANGE_FRAME",                             MetricsRegistry::TcpChangeFrame},
+    {"GET_FRAME",                                MetricsRegistry::TcpGetFrame},
+    {"GET_LOG",                                  MetricsRegistry::TcpGetLog},
+    {"GET_IMAGE",                                MetricsRegistry::TcpGetImage},
+};
+
+} // namespace
+
+qint64 MetricsRegistry::nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void MetricsRegistry::setEnabled(bool enabled)
+{
+    if (enabled && !isEnabled()) {
+        for (CounterCell &c : counters_)
+            c.value.store(0, std::memory_order_relaxed);
+        for (TimingCell &t : timings_) {
+            t.count.store(0, std::memory_order_relaxed);
+            t.sumUs.store(0, std::memory_order_relaxed);
+            t.maxUs.store(0, std::memory_order_relaxed);
+        }
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::recordUs(Timing timing, qint64 us)
+{
+    if (!isEnabled() || timing < 0 || timing >= TimingCount)
+        return;
+
+    const quint64 value = quint64(qMax<qint64>(0, us));
+    TimingCell &cell = timings_[timing];
+    cell.count.fetch_add(1, std::memory_order_relaxed);
+    cell.sumUs.fetch_add(value, std::memory_order_relaxed);
+
+    quint64 seen = cell.maxUs.load(std::memory_order_relaxed);
+    while (value > seen && !cell.maxUs.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+MetricsRegistry::Snapshot MetricsRegistry::snapshot()
+{
+    Snapshot s;
+    for (int i = 0; i < CounterCount; ++i)
+        s.counters[i] = counters_[i].value.load(std::memory_order_relaxed);
+    for (int i = 0; i < TimingCount; ++i) {
+        s.timings[i].count = timings_[i].count.load(std::memory_order_relaxed);
+        s.timings[i].sumUs = timings_[i].sumUs.load(std::memory_order_relaxed);
+        s.timings[i].maxUs = timings_[i].maxUs.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+MetricsRegistry::Timing MetricsRegistry::tcpTiming(QStringView command)
+{
+    const qsizetype space = command.indexOf(u' ');
+    const QStringView verb = space < 0 ? command : command.left(space);
+    for (const TcpCommand &c : kTcpCommands) {
+        if (verb == QLatin1StringView(c.name))
+            return c.timing;
+    }
+    return TcpOther;
+}
+
+QString MetricsRegistry::timingLabel(Timing timing)
+{
+    switch (timing) {
+    case RtspDecode:    return QStringLiteral("RTSP 프레임 읽기/변환");
+    case EventLoopLag:  return QStringLiteral("GUI 이벤트 루프 지연");
+    case TlsHandshake:  return QStringLiteral("TLS 핸드셰이크");
+    case MqttReconnect: return QStringLiteral("MQTT 재연결 지연");
+    case HistoryDecodeJson: return QStringLiteral("히스토리 응답 디코드 (JSON)");
+    case HistoryDecodeBin1: return QStringLiteral("히스토리 응답 디코드 (bin1)");
+    case WireInflate:       return QStringLiteral("TCP 응답 압축 해제 (프레임당)");
+    case TcpOther:      return QStringLiteral("TCP 기타 명령");
+    default:
+        break;
+    }
+    for (const TcpCommand &c : kTcpCommands) {
+        if (c.timing == timing)
+            return QStringLiteral("TCP %1").arg(QLatin1StringView(c.name));
+    }
+    return QString();
+}
+
+MetricsRegistry::ProcessUsage MetricsRegistry::processUsage()
+{
+    ProcessUsage usage;
+
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        usage.rssBytes = pmc.WorkingSetSize;
+
+    FILETIME created, exited, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) {
+        const auto toUs = [](const FILETIME &ft) {
+            return qint64((quint64(ft.dwHighDateTime) << 32 | ft.dwLowDateTime) / 10);   // 100ns 단위
+        };
+        usage.cpuUs = toUs(kernel) + toUs(user);
+        usage.valid = true;
+    }
+#elif defined(Q_OS_UNIX)
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        usage.cpuUs = qint64(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000
+                    + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+        usage.valid = true;
+    }
+#  if defined(Q_OS_LINUX)
+    // statm: 전체 페이지 수, 상주 페이지 수, ...
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1)
+            usage.rssBytes = fields.at(1).toULongLong() * quint64(sysconf(_SC_PAGESIZE));
+    }
+#  endif
+#endif
+
+    return usage;
+}
@@ -0,0 +1,31 @@
+// mqttevent.cpp
+#include "mainwindow/mqttevent.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+bool MqttEvent::decode(const QString &topic, const QByteArray &payload, MqttEvent &out)
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(payload, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject())
+        return false;
+
+    const QJsonObject obj = doc.object();
+    const int eventType = obj.value("event").toInt(-1);
+
+    // 테스트 메시지 등 유효하지 않은 이벤트 타입 무시
+    if (eventType == -1)
+        return false;
+
+    out.topic     = topic;
+    out.eventType = eventType;
+    out.record    = HistoryRecord::fromMqttPayload(obj);
+
+    // 시간 포맷 변환 (ISO8601 → yyyy-MM-dd HH:mm)
+    const QString timestamp = obj.value("timestamp").toString();
+    const QDateTime dt = QDateTime::fromString(timestamp, Qt::ISODate);
+    out.notifyDate = dt.isValid() ? dt.toString("yyyy-MM-dd HH:mm") : timestamp;
+    out.sentMs     = dt.isValid() ? dt.toMSecsSinceEpoch() : 0;
+    return true;
+}
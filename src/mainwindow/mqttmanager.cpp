@@ -1,178 +1,399 @@
 #include "mainwindow/mqttmanager.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/tlscontext.h"
 #include <QFile>
-#include <QDebug>
-#include <QSslKey>
 #include <QMqttTopicFilter>
 #include <QSettings>
 #include <QUrl>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QSysInfo>
 
 MqttManager::MqttManager(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      client(new QMqttClient),
+      reconnectTimer_(new QTimer(client))
 {
-    // SSL 인증서 로드
-    loadCertificates();
-
     // config.ini에서 MQTT 설정 읽기
     QString configPath = findConfigFile();
     if (!configPath.isEmpty()) {
         QSettings settings(configPath, QSettings::IniFormat);
         brokerUrl = settings.value("mqtt/broker_url").toString();
-        subscribeTopic = settings.value("mqtt/subscribe_topic").toString();
         publishTopic = settings.value("mqtt/publish_topic").toString();
+
+        // "alert" 또는 "alert:1, status/#:0" (토픽별 QoS, 생략 시 subscribe_qos)
+        const quint8 defaultQos = quint8(qBound(0, settings.value("mqtt/subscribe_qos", 1).toInt(), 2));
+        subscriptions = parseSubscriptions(settings.value("mqtt/subscribe_topic").toString(), defaultQos);
+        // 알림 패널/히스토리가 받을 토픽 (형식이 잘못되면 전체)
+        auto readFilter = [&settings](const char *key, QString &filter) {
+            const QString value = settings.value(key).toString().trimmed();
+            if (TopicRouter::isValidFilter(value))
+                filter = value;
+            else if (!value.isEmpty())
+                qCWarning(lcConfig) << "잘못된 토픽 필터, 전체 수신:" << key << value;
+        };
+        readFilter("mqtt/notify_filter", notificationFilter_);
+        readFilter("mqtt/history_filter", historyFilter_);
+
+        // 지속 세션: 같은 client id 로 다시 붙어야 브로커가 밀린 메시지를 보낸다
+        QString clientId = settings.value("mqtt/client_id").toString();
+        if (clientId.isEmpty())
+            clientId = stableClientId();
+        client->setClientId(clientId);
+        client->setCleanSession(settings.value("mqtt/clean_session", false).toBool());
+        client->setKeepAlive(settings.value("mqtt/keep_alive", 30).toInt());
         
-        qDebug() << "[MQTT] 브로커 URL 로드:" << brokerUrl;
+        qCDebug(lcMqtt) << "브로커 URL 로드:" << brokerUrl;
         
         // URL 파싱하여 호스트와 포트 추출
         QUrl url(brokerUrl);
-        client.setHostname(url.host());
-        client.setPort(url.port(1883)); // 기본 포트 1883
+        client->setHostname(url.host());
+        client->setPort(url.port(1883)); // 기본 포트 1883
         
         // SSL 사용 여부 결정 (mqtts:// 또는 ssl:// 스키마인 경우)
         useSSL = (url.scheme().toLower() == "mqtts" || url.scheme().toLower() == "ssl");
         
-        qDebug() << "[MQTT] 연결 설정 완료 - Host:" << url.host() << "Port:" << url.port(1883) << "SSL:" << useSSL;
+        qCDebug(lcMqtt) << "연결 설정 완료 - Host:" << url.host() << "Port:" << url.port(1883) << "SSL:" << useSSL
+                 << "ClientId:" << clientId << "CleanSession:" << client->cleanSession();
     } else {
-        qDebug() << "[MQTT] config.ini 파일을 찾을 수 없습니다.";
+        qCWarning(lcConfig) << "config.ini 파일을 찾을 수 없습니다.";
     }
     
-    // MQTT 클라이언트 연결 성공 시 처리
-    connect(&client, &QMqttClient::connected, this, [this]() {
-        qDebug() << "[MQTT] 브로커 연결 성공";
-        emit connected();
-        
-        // 구독 토픽 설정
-        QMqttTopicFilter filter(subscribeTopic);
-        auto sub = client.subscribe(filter, 1);
-        if (sub)
-            qDebug() << "[MQTT] 토픽 구독 성공:" << subscribeTopic;
-        else
-            qDebug() << "[MQTT] 토픽 구독 실패";
-    });
+    // MQTT 클라이언트 연결 성공 시 처리 (구독은 네트워크 스레드에서)
+    connect(client, &QMqttClient::connected, client, [this]() { onConnected(); });
+
+    // 연결이 끊기거나 연결에 실패하면 백오프 후 재연결
+    connect(client, &QMqttClient::stateChanged, client,
+            [this](QMqttClient::ClientState state) { onStateChanged(state); });
+    reconnectTimer_->setSingleShot(true);
+    connect(reconnectTimer_, &QTimer::timeout, client, [this]() { openConnection(); });
 
-    // MQTT 메시지 수신 처리
-    connect(&client, &QMqttClient::messageReceived, this,
+    // MQTT 메시지 수신 처리 (해석까지 네트워크 스레드에서)
+    connect(client, &QMqttClient::messageReceived, client,
             [this](const QByteArray &msg, const QMqttTopicName &topic) {
-                emit newMessage(topic.name(), msg);
+                onMessage(msg, topic);
             });
 
     // MQTT 에러 처리
-    connect(&client, &QMqttClient::errorChanged, this, [this]() {
-        qDebug() << "[MQTT] 연결 오류:" << client.error();
+    connect(client, &QMqttClient::errorChanged, client, [this]() {
+        qCWarning(lcMqtt) << "연결 오류:" << client->error();
     });
 
-    // MQTT 메시지 수신 시그널 처리
-    connect(&client, &QMqttClient::messageReceived, this,
-            [this](const QByteArray &msg, const QMqttTopicName &topic) {
-                Q_UNUSED(topic);
-                emit messageReceived(msg);
-            });
+    networkThread_.setObjectName("MqttNetwork");
+    client->moveToThread(&networkThread_);
+    connect(&networkThread_, &QThread::finished, client, &QObject::deleteLater);
+    networkThread_.start();
 }
 
-void MqttManager::loadCertificates()
+MqttManager::~MqttManager()
+{
+    // 연결 종료는 클라이언트 스레드에서 끝낸 뒤 스레드 정리
+    stopping_.store(true);
+    QMetaObject::invokeMethod(client, [this]() {
+        reconnectTimer_->stop();
+        client->disconnectFromHost();
+    }, Qt::BlockingQueuedConnection);
+    networkThread_.quit();
+    networkThread_.wait();
+}
+
+QList<MqttManager::Subscription> MqttManager::parseSubscriptions(const QString &value, quint8 defaultQos)
 {
-    // CA 인증서 로드 (리소스 우선, 실패 시 파일 시스템)
-    QString caPath = findCertificateFile("ca.cert.pem");
-    if (!caPath.isEmpty()) {
-        QFile caFile(caPath);
-        if (caFile.open(QIODevice::ReadOnly)) {
-            QSslCertificate caCert(&caFile, QSsl::Pem);
-            sslConfig.addCaCertificate(caCert);
-            qDebug() << "[TLS] CA 인증서 로드 성공:" << caPath;
-        } else {
-            qDebug() << "[TLS] CA 인증서 파일 열기 실패:" << caPath;
+    QList<Subscription> result;
+    const QStringList entries = value.split(',', Qt::SkipEmptyParts);
+    for (const QString &entry : entries) {
+        Subscription sub;
+        sub.filter = entry.trimmed();
+        sub.qos    = defaultQos;
+
+        // 끝의 ":숫자" 는 QoS (토픽에는 ':' 가 거의 쓰이지 않음)
+        const qsizetype colon = sub.filter.lastIndexOf(':');
+        if (colon > 0) {
+            bool ok = false;
+            const int qos = sub.filter.mid(colon + 1).trimmed().toInt(&ok);
+            if (ok && qos >= 0 && qos <= 2) {
+                sub.qos    = quint8(qos);
+                sub.filter = sub.filter.left(colon).trimmed();
+            }
         }
-    } else {
-        qDebug() << "[TLS] CA 인증서 로드 실패";
+        if (!sub.filter.isEmpty())
+            result.append(sub);
     }
+    return result;
+}
 
-    // 클라이언트 인증서와 개인키 로드
-    QString certPath = findCertificateFile("client.cert.pem");
-    QString keyPath = findCertificateFile("client.key.pem");
-    
-    if (!certPath.isEmpty() && !keyPath.isEmpty()) {
-        QFile certFile(certPath);
-        QFile keyFile(keyPath);
-        if (certFile.open(QIODevice::ReadOnly) && keyFile.open(QIODevice::ReadOnly)) {
-            QSslCertificate clientCert(&certFile, QSsl::Pem);
-            QSslKey clientKey(&keyFile, QSsl::Rsa, QSsl::Pem);
-            sslConfig.setLocalCertificate(clientCert);
-            sslConfig.setPrivateKey(clientKey);
-            qDebug() << "[TLS] 클라이언트 인증서/키 로드 성공:" << certPath << "," << keyPath;
-        } else {
-            qDebug() << "[TLS] 클라이언트 인증서/키 파일 열기 실패";
+QString MqttManager::stableClientId()
+{
+    // 같은 PC 에서는 항상 같은 id (설정에 client_id 가 없을 때)
+    QByteArray machine = QSysInfo::machineUniqueId();
+    if (machine.isEmpty())
+        machine = QSysInfo::machineHostName().toUtf8();
+    const QByteArray hash = QCryptographicHash::hash(machine, QCryptographicHash::Sha1).toHex();
+    return "quadqt-" + QString::fromLatin1(hash.left(12));
+}
+
+void MqttManager::openConnection()
+{
+    if (stopping_.load() || client->state() != QMqttClient::Disconnected)
+        return;
+
+    if (useSSL) {
+        // 인증서는 첫 암호화 연결 때 이 스레드에서 붙인다 (생성자를 가볍게)
+        if (!certificatesLoaded_) {
+            loadCertificates();
+            certificatesLoaded_ = true;
         }
+        qCDebug(lcMqtt) << "SSL 암호화 연결 시도";
+        client->connectToHostEncrypted(sslConfig);
     } else {
-        qDebug() << "[TLS] 클라이언트 인증서/키 로드 실패";
+        qCDebug(lcMqtt) << "일반 연결 시도";
+        client->connectToHost();
     }
 }
 
-void MqttManager::publish(const QString &topic, const QByteArray &payload)
+void MqttManager::onConnected()
 {
-    // 지정된 토픽으로 메시지 발행 (QoS 1, retain false)
-    client.publish(topic, payload, 1, false);
+    qCDebug(lcMqtt) << "브로커 연결 성공";
+    reconnectTimer_->stop();
+
+    if (disconnectedTimer_.isValid()) {
+        const qint64 latency = disconnectedTimer_.elapsed();
+        qCInfo(lcMqtt) << "재연결 완료:" << latency << "ms," << reconnectAttempts_ << "회 시도";
+        MetricsRegistry::recordUs(MetricsRegistry::MqttReconnect, latency * 1000);
+        lastReconnectMs_.store(latency, std::memory_order_relaxed);
+        lastReconnectAttempts_.store(reconnectAttempts_, std::memory_order_relaxed);
+        disconnectedTimer_.invalidate();
+
+        // 끊긴 동안 발행되어 지금 도착하는 알림 수를 잠시 집계
+        reconnectedAtMs_ = QDateTime::currentMSecsSinceEpoch();
+        recoveredCount_  = 0;
+        QTimer::singleShot(RecoveryReportMs, client, [this]() {
+            qCInfo(lcMqtt) << "재연결 후 복구된 알림:" << recoveredCount_ << "건";
+            recoveredTotal_.fetch_add(quint64(recoveredCount_), std::memory_order_relaxed);
+            reconnectedAtMs_ = 0;
+        });
+    }
+    reconnectAttempts_ = 0;
+    wasConnected_ = true;
+    emit connected();
+
+    // 구독 토픽 설정 (지속 세션이라도 브로커가 구독을 잃었을 수 있으므로 매번 다시)
+    for (const Subscription &sub : std::as_const(subscriptions)) {
+        auto *subscription = client->subscribe(QMqttTopicFilter(sub.filter), sub.qos);
+        if (subscription)
+            qCDebug(lcMqtt) << "토픽 구독 성공:" << sub.filter << "QoS" << sub.qos;
+        else
+            qCWarning(lcMqtt) << "토픽 구독 실패:" << sub.filter;
+    }
 }
 
-void MqttManager::publish(const QByteArray &payload)
+void MqttManager::onStateChanged(QMqttClient::ClientState state)
 {
-    // 기본 토픽으로 메시지 발행
-    client.publish(publishTopic, payload, 1, false);
+    if (state != QMqttClient::Disconnected || stopping_.load())
+        return;
+
+    // 연결돼 있다가 끊긴 시점부터 재연결 지연을 잰다
+    if (wasConnected_) {
+        wasConnected_ = false;
+        disconnectedTimer_.start();
+        qCDebug(lcMqtt) << "연결 끊김";
+    }
+    scheduleReconnect();
 }
 
-void MqttManager::connectToBroker()
+void MqttManager::scheduleReconnect()
 {
-    qDebug() << "[MQTT] 브로커 연결 시도:" << client.hostname() << ":" << client.port();
-    
-    if (useSSL) {
-        qDebug() << "[MQTT] SSL 암호화 연결 시도";
-        client.connectToHostEncrypted(sslConfig);
-    } else {
-        qDebug() << "[MQTT] 일반 연결 시도";
-        client.connectToHost();
+    if (reconnectTimer_->isActive())
+        return;
+
+    // 1s, 2s, 4s ... 최대 30s, ±10% 흔들어 여러 클라이언트가 동시에 몰리지 않게
+    const int shift = qMin(reconnectAttempts_, 5);
+    const int base  = qMin(ReconnectMinMs << shift, ReconnectMaxMs);
+    const int jitter = QRandomGenerator::global()->bounded(base / 5 + 1);
+    const int delay = base - base / 10 + jitter;
+    ++reconnectAttempts_;
+
+    qCDebug(lcMqtt) << delay << "ms 후 재연결 (" << reconnectAttempts_ << "번째)";
+    reconnectTimer_->start(delay);
+}
+
+bool MqttManager::isDuplicate(int eventId, qint64 nowMs)
+{
+    // 오래된 id 는 창에서 내보낸다
+    while (!recentOrder_.isEmpty()
+           && (recentOrder_.size() >= DedupeCapacity
+               || nowMs - recentIds_.value(recentOrder_.head()) > DedupeWindowMs)) {
+        recentIds_.remove(recentOrder_.dequeue());
     }
+
+    if (recentIds_.contains(eventId))
+        return true;
+    recentIds_.insert(eventId, nowMs);
+    recentOrder_.enqueue(eventId);
+    return false;
 }
 
-QString MqttManager::findCertificateFile(const QString &filename)
+void MqttManager::onMessage(const QByteArray &message, const QMqttTopicName &topic)
 {
-    qDebug() << "[MQTT] 인증서 파일 검색:" << filename;
-    
-    // 1. 리소스 경로 우선 시도
-    QString resourcePath = ":/certs/" + filename;
-    qDebug() << "[MQTT] 리소스 경로 확인:" << resourcePath << "존재:" << QFile::exists(resourcePath);
-    if (QFile::exists(resourcePath)) {
-        qDebug() << "[MQTT] 리소스에서 인증서 파일 발견:" << resourcePath;
-        return resourcePath;
+    MqttEvent event;
+    if (!MqttEvent::decode(topic.name(), message, event))
+        return;
+    event.receivedMs = QDateTime::currentMSecsSinceEpoch();
+
+    // 재연결 후 세션에서 다시 온 알림은 한 번만 (서버 id 가 있는 경우)
+    if (event.record.id > 0 && isDuplicate(event.record.id, event.receivedMs)) {
+        ++duplicateCount_;
+        return;
     }
-    
-    // 2. 파일 시스템 경로들 시도
-    QStringList searchPaths = {
-        filename,                    // 원본 경로
-        "./" + filename,            // 현재 디렉토리
-        "../" + filename,           // 상위 디렉토리
-        "../../" + filename,        // 상위의 상위 디렉토리
-        "../../../" + filename,     // 상위의 상위의 상위 디렉토리
-        "resources/certs/" + QFileInfo(filename).fileName(),  // resources/certs 디렉토리
-        "../../../resources/certs/" + QFileInfo(filename).fileName(),  // 프로젝트 루트의 resources/certs
-        "../../../../resources/certs/" + QFileInfo(filename).fileName(),  // 더 상위의 resources/certs
-        QCoreApplication::applicationDirPath() + "/" + filename,  // 실행 파일 디렉토리
-        QDir::currentPath() + "/" + filename  // 현재 작업 디렉토리
-    };
-    
-    qDebug() << "[MQTT] 현재 작업 디렉토리:" << QDir::currentPath();
-    
-    for (const QString &path : searchPaths) {
-        QFile file(path);
-        qDebug() << "[MQTT] 검색 경로:" << path << "존재:" << file.exists();
-        if (file.exists()) {
-            qDebug() << "[MQTT] 인증서 파일 발견:" << path;
-            return path;
+    if (reconnectedAtMs_ && event.sentMs > 0 && event.sentMs < reconnectedAtMs_)
+        ++recoveredCount_;
+
+    // 경로 대조도 여기서 (GUI 스레드는 결과만 본다)
+    if (!router_.isEmpty())
+        router_.match(event.topic, event.matches);
+
+    if (!queue_.tryPush(std::move(event))) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        MetricsRegistry::add(MetricsRegistry::MqttDropped);
+        return;
+    }
+    MetricsRegistry::add(MetricsRegistry::MqttMessages);
+
+    // 이미 깨워 둔 상태면 다시 부르지 않는다 (폭주 시에도 이벤트 루프 호출은 묶음당 한 번)
+    if (!drainScheduled_.exchange(true, std::memory_order_acq_rel))
+        QMetaObject::invokeMethod(this, &MqttManager::drainEvents, Qt::QueuedConnection);
+}
+
+void MqttManager::drainEvents()
+{
+    // 꺼내기 전에 먼저 내려야, 그 사이 들어온 이벤트가 다음 호출을 예약한다
+    drainScheduled_.store(false, std::memory_order_release);
+
+    QList<MqttEvent> events;
+    MqttEvent event;
+    while (queue_.tryPop(event))
+        events.append(std::move(event));
+    if (events.isEmpty())
+        return;
+
+    // 수신 통계 (5초마다)
+    if (!statsTimer_.isValid())
+        statsTimer_.start();
+    statsCount_ += events.size();
+    statsMaxBatch_ = qMax<std::size_t>(statsMaxBatch_, events.size());
+    if (statsTimer_.elapsed() >= 5000) {
+        qCInfo(lcMqtt) << "수신" << qRound(statsCount_ * 1000.0 / statsTimer_.elapsed()) << "건/초,"
+                 << "최대 묶음" << statsMaxBatch_ << "건, 버림" << droppedCount_.load(std::memory_order_relaxed) << "건";
+        statsTimer_.restart();
+        statsCount_ = 0;
+        statsMaxBatch_ = 0;
+    }
+
+    if (!routes_.isEmpty())
+        dispatchRoutes(events);
+}
+
+void MqttManager::dispatchRoutes(const QList<MqttEvent> &events)
+{
+    // 경로별로 묶어 처리기는 묶음당 한 번만 부른다 (처리기가 화면 갱신을 한 번에 하도록)
+    QHash<int, QList<MqttEvent>> batches;
+    QList<int> order;
+    for (const MqttEvent &event : events) {
+        for (const TopicMatch &match : event.matches) {
+            if (!routes_.contains(match.route))
+                continue;
+            QList<MqttEvent> &batch = batches[match.route];
+            if (batch.isEmpty())
+                order.append(match.route);
+            batch.append(event);
+            batch.last().captures = match.captures;
         }
     }
+
+    for (int route : std::as_const(order)) {
+        const auto it = routes_.constFind(route);
+        if (it == routes_.constEnd() || !it->context)
+            continue;
+        // 처리기 안에서 경로를 지워도 안전하도록 복사해서 호출
+        const RouteHandler handler = it->handler;
+        handler(batches.value(route));
+    }
+}
+
+int MqttManager::addRoute(const QString &filter, QObject *context, RouteHandler handler, int qos)
+{
+    if (!context || !handler || !TopicRouter::isValidFilter(filter)) {
+        qCWarning(lcMqtt) << "잘못된 경로 필터:" << filter;
+        return -1;
+    }
+
+    const int route = nextRouteId_++;
+    routes_.insert(route, {context, std::move(handler)});
+    connect(context, &QObject::destroyed, this, [this, route]() { removeRoute(route); });
+
+    QMetaObject::invokeMethod(client, [this, filter, route, qos]() {
+        router_.addRoute(filter, route);
+        if (qos < 0 || qos > 2)
+            return;
+        subscriptions.append({filter, quint8(qos)});
+        if (client->state() == QMqttClient::Connected)
+            client->subscribe(QMqttTopicFilter(filter), quint8(qos));
+    }, Qt::QueuedConnection);
+    return route;
+}
+
+void MqttManager::removeRoute(int route)
+{
+    if (!routes_.remove(route))
+        return;
+    QMetaObject::invokeMethod(client, [this, route]() {
+        router_.removeRoute(route);
+    }, Qt::QueuedConnection);
+}
+
+void MqttManager::loadCertificates()
+{
+    // TlsContext 가 읽어 둔 자료를 쓴다 (시작 단계에서 미리 읽기 시작함)
+    const TlsContext::Material &m = TlsContext::material();
+
+    if (!m.caCertificates.isEmpty())
+        sslConfig.addCaCertificates(m.caCertificates);
+    else
+        qCWarning(lcConfig) << "CA 인증서 로드 실패";
+
+    if (!m.localCertificate.isNull() && !m.privateKey.isNull()) {
+        sslConfig.setLocalCertificate(m.localCertificate);
+        sslConfig.setPrivateKey(m.privateKey);
+    } else {
+        qCWarning(lcConfig) << "클라이언트 인증서/키 로드 실패";
+    }
+}
+
+void MqttManager::publish(const QString &topic, const QByteArray &payload)
+{
+    // 지정된 토픽으로 메시지 발행 (QoS 1, retain false)
+    QMetaObject::invokeMethod(client, [c = client, topic, payload]() {
+        c->publish(topic, payload, 1, false);
+    }, Qt::QueuedConnection);
+}
+
+void MqttManager::publish(const QByteArray &payload)
+{
+    // 기본 토픽으로 메시지 발행
+    publish(publishTopic, payload);
+}
+
+void MqttManager::connectToBroker()
+{
+    qCDebug(lcMqtt) << "브로커 연결 시도:" << client->hostname() << ":" << client->port();
     
-    qDebug() << "[MQTT] 인증서 파일을 찾을 수 없습니다:" << filename;
-    return QString(); // 빈 문자열 반환
+    // 클라이언트는 네트워크 스레드 소속이므로 그 스레드에서 연결
+    QMetaObject::invokeMethod(client, [this]() { openConnection(); }, Qt::QueuedConnection);
 }
 
 QString MqttManager::findConfigFile()
@@ -187,19 +408,19 @@ QString MqttManager::findConfigFile()
         QDir::currentPath() + "/config.ini"  // 현재 작업 디렉토리
     };
     
-    qDebug() << "[MQTT] config.ini 파일 검색 중...";
-    qDebug() << "[MQTT] 현재 작업 디렉토리:" << QDir::currentPath();
-    qDebug() << "[MQTT] 실행 파일 디렉토리:" << QCoreApplication::applicationDirPath();
+    qCDebug(lcConfig) << "config.ini 파일 검색 중...";
+    qCDebug(lcConfig) << "현재 작업 디렉토리:" << QDir::currentPath();
+    qCDebug(lcConfig) << "실행 파일 디렉토리:" << QCoreApplication::applicationDirPath();
     
     for (const QString &path : searchPaths) {
         QFile file(path);
-        qDebug() << "[MQTT] 검색 경로:" << path << "존재:" << file.exists();
+        qCDebug(lcConfig) << "검색 경로:" << path << "존재:" << file.exists();
         if (file.exists()) {
-            qDebug() << "[MQTT] config.ini 파일 발견:" << path;
+            qCDebug(lcConfig) << "config.ini 파일 발견:" << path;
             return path;
         }
     }
     
-    qDebug() << "[MQTT] config.ini 파일을 찾을 수 없습니다";
+    qCWarning(lcConfig) << "config.ini 파일을 찾을 수 없습니다";
     return QString(); // 빈 문자열 반환
 }
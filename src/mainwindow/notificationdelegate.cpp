@@ -0,0 +1,114 @@
+// notificationdelegate.cpp
+#include "mainwindow/notificationdelegate.h"
+#include "mainwindow/notificationmodel.h"
+#include <QPainter>
+#include <QMouseEvent>
+
+namespace {
+
+struct EventStyle {
+    QColor  background;
+    QColor  line;
+    QString message;
+};
+
+EventStyle styleFor(int eventType)
+{
+    switch (eventType) {
+    case 0:  return { QColor(241, 194, 27, 26), QColor("#F1C21B"), "불법 주정차 차량 인식" };  // 연한 노랑
+    case 1:  return { QColor(218, 30, 40, 26),  QColor("#DA1E28"), "과속 차량 인식" };        // 연한 빨강
+    case 2:  return { QColor(2, 68, 207, 26),   QColor("#0244CF"), "보행자 인식" };           // 연한 파랑
+    default: return { QColor(0, 0, 0, 13),      QColor("#888888"), QString("이벤트 %1").arg(eventType) };
+    }
+}
+
+} // namespace
+
+NotificationDelegate::NotificationDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+    const char *paths[] = { ":/images/caution.png", ":/images/prohibition.png", ":/images/info.png" };
+    for (int i = 0; i < 3; ++i)
+        icons_[i] = QPixmap(paths[i]).scaled(40, 40, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+QSize NotificationDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const
+{
+    return QSize(option.rect.width(), ItemHeight + Spacing);
+}
+
+QRect NotificationDelegate::removeButtonRect(const QRect &itemRect)
+{
+    return QRect(itemRect.right() - 8 - 20, itemRect.top() + 8, 20, 20);
+}
+
+void NotificationDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const
+{
+    const int eventType = index.data(NotificationModel::EventTypeRole).toInt();
+    const int count     = index.data(NotificationModel::CountRole).toInt();
+    const QString date  = index.data(NotificationModel::DateRole).toString();
+    const EventStyle style = styleFor(eventType);
+
+    const QRect r = option.rect.adjusted(0, 0, 0, -Spacing);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->fillRect(r, style.background);
+    painter->fillRect(QRect(r.left(), r.top(), 6, r.height()), style.line);
+
+    // 아이콘 (왼쪽 선 + 간격 뒤 50px 칸 가운데)
+    if (eventType >= 0 && eventType < 3)
+        painter->drawPixmap(r.left() + 6 + 8 + (50 - 40) / 2, r.top() + 12, icons_[eventType]);
+
+    // 메시지 / 시각
+    const int textLeft = r.left() + 6 + 8 + 50 + 8;
+    QFont font = option.font;
+    font.setPixelSize(14);
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(Qt::black);
+    const QFontMetrics boldMetrics(font);
+    const QRect messageRect(textLeft, r.top() + 8, boldMetrics.horizontalAdvance(style.message), boldMetrics.height());
+    painter->drawText(messageRect, Qt::AlignLeft | Qt::AlignVCenter, style.message);
+
+    // 짧은 시간에 반복된 알림은 한 줄로 묶고 횟수 표시
+    if (count > 1) {
+        const QString badge = QString("×%1").arg(count);
+        QFont badgeFont = font;
+        badgeFont.setPixelSize(12);
+        painter->setFont(badgeFont);
+        const QRect badgeRect(messageRect.right() + 8, messageRect.top() + 1,
+                              QFontMetrics(badgeFont).horizontalAdvance(badge) + 12, messageRect.height() - 2);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(style.line);
+        painter->drawRoundedRect(badgeRect, 8, 8);
+        painter->setPen(Qt::white);
+        painter->drawText(badgeRect, Qt::AlignCenter, badge);
+    }
+
+    font.setBold(false);
+    painter->setFont(font);
+    painter->setPen(QColor("#333"));
+    painter->drawText(QRect(textLeft, messageRect.bottom() + 4, r.right() - textLeft, boldMetrics.height()),
+                      Qt::AlignLeft | Qt::AlignVCenter, date);
+
+    // 삭제 버튼
+    painter->setPen(Qt::black);
+    painter->drawText(removeButtonRect(r), Qt::AlignCenter, "✕");
+    painter->restore();
+}
+
+bool NotificationDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                       const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() == QEvent::MouseButtonRelease) {
+        auto *mouse = static_cast<QMouseEvent *>(event);
+        if (mouse->button() == Qt::LeftButton
+            && removeButtonRect(option.rect.adjusted(0, 0, 0, -Spacing)).contains(mouse->position().toPoint())) {
+            emit removeRequested(index);
+            return true;
+        }
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
@@ -0,0 +1,101 @@
+// notificationmodel.cpp
+#include "mainwindow/notificationmodel.h"
+
+NotificationModel::NotificationModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int NotificationModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(entries_.size());
+}
+
+QVariant NotificationModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= entries_.size())
+        return QVariant();
+
+    const NotificationEntry &e = entries_.at(index.row());
+    switch (role) {
+    case EventTypeRole: return e.eventType;
+    case DateRole:
+    case Qt::DisplayRole: return e.date;
+    case CountRole:     return e.count;
+    default:            return QVariant();
+    }
+}
+
+void NotificationModel::setMaximumCount(int count)
+{
+    maxCount_ = qMax(1, count);
+    trim();
+}
+
+void NotificationModel::prependBatch(const QList<NotificationEntry> &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    // 뷰에는 삽입 알림 한 번, 레이아웃도 한 번
+    beginInsertRows(QModelIndex(), 0, int(batch.size()) - 1);
+    QList<NotificationEntry> merged;
+    merged.reserve(batch.size() + entries_.size());
+    merged.append(batch);
+    merged.append(entries_);
+    entries_.swap(merged);
+    endInsertRows();
+
+    trim();
+}
+
+int NotificationModel::findRecent(int eventType, qint64 nowMs, qint64 windowMs) const
+{
+    // 최신순이므로 창을 벗어난 행을 만나면 그만 본다
+    for (int row = 0; row < entries_.size(); ++row) {
+        const NotificationEntry &e = entries_.at(row);
+        if (nowMs - e.lastSeenMs > windowMs)
+            break;
+        if (e.eventType == eventType)
+            return row;
+    }
+    return -1;
+}
+
+void NotificationModel::bump(int row, int count, const QString &date, qint64 lastSeenMs)
+{
+    if (row < 0 || row >= entries_.size())
+        return;
+
+    NotificationEntry &e = entries_[row];
+    e.count     += count;
+    e.date       = date;
+    e.lastSeenMs = lastSeenMs;
+
+    if (row > 0) {
+        beginMoveRows(QModelIndex(), row, row, QModelIndex(), 0);
+        entries_.move(row, 0);
+        endMoveRows();
+        row = 0;
+    }
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, {DateRole, CountRole, Qt::DisplayRole});
+}
+
+void NotificationModel::removeEntry(int row)
+{
+    if (row < 0 || row >= entries_.size())
+        return;
+    beginRemoveRows(QModelIndex(), row, row);
+    entries_.removeAt(row);
+    endRemoveRows();
+}
+
+void NotificationModel::trim()
+{
+    if (entries_.size() <= maxCount_)
+        return;
+    beginRemoveRows(QModelIndex(), maxCount_, int(entries_.size()) - 1);
+    entries_.resize(maxCount_);
+    endRemoveRows();
+}
@@ -1,12 +1,14 @@
 #include "mainwindow/notificationpanel.h"
-#include "mainwindow/notificationitem.h"
+#include "mainwindow/notificationdelegate.h"
+#include "mainwindow/latencytracker.h"
 #include <QVBoxLayout>
 #include <QLabel>
-#include <QScrollArea>
+#include <QListView>
 #include <QScrollBar>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QDateTime>
+#include <QMap>
+#include <QHash>
+#include <algorithm>
 
 NotificationPanel::NotificationPanel(QWidget *parent)
     : QWidget(parent)
@@ -19,13 +21,33 @@ NotificationPanel::NotificationPanel(QWidget *parent)
     outerLayout->setContentsMargins(0, 0, 0, 0);
     outerLayout->setSpacing(0);
 
-    // 스크롤 영역 생성
-    scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setStyleSheet(R"(
-        QScrollArea {
+    // 알림 없음 라벨
+    emptyLabel = new QLabel("현재 알림이 없습니다", this);
+    emptyLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    emptyLabel->setContentsMargins(8, 8, 8, 8);
+    emptyLabel->setStyleSheet("color: #666; font-size: 14px;");
+    outerLayout->addWidget(emptyLabel);
+
+    // 알림 목록 (모델/뷰, 보이는 행만 그림)
+    model = new NotificationModel(this);
+    model->setMaximumCount(MaxNotifications);
+
+    auto *delegate = new NotificationDelegate(this);
+    connect(delegate, &NotificationDelegate::removeRequested,
+            this, &NotificationPanel::removeNotification);
+
+    listView = new QListView(this);
+    listView->setModel(model);
+    listView->setItemDelegate(delegate);
+    listView->setUniformItemSizes(true);
+    listView->setSelectionMode(QAbstractItemView::NoSelection);
+    listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    listView->setFocusPolicy(Qt::NoFocus);
+    listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    listView->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    listView->setStyleSheet(R"(
+        QListView {
             background-color: transparent;
             border: none;
         }
@@ -43,88 +65,135 @@ NotificationPanel::NotificationPanel(QWidget *parent)
             background-color: #a0a0a0;
         }
     )");
+    outerLayout->addWidget(listView, 1);
 
-    // 스크롤 내부 컨테이너
-    container = new QWidget();
-    container->setStyleSheet("background-color: transparent; border: none;");
-    
-    // 컨테이너 내부 레이아웃
-    mainLayout = new QVBoxLayout(container);
-    mainLayout->setContentsMargins(0, 0, 0, 0);
-    mainLayout->setSpacing(2); // 알림 간 간격
-    mainLayout->setAlignment(Qt::AlignTop);
+    // 반영된 알림이 실제로 그려지는 시점에 지연 기록
+    new PaintProbe(listView->viewport(), [this] { recordPaintLatency(); });
 
-    // 알림 없음 라벨
-    emptyLabel = new QLabel("현재 알림이 없습니다", container);
-    emptyLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
-    emptyLabel->setContentsMargins(8, 8, 8, 8);
-    emptyLabel->setStyleSheet("color: #666; font-size: 14px;");
-    mainLayout->addWidget(emptyLabel);
+    // 몰려 들어오는 알림은 프레임 간격마다 한 번에 반영
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(FlushIntervalMs);
+    connect(&flushTimer, &QTimer::timeout, this, &NotificationPanel::flushPending);
 
-    // 스크롤 영역에 컨테이너 설정
-    scrollArea->setWidget(container);
-    outerLayout->addWidget(scrollArea);
+    updateEmptyState();
 }
 
 NotificationPanel::~NotificationPanel() {}
 
-void NotificationPanel::handleMqttMessage(const QByteArray &message)
+void NotificationPanel::handleMqttEvents(const QList<MqttEvent> &events)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(message);
-    if (!doc.isObject()) return;
+    LatencyTracker &tracker = LatencyTracker::instance();
 
-    QJsonObject obj = doc.object();
-    int eventType = obj.value("event").toInt(-1);
+    // JSON/날짜는 네트워크 스레드에서 이미 해석됨
+    for (const MqttEvent &event : events) {
+        if (event.sentMs > 0)
+            tracker.record(LatencyTracker::MqttPublishToReceive, double(event.receivedMs - event.sentMs));
 
-    // 테스트 메시지 등 유효하지 않은 이벤트 타입 무시
-    if (eventType == -1)
-        return;
+        NotificationEntry entry;
+        entry.eventType  = event.eventType;
+        entry.date       = event.notifyDate;
+        entry.lastSeenMs = event.receivedMs;
+        pending.append(entry);
 
-    QString timestamp = obj.value("timestamp").toString();
-
-    // 시간 포맷 변환 (ISO8601 → yyyy-MM-dd HH:mm)
-    QDateTime dt = QDateTime::fromString(timestamp, Qt::ISODate);
-    QString formattedDate = dt.isValid() ? dt.toString("yyyy-MM-dd HH:mm") : timestamp;
+        if (pendingLatency.size() < MaxLatencySamples)
+            pendingLatency.append({event.sentMs, event.receivedMs});
+    }
 
-    addNotification(eventType, formattedDate);
+    if (!pending.isEmpty() && !flushTimer.isActive())
+        flushTimer.start();
 }
 
 void NotificationPanel::addNotification(int eventType, const QString &date)
 {
-    // 빈 상태 라벨 숨기기
-    if (emptyLabel) emptyLabel->hide();
+    NotificationEntry entry;
+    entry.eventType  = eventType;
+    entry.date       = date;
+    entry.lastSeenMs = QDateTime::currentMSecsSinceEpoch();
+    pending.append(entry);
+
+    if (!flushTimer.isActive())
+        flushTimer.start();
+}
+
+void NotificationPanel::flushPending()
+{
+    if (pending.isEmpty()) return;
+
+    struct Bump { int count = 0; QString date; qint64 lastSeenMs = 0; };
+    QMap<int, Bump>          bumps;        // 기존 행 → 반복 수신 누적
+    QHash<int, int>          freshIndex;   // 유형 → fresh 인덱스
+    QList<NotificationEntry> fresh;        // 새 행 (도착순)
+
+    for (const NotificationEntry &e : std::as_const(pending)) {
+        // 이번 묶음에 같은 유형이 있으면 합침
+        auto it = freshIndex.constFind(e.eventType);
+        if (it != freshIndex.constEnd() && e.lastSeenMs - fresh.at(*it).lastSeenMs <= CoalesceWindowMs) {
+            NotificationEntry &target = fresh[*it];
+            ++target.count;
+            target.date       = e.date;
+            target.lastSeenMs = e.lastSeenMs;
+            continue;
+        }
 
-    // 새 알림 아이템 생성
-    auto *item = new NotificationItem(eventType, date, container);
+        // 목록에 최근 같은 유형이 있으면 그 행의 횟수만 올림
+        const int row = model->findRecent(e.eventType, e.lastSeenMs, CoalesceWindowMs);
+        if (row >= 0 && !freshIndex.contains(e.eventType)) {
+            Bump &b = bumps[row];
+            ++b.count;
+            b.date       = e.date;
+            b.lastSeenMs = e.lastSeenMs;
+            continue;
+        }
 
-    // 알림 제거 요청 시그널 연결
-    connect(item, &NotificationItem::removeRequested,
-            this, &NotificationPanel::removeNotification);
+        freshIndex.insert(e.eventType, int(fresh.size()));
+        fresh.append(e);
+    }
+    pending.clear();
+
+    if (awaitingPaint.isEmpty())
+        awaitingPaint.swap(pendingLatency);
+    else
+        awaitingPaint.append(pendingLatency.mid(0, MaxLatencySamples - awaitingPaint.size()));
+    pendingLatency.clear();
+
+    // 작은 행부터 올려야 남은 행 번호가 바뀌지 않는다
+    for (auto it = bumps.cbegin(); it != bumps.cend(); ++it)
+        model->bump(it.key(), it->count, it->date, it->lastSeenMs);
+
+    // 새 행은 최신이 위로 오게 한 번에 추가
+    std::reverse(fresh.begin(), fresh.end());
+    model->prependBatch(fresh);
+
+    updateEmptyState();
 
-    // 새 알림을 맨 위에 추가
-    mainLayout->insertWidget(0, item);
-    
     // 스크롤을 맨 위로 이동 (새 알림이 보이도록)
-    scrollArea->verticalScrollBar()->setValue(0);
+    listView->scrollToTop();
 }
 
-void NotificationPanel::removeNotification(NotificationItem *item)
+void NotificationPanel::removeNotification(const QModelIndex &index)
 {
-    // 레이아웃에서 아이템 제거
-    mainLayout->removeWidget(item);
-    item->deleteLater();
-
-    // 남은 알림 아이템이 있는지 확인
-    bool hasItems = false;
-    for (int i = 0; i < mainLayout->count(); ++i) {
-        if (qobject_cast<NotificationItem*>(mainLayout->itemAt(i)->widget())) {
-            hasItems = true;
-            break;
-        }
+    model->removeEntry(index.row());
+    updateEmptyState();
+}
+
+void NotificationPanel::recordPaintLatency()
+{
+    if (awaitingPaint.isEmpty()) return;
+
+    LatencyTracker &tracker = LatencyTracker::instance();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const LatencySample &s : std::as_const(awaitingPaint)) {
+        tracker.record(LatencyTracker::MqttReceiveToPaint, double(now - s.receivedMs));
+        if (s.sentMs > 0)
+            tracker.record(LatencyTracker::MqttEndToEnd, double(now - s.sentMs));
     }
+    awaitingPaint.clear();
+}
 
+void NotificationPanel::updateEmptyState()
+{
     // 알림이 없으면 빈 상태 라벨 표시
-    if (!hasItems && emptyLabel) {
-        emptyLabel->show();
-    }
+    const bool empty = model->rowCount() == 0;
+    emptyLabel->setVisible(empty);
+    listView->setVisible(!empty);
 }
@@ -0,0 +1,426 @@
+// pdfreport.cpp
+#include "mainwindow/pdfreport.h"
+#include "mainwindow/imagefetchpool.h"
+#include <QBuffer>
+#include <QDateTime>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QDebug>
+
+namespace {
+
+constexpr int kItemsPerPage   = 3;
+constexpr int kResolution     = 300;   // dpi
+constexpr int kConnections    = 3;
+constexpr int kPipelineDepth  = 4;
+constexpr int kMaxBuffered    = 32;    // 받아 둔 이미지 + 쓰기 대기 건수 상한
+constexpr int kResumeBuffered = 8;
+
+bool hasImage(const QString &path)
+{
+    return !path.isEmpty() && path != "-";
+}
+
+// 레코드가 참조하는 이미지 경로 (촬영 → 정차 시작 → 1분 경과 순)
+QStringList imagePaths(const HistoryRecord &rec)
+{
+    QStringList paths;
+    for (const QString &p : {rec.imagePath, rec.startSnapshot, rec.endSnapshot}) {
+        if (hasImage(p))
+            paths.append(p);
+    }
+    return paths;
+}
+
+QRect fitRect(const QSize &image, const QRect &area)
+{
+    const QSize scaled = image.scaled(area.size(), Qt::KeepAspectRatio);
+    return QRect(area.x() + (area.width() - scaled.width()) / 2,
+                 area.y() + (area.height() - scaled.height()) / 2,
+                 scaled.width(), scaled.height());
+}
+
+} // namespace
+
+ReportItem ReportItem::fromRecord(const HistoryRecord &rec)
+{
+    static const QStringList typeNames = {"주정차감지","과속감지","보행자감지"};
+    const int et = rec.eventType;
+
+    ReportItem item;
+    item.eventName = (et >= 0 && et < typeNames.size()) ? typeNames[et] : QString::number(et);
+    item.time      = rec.displayTime;
+    item.plate     = rec.plateNumber;
+    item.speed     = rec.hasSpeed ? QString::number(rec.speed, 'f', 2) : QString("-");
+    return item;
+}
+
+// ---------------------------------------------------------------------------
+// PdfReportWriter
+
+PdfReportWriter::PdfReportWriter(const QString &path, const QString &title)
+    : path_(path), title_(title)
+{
+}
+
+PdfReportWriter::~PdfReportWriter()
+{
+    if (painter_ && painter_->isActive())
+        painter_->end();
+}
+
+bool PdfReportWriter::begin()
+{
+    writer_ = std::make_unique<QPdfWriter>(path_);
+    writer_->setPageSize(QPageSize::A4);
+    writer_->setPageMargins(QMarginsF(15, 15, 15, 15), QPageLayout::Millimeter);
+    writer_->setResolution(kResolution);
+    writer_->setTitle(title_);
+    writer_->setCreator(QStringLiteral("QuadQT"));
+
+    painter_ = std::make_unique<QPainter>();
+    if (!painter_->begin(writer_.get())) {
+        error_ = QStringLiteral("PDF 파일을 열 수 없습니다: %1").arg(path_);
+        return false;
+    }
+    painter_->setRenderHint(QPainter::SmoothPixmapTransform);
+    slot_ = kItemsPerPage;   // 첫 항목에서 페이지 머리말을 그린다
+    return true;
+}
+
+void PdfReportWriter::startPage()
+{
+    if (pageCount_ > 0)
+        writer_->newPage();
+    ++pageCount_;
+    slot_ = 0;
+
+    QPainter &p = *painter_;
+    // QPainter 원점은 여백 안쪽 좌상단
+    const QRect page(QPoint(0, 0), writer_->pageLayout().paintRectPixels(kResolution).size());
+
+    QFont titleFont = p.font();
+    titleFont.setPointSize(14);
+    titleFont.setBold(true);
+    p.setFont(titleFont);
+    p.setPen(Qt::black);
+    const int headerH = p.fontMetrics().height() * 2;
+    p.drawText(QRect(page.left(), page.top(), page.width(), headerH),
+               Qt::AlignLeft | Qt::AlignVCenter, title_);
+
+    QFont small = p.font();
+    small.setPointSize(8);
+    small.setBold(false);
+    p.setFont(small);
+    p.drawText(QRect(page.left(), page.top(), page.width(), headerH),
+               Qt::AlignRight | Qt::AlignVCenter,
+               QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm 작성"));
+    p.drawLine(page.left(), page.top() + headerH, page.right(), page.top() + headerH);
+
+    const int footerH = p.fontMetrics().height() * 2;
+    p.drawText(QRect(page.left(), page.bottom() - footerH, page.width(), footerH),
+               Qt::AlignCenter, QString("- %1 -").arg(pageCount_));
+
+    body_ = QRect(page.left(), page.top() + headerH + footerH / 2,
+                  page.width(), page.height() - headerH - footerH * 3 / 2);
+}
+
+bool PdfReportWriter::addItem(const ReportItem &item)
+{
+    if (!painter_ || !painter_->isActive())
+        return false;
+    if (slot_ >= kItemsPerPage)
+        startPage();
+
+    const int slotH = body_.height() / kItemsPerPage;
+    drawItem(QRect(body_.left(), body_.top() + slot_ * slotH, body_.width(), slotH), item);
+    ++slot_;
+    return true;
+}
+
+void PdfReportWriter::drawItem(const QRect &slot, const ReportItem &item)
+{
+    QPainter &p = *painter_;
+    const int gap = slot.height() / 30;
+    const QRect inner = slot.adjusted(0, gap, 0, -gap);
+
+    // 정보 한 줄: 유형 / 일시 / 번호판 / 속도
+    QFont font = p.font();
+    font.setPointSize(10);
+    font.setBold(true);
+    p.setFont(font);
+    const int lineH = p.fontMetrics().height() * 3 / 2;
+    QString info = QString("[%1]   일시 %2   번호판 %3").arg(item.eventName, item.time, item.plate);
+    if (item.speed != "-")
+        info += QString("   속도 %1 km/h").arg(item.speed);
+    p.drawText(QRect(inner.left(), inner.top(), inner.width(), lineH),
+               Qt::AlignLeft | Qt::AlignVCenter, info);
+
+    // 있는 이미지만 가로로 나눠 배치
+    QList<QPair<QString, QByteArray>> images;
+    if (!item.image.isNull())      images.append({"촬영 이미지", item.image});
+    if (!item.startImage.isNull()) images.append({"정차 시작", item.startImage});
+    if (!item.endImage.isNull())   images.append({"1분 경과", item.endImage});
+
+    const QRect area(inner.left(), inner.top() + lineH, inner.width(), inner.height() - lineH);
+    if (!images.isEmpty()) {
+        const int colW = area.width() / int(images.size());
+        for (int i = 0; i < images.size(); ++i) {
+            const QRect cell(area.left() + i * colW, area.top(), colW, area.height());
+            drawImage(cell.adjusted(gap / 2, 0, -gap / 2, 0), images[i].second, images[i].first);
+        }
+    }
+
+    p.setPen(QColor("#cccccc"));
+    p.drawLine(slot.left(), slot.bottom(), slot.right(), slot.bottom());
+    p.setPen(Qt::black);
+}
+
+void PdfReportWriter::drawImage(const QRect &area, const QByteArray &data, const QString &caption)
+{
+    QPainter &p = *painter_;
+    QFont font = p.font();
+    font.setPointSize(8);
+    font.setBold(false);
+    p.setFont(font);
+    const int captionH = p.fontMetrics().height() * 3 / 2;
+    const QRect imageArea = area.adjusted(0, 0, 0, -captionH);
+    p.drawText(QRect(area.left(), area.bottom() - captionH, area.width(), captionH),
+               Qt::AlignCenter, caption);
+
+    // 원본 해상도 그대로 디코딩해 넣는다 (PDF 안에서 축소 표시)
+    QImage image;
+    if (!data.isEmpty()) {
+        QBuffer buffer;
+        buffer.setData(data);
+        QImageReader reader(&buffer);
+        reader.setAutoTransform(true);
+        image = reader.read();
+    }
+    if (image.isNull()) {
+        p.setPen(QColor("#999999"));
+        p.drawRect(imageArea);
+        p.drawText(imageArea, Qt::AlignCenter, "이미지 없음");
+        p.setPen(Qt::black);
+        return;
+    }
+    p.drawImage(fitRect(image.size(), imageArea), image);
+}
+
+bool PdfReportWriter::finish()
+{
+    if (!painter_ || !painter_->isActive())
+        return false;
+    if (pageCount_ == 0)
+        startPage();   // 빈 보고서도 머리말 한 페이지는 남긴다
+    if (!painter_->end()) {
+        error_ = QStringLiteral("PDF 파일을 완료하지 못했습니다: %1").arg(path_);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// PdfReportExporter
+
+PdfReportExporter::PdfReportExporter(QObject *parent)
+    : QObject(parent),
+      pool_(new ImageFetchPool(this)),
+      writerContext_(new QObject)
+{
+    pool_->setConcurrency(kConnections, kPipelineDepth);
+    connect(pool_, &ImageFetchPool::imageFetched, this, &PdfReportExporter::onImageResolved);
+    connect(pool_, &ImageFetchPool::imageFailed, this, [this](const QString &path, const QString &error) {
+        qWarning() << "[PdfReportExporter] 이미지 수신 실패:" << path << error;
+        onImageResolved(path, QByteArray(""));   // 빈(그러나 null 아닌) 값 = 실패 표시
+    });
+
+    writerThread_.setObjectName("PdfReportWriter");
+    writerContext_->moveToThread(&writerThread_);
+    connect(&writerThread_, &QThread::finished, writerContext_, &QObject::deleteLater);
+    writerThread_.start();
+}
+
+PdfReportExporter::~PdfReportExporter()
+{
+    if (running_)
+        stopWriter();
+    writerThread_.quit();
+    writerThread_.wait();
+    delete writer_;
+}
+
+void PdfReportExporter::start(const QString &pdfPath, const QList<HistoryRecord> &records,
+                              const QString &host, quint16 port)
+{
+    if (running_)
+        return;
+
+    records_ = records;
+    refs_.clear();
+    resolved_.clear();
+    path_    = pdfPath;
+    next_    = 0;
+    written_ = 0;
+    backlog_ = 0;
+    running_ = true;
+    const int job = ++job_;
+
+    // 레코드 순서대로 한 번씩만 요청 (앞 레코드의 이미지가 먼저 도착하도록)
+    QStringList paths;
+    for (const HistoryRecord &rec : std::as_const(records_)) {
+        for (const QString &p : imagePaths(rec)) {
+            if (refs_[p]++ == 0)
+                paths.append(p);
+        }
+    }
+
+    QMetaObject::invokeMethod(writerContext_, [this, job, pdfPath]() {
+        writer_ = new PdfReportWriter(pdfPath, QStringLiteral("단속 이력 보고서"));
+        if (!writer_->begin()) {
+            const QString error = writer_->errorString();
+            QMetaObject::invokeMethod(this, [this, job, error]() {
+                onItemWritten(job, false, error);
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+
+    emit progressChanged(0, int(records_.size()));
+    if (records_.isEmpty()) {
+        finishReport();
+        return;
+    }
+    if (!paths.isEmpty()) {
+        pool_->setServer(host, port);
+        pool_->fetch(paths);
+    }
+    dispatchReady();
+}
+
+void PdfReportExporter::cancel()
+{
+    if (!running_)
+        return;
+    stopWriter();
+    emit canceled();
+}
+
+void PdfReportExporter::stopWriter()
+{
+    running_ = false;
+    pool_->cancel();
+    resolved_.clear();
+    QMetaObject::invokeMethod(writerContext_, [this]() {
+        delete writer_;   // 완료하지 않은 PDF 는 남기지 않는다
+        writer_ = nullptr;
+    }, Qt::QueuedConnection);
+    // QPdfWriter 는 임시 파일을 쓰지 않으므로 미완성 파일을 지운다
+    QMetaObject::invokeMethod(writerContext_, [path = path_]() {
+        QFile::remove(path);
+    }, Qt::QueuedConnection);
+}
+
+void PdfReportExporter::onImageResolved(const QString &path, const QByteArray &data)
+{
+    if (!running_)
+        return;
+    resolved_.insert(path, data);
+    dispatchReady();
+}
+
+void PdfReportExporter::dispatchReady()
+{
+    const int job = job_;
+    while (next_ < records_.size()) {
+        const HistoryRecord &rec = records_.at(next_);
+        const QStringList paths = imagePaths(rec);
+        bool ready = true;
+        for (const QString &p : paths) {
+            if (!resolved_.contains(p)) {
+                ready = false;
+                break;
+            }
+        }
+        if (!ready)
+            break;
+
+        ReportItem item = ReportItem::fromRecord(rec);
+        auto take = [this](const QString &p) -> QByteArray {
+            if (!hasImage(p))
+                return QByteArray();
+            const QByteArray data = resolved_.value(p);
+            if (--refs_[p] == 0) {
+                refs_.remove(p);
+                resolved_.remove(p);
+            }
+            return data;
+        };
+        item.image      = take(rec.imagePath);
+        item.startImage = take(rec.startSnapshot);
+        item.endImage   = take(rec.endSnapshot);
+        ++next_;
+        ++backlog_;
+
+        QMetaObject::invokeMethod(writerContext_, [this, job, item]() {
+            const bool ok = writer_ && writer_->addItem(item);
+            const QString error = writer_ ? writer_->errorString() : QString();
+            QMetaObject::invokeMethod(this, [this, job, ok, error]() {
+                onItemWritten(job, ok, error);
+            }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+    }
+    updateFlowControl();
+}
+
+void PdfReportExporter::updateFlowControl()
+{
+    const qsizetype buffered = resolved_.size() + backlog_;
+    if (buffered >= kMaxBuffered)
+        pool_->pause();
+    else if (buffered <= kResumeBuffered)
+        pool_->resume();
+}
+
+void PdfReportExporter::onItemWritten(int job, bool ok, const QString &error)
+{
+    if (job != job_ || !running_)
+        return;
+    if (!ok) {
+        stopWriter();
+        emit failed(error.isEmpty() ? QStringLiteral("PDF 작성 실패") : error);
+        return;
+    }
+
+    --backlog_;
+    ++written_;
+    emit progressChanged(written_, int(records_.size()));
+    updateFlowControl();
+
+    if (written_ == int(records_.size()))
+        finishReport();
+}
+
+void PdfReportExporter::finishReport()
+{
+    const int job = job_;
+    QMetaObject::invokeMethod(writerContext_, [this, job]() {
+        const bool done = writer_ && writer_->finish();
+        const int pages = writer_ ? writer_->pageCount() : 0;
+        const QString error = writer_ ? writer_->errorString() : QString();
+        delete writer_;
+        writer_ = nullptr;
+        QMetaObject::invokeMethod(this, [this, job, done, pages, error]() {
+            if (job != job_ || !running_)
+                return;
+            running_ = false;
+            if (done)
+                emit finished(path_, written_, pages);
+            else
+                emit failed(error);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,276 @@
+// platesearchindex.cpp
+#include "mainwindow/platesearchindex.h"
+#include <algorithm>
+
+namespace {
+
+constexpr char16_t kHangulBase  = 0xAC00;
+constexpr char16_t kHangulLast  = 0xD7A3;
+constexpr int      kMedialCount = 21;
+constexpr int      kFinalCount  = 28;
+
+// 모양이 비슷해 OCR 이 자주 틀리는 중성을 하나로 (ㅓ→ㅏ, ㅔ→ㅐ, ㅕ→ㅑ, ㅜ→ㅗ, ㅠ→ㅛ)
+constexpr int kMedialFold[kMedialCount] = {
+    0, 1, 2, 3, 0, 1, 2, 7, 8, 9, 10, 11, 12, 8, 14, 15, 16, 12, 18, 19, 20
+};
+
+QString reversedString(const QString &s)
+{
+    QString r(s.size(), Qt::Uninitialized);
+    std::reverse_copy(s.cbegin(), s.cend(), r.begin());
+    return r;
+}
+
+} // namespace
+
+QString PlateSearchIndex::fold(const QString &plate)
+{
+    QString out;
+    out.reserve(plate.size());
+    for (QChar ch : plate) {
+        char16_t c = ch.unicode();
+        if (ch.isSpace() || c == '-' || c == '.' || c == '_')
+            continue;
+
+        if (c >= kHangulBase && c <= kHangulLast) {
+            const int idx     = c - kHangulBase;
+            const int initial = idx / (kMedialCount * kFinalCount);
+            const int medial  = (idx / kFinalCount) % kMedialCount;
+            const int final_  = idx % kFinalCount;
+            out += QChar(char16_t(kHangulBase
+                                  + (initial * kMedialCount + kMedialFold[medial]) * kFinalCount
+                                  + final_));
+            continue;
+        }
+
+        if (c < 0x80)
+            c = QChar::toUpper(c);
+        switch (c) {
+        case 'O': case 'D': case 'Q':   c = '0'; break;
+        case 'I': case 'L': case '|':   c = '1'; break;
+        case 'Z':                       c = '2'; break;
+        case 'S':                       c = '5'; break;
+        case 'G':                       c = '6'; break;
+        case 'B':                       c = '8'; break;
+        default: break;
+        }
+        out += QChar(c);
+    }
+    return out;
+}
+
+void PlateSearchIndex::clear()
+{
+    entryByKey_.clear();
+    keys_.clear();
+    reversed_.clear();
+    ids_.clear();
+    byKey_.clear();
+    byReversed_.clear();
+    bigrams_.clear();
+    sortedCount_ = 0;
+}
+
+void PlateSearchIndex::add(int id, const QString &plate)
+{
+    const QString key = fold(plate);
+    if (key.isEmpty())
+        return;
+
+    auto it = entryByKey_.constFind(key);
+    if (it != entryByKey_.constEnd()) {
+        ids_[it.value()].append(id);
+        return;
+    }
+
+    // 새 키는 정렬 배열에 바로 넣지 않고 다음 검색 때 한꺼번에 병합
+    const int entry = int(keys_.size());
+    entryByKey_.insert(key, entry);
+    keys_.append(key);
+    reversed_.append(reversedString(key));
+    ids_.append(QList<int>{id});
+
+    // 항목 번호는 늘어나기만 하므로 목록은 그대로 정렬 상태. 같은 조각이 두 번 나오면 한 번만
+    for (qsizetype i = 0; i + 1 < key.size(); ++i) {
+        QList<int> &posting = bigrams_[bigramKey(key.at(i), key.at(i + 1))];
+        if (posting.isEmpty() || posting.constLast() != entry)
+            posting.append(entry);
+    }
+}
+
+void PlateSearchIndex::ensureSorted()
+{
+    const qsizetype total = keys_.size();
+    if (sortedCount_ == total)
+        return;
+
+    auto mergeInto = [&](QList<int> &order, const QList<QString> &keys) {
+        auto less = [&keys](int a, int b) { return keys.at(a) < keys.at(b); };
+        const qsizetype oldSize = order.size();
+        order.reserve(total);
+        for (qsizetype e = sortedCount_; e < total; ++e)
+            order.append(int(e));
+        std::sort(order.begin() + oldSize, order.end(), less);
+        std::inplace_merge(order.begin(), order.begin() + oldSize, order.end(), less);
+    };
+    mergeInto(byKey_, keys_);
+    mergeInto(byReversed_, reversed_);
+    sortedCount_ = total;
+}
+
+QList<int> PlateSearchIndex::entriesWithPrefix(const QList<int> &order, const QList<QString> &keys,
+                                               const QString &prefix) const
+{
+    QList<int> entries;
+    auto it = std::lower_bound(order.cbegin(), order.cend(), prefix,
+                               [&keys](int e, const QString &p) { return keys.at(e) < p; });
+    for (; it != order.cend() && keys.at(*it).startsWith(prefix); ++it)
+        entries.append(*it);
+    return entries;
+}
+
+void PlateSearchIndex::appendIds(const QList<int> &entries, QList<int> &out) const
+{
+    for (int e : entries)
+        out.append(ids_.at(e));
+}
+
+QList<int> PlateSearchIndex::prefixMatches(const QString &prefix)
+{
+    const QString key = fold(prefix);
+    QList<int> out;
+    if (key.isEmpty())
+        return out;
+    ensureSorted();
+    appendIds(entriesWithPrefix(byKey_, keys_, key), out);
+    return out;
+}
+
+QList<int> PlateSearchIndex::suffixMatches(const QString &suffix)
+{
+    const QString key = fold(suffix);
+    QList<int> out;
+    if (key.isEmpty())
+        return out;
+    ensureSorted();
+    appendIds(entriesWithPrefix(byReversed_, reversed_, reversedString(key)), out);
+    return out;
+}
+
+QList<int> PlateSearchIndex::infixEntries(const QString &folded) const
+{
+    QList<int> entries;
+    if (folded.size() < 2) {
+        // 한 글자는 조각이 없으므로 키 전체를 훑는다 (키 수는 레코드 수보다 훨씬 적음)
+        for (qsizetype e = 0; e < keys_.size(); ++e) {
+            if (keys_.at(e).contains(folded))
+                entries.append(int(e));
+        }
+        return entries;
+    }
+
+    // 질의의 모든 조각을 가져야 하므로 가장 짧은 목록만 후보로 삼고 실제 포함 여부로 거른다
+    const QList<int> *shortest = nullptr;
+    for (qsizetype i = 0; i + 1 < folded.size(); ++i) {
+        auto it = bigrams_.constFind(bigramKey(folded.at(i), folded.at(i + 1)));
+        if (it == bigrams_.constEnd())
+            return entries;
+        if (!shortest || it->size() < shortest->size())
+            shortest = &it.value();
+    }
+    for (int e : *shortest) {
+        if (keys_.at(e).contains(folded))
+            entries.append(e);
+    }
+    return entries;
+}
+
+QList<int> PlateSearchIndex::infixMatches(const QString &text)
+{
+    QList<int> out;
+    const QString key = fold(text);
+    if (key.isEmpty())
+        return out;
+    appendIds(infixEntries(key), out);
+    return out;
+}
+
+QList<int> PlateSearchIndex::fuzzyEntries(const QString &folded)
+{
+    QList<int> entries;
+    const qsizetype len = folded.size();
+    if (len < 2)
+        return entries;
+    ensureSorted();
+
+    // 편집이 뒤쪽 절반에 있으면 앞쪽 절반이, 앞쪽 절반에 있으면 뒤쪽 절반이 그대로 남는다
+    const qsizetype half = len / 2;
+    QList<int> candidates = entriesWithPrefix(byKey_, keys_, folded.left(half));
+    candidates += entriesWithPrefix(byReversed_, reversed_, reversedString(folded.mid(half)));
+
+    QSet<int> seen;
+    for (int e : std::as_const(candidates)) {
+        if (seen.contains(e))
+            continue;
+        seen.insert(e);
+        if (withinOneEdit(keys_.at(e), folded))
+            entries.append(e);
+    }
+    return entries;
+}
+
+QList<int> PlateSearchIndex::fuzzyMatches(const QString &plate)
+{
+    QList<int> out;
+    appendIds(fuzzyEntries(fold(plate)), out);
+    return out;
+}
+
+QSet<int> PlateSearchIndex::search(const QString &text)
+{
+    const QString key = fold(text);
+    QSet<int> out;
+    if (key.isEmpty())
+        return out;
+
+    // 중간 일치는 앞/뒷부분 일치를 포함한다
+    QList<int> entries = infixEntries(key);
+    // 짧은 입력은 편집 거리 1 로 거의 모든 번호판이 걸리므로 제외
+    if (key.size() >= 4)
+        entries += fuzzyEntries(key);
+
+    for (int e : std::as_const(entries)) {
+        for (int id : ids_.at(e))
+            out.insert(id);
+    }
+    return out;
+}
+
+bool PlateSearchIndex::matches(const QString &plate, const QString &text)
+{
+    const QString key = fold(text);
+    if (key.isEmpty())
+        return false;
+    const QString folded = fold(plate);
+    return folded.contains(key) || (key.size() >= 4 && withinOneEdit(folded, key));
+}
+
+bool PlateSearchIndex::withinOneEdit(const QString &a, const QString &b)
+{
+    const qsizetype la = a.size();
+    const qsizetype lb = b.size();
+    if (qAbs(la - lb) > 1)
+        return false;
+
+    const QString &s = (la <= lb) ? a : b;   // 짧은 쪽
+    const QString &l = (la <= lb) ? b : a;
+    qsizetype i = 0;
+    while (i < s.size() && s.at(i) == l.at(i))
+        ++i;
+    if (i == s.size())
+        return true;                          // 끝에 한 글자 추가 또는 동일
+
+    if (s.size() == l.size())                 // 치환: 나머지가 같아야 함
+        return QStringView(s).mid(i + 1) == QStringView(l).mid(i + 1);
+    return QStringView(s).mid(i) == QStringView(l).mid(i + 1);   // 삽입
+}
@@ -1,4 +1,5 @@
 #include "mainwindow/procsettingbox.h"
+#include "mainwindow/iconcache.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
@@ -12,6 +13,36 @@
 #include <algorithm>
 #include <QEvent>
 
+namespace {
+
+// 두 상태를 모두 담은 스타일시트. 한 번만 만들고 상태는 속성/활성화 여부로 바꾼다
+const QString &sliderStyle()
+{
+    static const QString style = R"(
+        QSlider::groove:horizontal { background: #ddd; height: 8px; border-radius: 4px; }
+        QSlider::handle:horizontal {
+            background: #F37321; width: 18px; height: 18px;
+            margin: -6px 0; border-radius: 9px;
+        }
+        QSlider::sub-page:horizontal { background: #F37321; border-radius: 4px; }
+        QSlider::add-page:horizontal { background: #FFFFFF; border-radius: 4px; }
+        QSlider::groove:horizontal:disabled { background: #ccc; }
+        QSlider::handle:horizontal:disabled { background: #ccc; }
+        QSlider::sub-page:horizontal:disabled { background: #ccc; }
+    )";
+    return style;
+}
+
+const QString &modeLabelStyle()
+{
+    static const QString style =
+        "QLabel { font-size: 14px; color: gray; padding-bottom: 4px; border: none; background: transparent; }"
+        "QLabel[active=\"true\"] { color: #F37321; }";
+    return style;
+}
+
+} // namespace
+
 ProcSettingBox::ProcSettingBox(QWidget *parent)
     : QWidget(parent)
 {
@@ -24,27 +55,6 @@ ProcSettingBox::ProcSettingBox(QWidget *parent)
 void ProcSettingBox::setupUI()
 {
     QString radioStyle = "margin: 4px 0 0 4px; background: transparent; border: none;";
-    sliderStyleGray = R"(
-        QSlider::groove:horizontal { background: #ccc; height: 8px; border-radius: 4px; }
-        QSlider::handle:horizontal {
-            background: #ccc; width: 18px; height: 18px;
-            margin: -6px 0; border-radius: 9px;
-        }
-        QSlider::sub-page:horizontal { background: #ccc; border-radius: 4px; }
-        QSlider::add-page:horizontal { background: #FFFFFF; border-radius: 4px; }
-    )";
-    sliderStyleOrange = R"(
-        QSlider::groove:horizontal { background: #ddd; height: 8px; border-radius: 4px; }
-        QSlider::handle:horizontal {
-            background: #F37321; width: 18px; height: 18px;
-            margin: -6px 0; border-radius: 9px;
-        }
-        QSlider::sub-page:horizontal { background: #F37321; border-radius: 4px; }
-        QSlider::add-page:horizontal { background: #FFFFFF; border-radius: 4px; }
-    )";
-
-    textStyleGray = "font-size: 14px; color: gray; padding-bottom: 4px; border: none; background: transparent;";
-    textStyleOrange = "font-size: 14px; color: #F37321; padding-bottom: 4px; border: none; background: transparent;";
 
     modeGroup = new QButtonGroup(this);
     modeGroup->setExclusive(false);  // allow manual exclusive behavior
@@ -89,7 +99,7 @@ QWidget* ProcSettingBox::createModeBox(const QString &text, QRadioButton *&radio
 
     label = new QLabel(text, box);
     label->setAlignment(Qt::AlignHCenter | Qt::AlignBottom);
-    label->setStyleSheet(textStyleGray);
+    label->setStyleSheet(modeLabelStyle());
 
     layout->addWidget(radio, 0, Qt::AlignLeft | Qt::AlignTop);
     layout->addStretch();
@@ -125,6 +135,7 @@ QWidget* ProcSettingBox::createSharpnessBox()
     sharpnessSlider->setMinimum(0);
     sharpnessSlider->setMaximum(100);
     sharpnessSlider->setValue(50);
+    sharpnessSlider->setStyleSheet(sliderStyle());   // 꺼져 있으면(:disabled) 회색
 
     plusButton = new QPushButton(controlWidget);
     plusButton->setFixedSize(24, 24);
@@ -142,7 +153,7 @@ QWidget* ProcSettingBox::createSharpnessBox()
 
     sharpnessLabel = new QLabel("선명도 (%)", box);
     sharpnessLabel->setAlignment(Qt::AlignHCenter | Qt::AlignBottom);
-    sharpnessLabel->setStyleSheet(textStyleGray);
+    sharpnessLabel->setStyleSheet(modeLabelStyle());
 
     layout->addWidget(sharpnessRadio, 0, Qt::AlignLeft | Qt::AlignTop);
     layout->addStretch();
@@ -204,31 +215,21 @@ void ProcSettingBox::updateModeUI()
     bool isNight = nightRadio->isChecked();
     bool isSharpness = sharpnessRadio->isChecked();
 
-    QString minusIcon = isSharpness ? ":/images/minus_orange.png" : ":/images/minus_gray.png";
-    QString plusIcon = isSharpness ? ":/images/plus_orange.png" : ":/images/plus_gray.png";
-    minusButton->setIcon(QIcon(minusIcon));
+    // 아이콘/축소본은 IconCache 가 한 번만 읽고 만든다
+    minusButton->setIcon(IconCache::icon(isSharpness ? ":/images/minus_orange.png" : ":/images/minus_gray.png"));
     minusButton->setIconSize(QSize(20, 20));
-    plusButton->setIcon(QIcon(plusIcon));
+    plusButton->setIcon(IconCache::icon(isSharpness ? ":/images/plus_orange.png" : ":/images/plus_gray.png"));
     plusButton->setIconSize(QSize(20, 20));
 
-    // 주간모드 아이콘 (80% 크기로 조정)
-    QPixmap dayPixmap(isDay ? ":/images/sun_orange.png" : ":/images/sun_gray.png");
-    int dayScaledWidth = dayPixmap.width() * 0.6;
-    int dayScaledHeight = dayPixmap.height() * 0.6;
-    dayIcon->setPixmap(dayPixmap.scaled(dayScaledWidth, dayScaledHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    
-    // 야간모드 아이콘 (80% 크기로 조정)
-    QPixmap nightPixmap(isNight ? ":/images/moon_orange.png" : ":/images/moon_gray.png");
-    int nightScaledWidth = nightPixmap.width() * 0.6;
-    int nightScaledHeight = nightPixmap.height() * 0.6;
-    nightIcon->setPixmap(nightPixmap.scaled(nightScaledWidth, nightScaledHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-
-    dayLabel->setStyleSheet(isDay ? textStyleOrange : textStyleGray);
-    nightLabel->setStyleSheet(isNight ? textStyleOrange : textStyleGray);
-    sharpnessLabel->setStyleSheet(isSharpness ? textStyleOrange : textStyleGray);
+    // 주간/야간 모드 아이콘 (원본의 60%)
+    dayIcon->setPixmap(IconCache::scaledBy(isDay ? ":/images/sun_orange.png" : ":/images/sun_gray.png", 0.6));
+    nightIcon->setPixmap(IconCache::scaledBy(isNight ? ":/images/moon_orange.png" : ":/images/moon_gray.png", 0.6));
+
+    StyleState::set(dayLabel, "active", isDay);
+    StyleState::set(nightLabel, "active", isNight);
+    StyleState::set(sharpnessLabel, "active", isSharpness);
 
     sharpnessSlider->setEnabled(isSharpness);
-    sharpnessSlider->setStyleSheet(isSharpness ? sliderStyleOrange : sliderStyleGray);
 }
 
 bool ProcSettingBox::eventFilter(QObject *watched, QEvent *event)
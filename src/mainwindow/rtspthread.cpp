@@ -1,6 +1,8 @@
 #include "mainwindow/rtspthread.h"
+#include "mainwindow/latencytracker.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/logging.h"
 #include <opencv2/opencv.hpp>
-#include <QDebug>
 
 RtspThread::RtspThread(const QString& url, QObject *parent)
     : QThread(parent), m_url(url), m_running(true)
@@ -29,7 +31,7 @@ void RtspThread::run()
         
         // RTSPS (RTSP over SSL) 연결을 위한 SSL 인증서 환경 변수 설정
         if (m_url.startsWith("rtsps://")) {
-            qDebug() << "[RTSP] RTSPS 보안 연결을 위한 SSL 설정";
+            qCDebug(lcRtsp) << "RTSPS 보안 연결을 위한 SSL 설정";
             qputenv("SSL_CERT_FILE", "ca.cert.pem");
             qputenv("SSL_CERT_DIR", ".");
             // 클라이언트 인증서 설정 (상호 인증 필요 시)
@@ -39,34 +41,40 @@ void RtspThread::run()
 
         // RTSP 스트림 연결 시도
         if (!cap.open(m_url.toStdString(), cv::CAP_FFMPEG)) {
-            qWarning() << "[RTSP] 스트림 연결 실패:" << m_url;
+            qCWarning(lcRtsp) << "스트림 연결 실패:" << m_url;
             msleep(1000);  // 1초 대기 후 재시도
             continue;
         }
 
-        qDebug() << "[RTSP] 스트림 연결 성공:" << m_url;
+        qCDebug(lcRtsp) << "스트림 연결 성공:" << m_url;
         m_refreshTimer.restart();  // 연결 성공 시 타이머 재시작
 
         cv::Mat frame;
         while (m_running) {
             // 7초마다 스트림 새로고침 (연결 안정성 향상)
             if (m_refreshTimer.elapsed() >= REFRESH_INTERVAL_MS) {
-                qDebug() << "[RTSP] 스트림 새로고침 (7초 주기)";
+                qCDebug(lcRtsp) << "스트림 새로고침 (7초 주기)";
                 cap.release();
                 break;  // 내부 루프 종료하여 재연결
             }
 
             // 프레임 읽기
+            const qint64 readStartUs = MetricsRegistry::start();
             cap >> frame;
             if (frame.empty()) {
+                MetricsRegistry::add(MetricsRegistry::RtspReadFailures);
                 msleep(10);  // 다음 프레임 대기
                 continue;
             }
+            const qint64 captureUs = LatencyTracker::nowUs();  // 지연 측정 기준 시각
 
             // OpenCV BGR 형식을 Qt RGB 형식으로 변환
             cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
             QImage image(frame.data, frame.cols, frame.rows, frame.step, QImage::Format_RGB888);
-            emit frameReady(image.copy());  // 프레임 준비 완료 시그널 발생
+            QImage copy = image.copy();
+            MetricsRegistry::finish(MetricsRegistry::RtspDecode, readStartUs);
+            MetricsRegistry::add(MetricsRegistry::RtspFrames);
+            emit frameReady(copy, captureUs);  // 프레임 준비 완료 시그널 발생
 
             msleep(10);  // CPU 사용률 조절
         }
@@ -74,5 +82,5 @@ void RtspThread::run()
         cap.release();
     }
 
-    qDebug() << "[RTSP] 스레드 종료";
+    qCDebug(lcRtsp) << "스레드 종료";
 }
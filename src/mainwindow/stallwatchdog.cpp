@@ -0,0 +1,334 @@
+// stallwatchdog.cpp
+#include "mainwindow/stallwatchdog.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/metricsregistry.h"
+#include <QCoreApplication>
+#include <QEvent>
+#include <QFileInfo>
+#include <QMetaEnum>
+#include <QThread>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iterator>
+#include <utility>
+
+// 다른 스레드(GUI)의 스택을 얻는 방법
+//  - glibc: 신호를 보내 GUI 스레드가 처리기 안에서 직접 backtrace()
+//  - Windows x64: GUI 스레드를 잠깐 멈추고 문맥에서 RtlVirtualUnwind 로 되감기
+//  - 그 외: 스택 없이 구간/이벤트만 기록
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#  define STALL_STACK_SIGNAL
+#  include <execinfo.h>
+#  include <pthread.h>
+#  include <signal.h>
+#elif defined(Q_OS_WIN) && defined(Q_PROCESSOR_X86_64)
+#  define STALL_STACK_SUSPEND
+#  include <windows.h>
+#endif
+
+namespace {
+
+constexpr int PollMs        = 20;   // 감시 스레드 확인 주기
+constexpr int SampleWaitMs  = 50;   // 신호 처리기가 스택을 채우기를 기다리는 시간
+constexpr int ReportFrames  = 12;   // 보고서에 붙이는 프레임 수
+
+StallWatchdog *g_instance = nullptr;
+
+#if defined(STALL_STACK_SIGNAL)
+// 처리기 프레임과 신호 복귀 프레임 2개를 더 받는다
+constexpr int SignalSkipFrames = 2;
+constexpr int SampleSignal     = SIGUSR2;
+
+void            *g_frames[StallWatchdog::MaxFrames + SignalSkipFrames];
+std::atomic<int> g_frameCount{-1};
+pthread_t        g_guiThread;
+struct sigaction g_previousAction;
+
+void sampleSignalHandler(int)
+{
+    const int savedErrno = errno;
+    g_frameCount.store(backtrace(g_frames, int(std::size(g_frames))), std::memory_order_release);
+    errno = savedErrno;
+}
+#elif defined(STALL_STACK_SUSPEND)
+HANDLE  g_guiThread = nullptr;
+DWORD64 g_guiStackBase = 0;     // GUI 스레드 스택의 가장 높은 주소 (TEB, 생성 시 읽음)
+
+// MinGW 빌드는 DWARF 디버그 정보라 dbghelp 로 함수 이름을 얻지 못한다.
+// 모듈+오프셋으로 남기고 addr2line -e <모듈> <오프셋> 으로 푼다.
+QString describeAddress(DWORD64 pc)
+{
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            reinterpret_cast<LPCWSTR>(pc), &module))
+        return QStringLiteral("0x%1").arg(pc, 0, 16);
+
+    wchar_t path[MAX_PATH];
+    const DWORD length = GetModuleFileNameW(module, path, MAX_PATH);
+    return QStringLiteral("%1+0x%2")
+        .arg(QFileInfo(QString::fromWCharArray(path, int(length))).fileName())
+        .arg(pc - DWORD64(module), 0, 16);
+}
+#endif
+
+} // namespace
+
+class StallMonitorThread : public QThread
+{
+public:
+    explicit StallMonitorThread(StallWatchdog *watchdog) : watchdog_(watchdog) {}
+
+protected:
+    void run() override { watchdog_->monitorLoop(); }
+
+private:
+    StallWatchdog *watchdog_;
+};
+
+StallWatchdog::StallWatchdog(int thresholdMs, QObject *parent)
+    : QObject(parent)
+    , thresholdMs_(qMax(HeartbeatMs * 2, thresholdMs))
+{
+    Q_ASSERT(!g_instance);
+    g_instance = this;
+
+#if defined(STALL_STACK_SIGNAL)
+    g_guiThread = pthread_self();
+    // 처음 부를 때 libgcc 를 읽어 들이므로 신호 처리기 밖에서 한 번 불러 둔다
+    void *warmUp[1];
+    backtrace(warmUp, 1);
+
+    struct sigaction action = {};
+    action.sa_handler = sampleSignalHandler;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SampleSignal, &action, &g_previousAction);
+#elif defined(STALL_STACK_SUSPEND)
+    g_guiThread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION,
+                             FALSE, GetCurrentThreadId());
+    g_guiStackBase = DWORD64(reinterpret_cast<NT_TIB *>(NtCurrentTeb())->StackBase);
+#endif
+
+    heartbeat_.setInterval(HeartbeatMs);
+    connect(&heartbeat_, &QTimer::timeout, this, [this] {
+        lastBeatUs_.store(MetricsRegistry::nowUs(), std::memory_order_relaxed);
+    });
+    heartbeat_.start();
+    QCoreApplication::instance()->installEventFilter(this);
+
+    monitor_ = new StallMonitorThread(this);
+    monitor_->setObjectName(QStringLiteral("StallWatchdog"));
+    monitor_->start(QThread::HighPriority);
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    QCoreApplication::instance()->removeEventFilter(this);
+    heartbeat_.stop();
+    stopping_.store(true, std::memory_order_relaxed);
+    monitor_->wait();
+    delete monitor_;
+
+#if defined(STALL_STACK_SIGNAL)
+    sigaction(SampleSignal, &g_previousAction, nullptr);
+#elif defined(STALL_STACK_SUSPEND)
+    if (g_guiThread)
+        CloseHandle(std::exchange(g_guiThread, nullptr));
+#endif
+
+    g_instance = nullptr;
+}
+
+StallWatchdog *StallWatchdog::instance()
+{
+    return g_instance;
+}
+
+bool StallWatchdog::eventFilter(QObject *watched, QEvent *event)
+{
+    lastReceiver_.store(watched->metaObject()->className(), std::memory_order_relaxed);
+    lastEvent_.store(int(event->type()), std::memory_order_relaxed);
+    return false;
+}
+
+void StallWatchdog::monitorLoop()
+{
+    const qint64 thresholdUs = qint64(thresholdMs_) * 1000;
+    const qint64 beatUs      = qint64(HeartbeatMs) * 1000;
+
+    qint64 lastPollUs  = MetricsRegistry::nowUs();
+    qint64 stalledBeat = 0;     // 멈춤을 감지했을 때의 마지막 박동 (0 이면 정상)
+    qint64 pausedBeat  = -1;    // 프로세스 전체가 멈췄던 동안의 박동은 판정하지 않는다
+    Stall  stall;
+
+    while (!stopping_.load(std::memory_order_relaxed)) {
+        QThread::msleep(PollMs);
+
+        const qint64 now  = MetricsRegistry::nowUs();
+        const qint64 beat = lastBeatUs_.load(std::memory_order_relaxed);
+
+        // 감시 스레드도 늦게 깨어났으면 절전이나 디버거 정지로 전체가 멈춘 것
+        const bool selfLate = now - lastPollUs > thresholdUs;
+        lastPollUs = now;
+        if (beat == 0)
+            continue;
+        if (selfLate && stalledBeat == 0)
+            pausedBeat = beat;
+        if (beat == pausedBeat)
+            continue;
+
+        if (stalledBeat == 0) {
+            // 멈춘 동안 한 번만 샘플링한다 (GUI 스레드는 여전히 같은 곳에 있다)
+            if (now - beat - beatUs >= thresholdUs) {
+                stalledBeat   = beat;
+                stall.context = currentContext();
+                stall.stack   = sampleStack();
+            }
+        } else if (beat != stalledBeat) {
+            // 예정된 박동 시각부터 다시 박동이 올 때까지
+            stall.durationMs = (beat - stalledBeat - beatUs) / 1000;
+            recordStall(stall);
+            stalledBeat = 0;
+        }
+    }
+}
+
+QString StallWatchdog::currentContext() const
+{
+    if (const char *scope = Scope::current_.load(std::memory_order_relaxed))
+        return QString::fromLatin1(scope);
+
+    const char *receiver = lastReceiver_.load(std::memory_order_relaxed);
+    if (!receiver)
+        return QStringLiteral("(알 수 없음)");
+
+    const int type = lastEvent_.load(std::memory_order_relaxed);
+    const char *typeName = QMetaEnum::fromType<QEvent::Type>().valueToKey(type);
+    return QStringLiteral("%1 → %2")
+        .arg(typeName ? QString::fromLatin1(typeName) : QString::number(type),
+             QString::fromLatin1(receiver));
+}
+
+QStringList StallWatchdog::sampleStack()
+{
+    QStringList stack;
+
+#if defined(STALL_STACK_SIGNAL)
+    g_frameCount.store(-1, std::memory_order_relaxed);
+    if (pthread_kill(g_guiThread, SampleSignal) != 0)
+        return stack;
+    for (int waited = 0; waited < SampleWaitMs && g_frameCount.load(std::memory_order_acquire) < 0; ++waited)
+        QThread::msleep(1);
+
+    const int depth = g_frameCount.load(std::memory_order_acquire);
+    if (depth <= SignalSkipFrames)
+        return stack;
+    if (char **symbols = backtrace_symbols(g_frames, depth)) {
+        for (int i = SignalSkipFrames; i < depth; ++i)
+            stack.append(QString::fromLocal8Bit(symbols[i]));
+        std::free(symbols);
+    }
+#elif defined(STALL_STACK_SUSPEND)
+    if (!g_guiThread || SuspendThread(g_guiThread) == DWORD(-1))
+        return stack;
+
+    // 멈춘 스레드가 힙 잠금을 쥐고 있을 수 있으므로 재개 전에는 할당하지 않는다
+    DWORD64 frames[MaxFrames];
+    int depth = 0;
+    CONTEXT context = {};
+    context.ContextFlags = CONTEXT_FULL;
+    if (GetThreadContext(g_guiThread, &context)) {
+        // 멈춘 지점의 Rsp 부터 스택 바닥(StackBase)까지는 확정된 메모리다. 되감은 Rsp 가
+        // 이 범위를 벗어나거나 줄어들면 되감기가 잘못된 것이므로 읽지 않고 멈춘다
+        // (감시 스레드의 접근 위반은 프로세스 전체를 끝낸다)
+        const DWORD64 stackLow = context.Rsp;
+        auto onStack = [stackLow](DWORD64 rsp) {
+            return rsp >= stackLow && rsp + sizeof(DWORD64) <= g_guiStackBase
+                && rsp % sizeof(DWORD64) == 0;
+        };
+        while (depth < MaxFrames && context.Rip != 0 && onStack(context.Rsp)) {
+            frames[depth++] = context.Rip;
+            const DWORD64 previousRsp = context.Rsp;
+            DWORD64 imageBase = 0;
+            PRUNTIME_FUNCTION function = RtlLookupFunctionEntry(context.Rip, &imageBase, nullptr);
+            if (function) {
+                PVOID   handlerData = nullptr;
+                DWORD64 establisher = 0;
+                RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context.Rip, function,
+                                 &context, &handlerData, &establisher, nullptr);
+                if (context.Rsp <= previousRsp)
+                    break;
+            } else if (depth == 1) {
+                // 잎 함수 (가장 안쪽 프레임만 가능): 복귀 주소가 스택 꼭대기에 있다
+                context.Rip = *reinterpret_cast<DWORD64 *>(context.Rsp);
+                context.Rsp += sizeof(DWORD64);
+            } else {
+                break;      // 함수 정보가 없는 중간 프레임은 더 되감을 수 없다
+            }
+        }
+    }
+    ResumeThread(g_guiThread);
+
+    for (int i = 0; i < depth; ++i)
+        stack.append(describeAddress(frames[i]));
+#endif
+
+    return stack;
+}
+
+void StallWatchdog::recordStall(const Stall &stall)
+{
+    stallCount_.fetch_add(1, std::memory_order_relaxed);
+    qCWarning(lcUi).noquote() << QStringLiteral("GUI 멈춤 %1 ms: %2").arg(stall.durationMs).arg(stall.context);
+    if (!stall.stack.isEmpty())
+        qCDebug(lcUi).noquote() << "  " + stall.stack.mid(0, ReportFrames).join(QStringLiteral("\n  "));
+
+    QMutexLocker lock(&mutex_);
+    Offender &o = offenders_[stall.context];
+    o.context  = stall.context;
+    o.count   += 1;
+    o.totalMs += stall.durationMs;
+    if (stall.durationMs >= o.maxMs || o.stack.isEmpty()) {
+        o.maxMs = qMax(o.maxMs, stall.durationMs);
+        if (!stall.stack.isEmpty())
+            o.stack = stall.stack;
+    }
+}
+
+QList<StallWatchdog::Offender> StallWatchdog::offenders() const
+{
+    QList<Offender> list;
+    {
+        QMutexLocker lock(&mutex_);
+        list = offenders_.values();
+    }
+    std::sort(list.begin(), list.end(), [](const Offender &a, const Offender &b) {
+        return a.totalMs > b.totalMs;
+    });
+    return list;
+}
+
+QString StallWatchdog::report() const
+{
+    const QList<Offender> list = offenders();
+    if (list.isEmpty())
+        return QStringLiteral("%1 ms 를 넘은 GUI 멈춤 없음").arg(thresholdMs_);
+
+    QString text = QStringLiteral("GUI 멈춤 %1건 (임계값 %2 ms), 누적 시간 순\n")
+                       .arg(stallCount()).arg(thresholdMs_);
+    for (const Offender &o : list) {
+        text += QStringLiteral("%1  %2건 · 누적 %3 ms · 최대 %4 ms\n")
+                    .arg(o.context).arg(o.count).arg(o.totalMs).arg(o.maxMs);
+        for (const QString &frame : o.stack.mid(0, ReportFrames))
+            text += QStringLiteral("    ") + frame + QLatin1Char('\n');
+    }
+    return text;
+}
+
+void StallWatchdog::reset()
+{
+    QMutexLocker lock(&mutex_);
+    offenders_.clear();
+    stallCount_.store(0, std::memory_order_relaxed);
+}
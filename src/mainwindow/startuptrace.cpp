@@ -0,0 +1,95 @@
+// startuptrace.cpp
+#include "mainwindow/startuptrace.h"
+#include "mainwindow/logging.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Stage
+{
+    const char *name;
+    qint64      elapsedUs;
+    bool        guiThread;
+};
+
+QMutex             g_mutex;
+QElapsedTimer      g_clock;
+std::vector<Stage> g_stages;
+std::atomic<bool>  g_active{false};     // 첫 프레임 뒤에는 잠금 없이 바로 돌아간다
+
+// g_mutex 를 잡은 상태에서 호출
+void append(const char *stage)
+{
+    for (const Stage &s : g_stages) {
+        if (std::strcmp(s.name, stage) == 0)
+            return;
+    }
+    const bool gui = QThread::isMainThread();
+    g_stages.push_back(Stage{stage, g_clock.nsecsElapsed() / 1000, gui});
+}
+
+// g_mutex 를 잡은 상태에서 호출
+QString format()
+{
+    QString text = QStringLiteral("시작 타임라인 (로그인 기준)");
+    qint64 previousUs = 0;
+    for (const Stage &s : g_stages) {
+        text += QStringLiteral("\n  %1 ms  (+%2)  %3%4")
+                    .arg(s.elapsedUs / 1000.0, 8, 'f', 1)
+                    .arg((s.elapsedUs - previousUs) / 1000.0, 0, 'f', 1)
+                    .arg(QLatin1StringView(s.name))
+                    .arg(s.guiThread ? QString() : QStringLiteral("  [작업 스레드]"));
+        previousUs = s.elapsedUs;
+    }
+    return text;
+}
+
+} // namespace
+
+namespace StartupTrace {
+
+void begin()
+{
+    QMutexLocker lock(&g_mutex);
+    g_stages.clear();
+    g_clock.start();
+    append("login.accepted");
+    g_active.store(true, std::memory_order_release);
+}
+
+void mark(const char *stage)
+{
+    if (!g_active.load(std::memory_order_acquire))
+        return;
+    QMutexLocker lock(&g_mutex);
+    if (g_active.load(std::memory_order_relaxed))
+        append(stage);
+}
+
+void finish(const char *stage)
+{
+    if (!g_active.load(std::memory_order_acquire))
+        return;
+    QString text;
+    {
+        QMutexLocker lock(&g_mutex);
+        if (!g_active.exchange(false, std::memory_order_relaxed))
+            return;
+        append(stage);
+        text = format();
+    }
+    qCInfo(lcStartup).noquote() << text;
+}
+
+QString timeline()
+{
+    QMutexLocker lock(&g_mutex);
+    return format();
+}
+
+} // namespace StartupTrace
@@ -1,77 +1,24 @@
 // tcphistoryhandler.cpp
 #include "mainwindow/tcphistoryhandler.h"
-#include <QFile>
+#include "mainwindow/logging.h"
+#include "mainwindow/tlscontext.h"
 #include <QJsonDocument>
-#include <QtNetwork/QSslCertificate>
-#include <QtNetwork/QSslKey>
-#include <QtNetwork/QSslConfiguration>
-#include <QDebug>
-#include <QCoreApplication>
-#include <QDir>
-#include <QFileInfo>
+#include <QTimer>
+#include <cstring>
+#include <utility>
 TcpHistoryHandler::TcpHistoryHandler(QObject *parent)
     : QObject(parent),
     socket_(new QSslSocket(this))
 {
-    // 1) client private key 로드
-    {
-        QString keyPath = findCertificateFile("client.key.pem");
-        if (!keyPath.isEmpty()) {
-            QFile keyFile(keyPath);
-            if (keyFile.open(QIODevice::ReadOnly)) {
-                QByteArray keyData = keyFile.readAll();
-                QSslKey key(keyData, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
-                socket_->setPrivateKey(key);
-                qDebug() << "Client private key loaded successfully from:" << keyPath;
-            } else {
-                qDebug() << "Failed to load client private key:" << keyFile.errorString();
-            }
-        } else {
-            qDebug() << "Failed to load client private key: 지정된 파일을 찾을 수 없습니다.";
-        }
-    }
-
-    // 2) client certificate 로드
-    {
-        QString certPath = findCertificateFile("client.cert.pem");
-        if (!certPath.isEmpty()) {
-            QFile certFile(certPath);
-            if (certFile.open(QIODevice::ReadOnly)) {
-                QByteArray certData = certFile.readAll();
-                QSslCertificate cert(certData, QSsl::Pem);
-                socket_->setLocalCertificate(cert);
-                qDebug() << "Client certificate loaded successfully from:" << certPath;
-            } else {
-                qDebug() << "Failed to load client certificate:" << certFile.errorString();
-            }
-        } else {
-            qDebug() << "Failed to load client certificate: 지정된 파일을 찾을 수 없습니다.";
-        }
-    }
-
-    // 3) CA certificate 로드해서 SSL config 에 추가
-    {
-        QString caPath = findCertificateFile("ca.cert.pem");
-        if (!caPath.isEmpty()) {
-            QFile caFile(caPath);
-            if (caFile.open(QIODevice::ReadOnly)) {
-                QByteArray caData = caFile.readAll();
-                auto caCerts = QSslCertificate::fromData(caData, QSsl::Pem);
-                QSslConfiguration cfg = socket_->sslConfiguration();
-                cfg.setCaCertificates(caCerts);
-                socket_->setSslConfiguration(cfg);
-                qDebug() << "CA certificate loaded successfully from:" << caPath;
-            } else {
-                qDebug() << "Failed to load CA certificate:" << caFile.errorString();
-            }
-        } else {
-            qDebug() << "Failed to load CA certificate: 지정된 파일을 찾을 수 없습니다.";
-        }
-    }
+    // 클라이언트 인증서/개인키/CA 는 TlsContext 가 한 번만 읽어 둔 것을 쓴다
+    socket_->setSslConfiguration(TlsContext::clientConfiguration());
 
     // 필수: 서버 인증서 검증 켜기
     socket_->setPeerVerifyMode(QSslSocket::VerifyPeer);
 
+    connect(socket_, &QSslSocket::connected, this, [this]() {
+        handshakeStartUs_ = MetricsRegistry::start();
+    });
     connect(socket_, &QSslSocket::encrypted,
             this, &TcpHistoryHandler::onEncrypted);
     connect(socket_, &QSslSocket::readyRead,
@@ -86,10 +33,15 @@ TcpHistoryHandler::TcpHistoryHandler(QObject *parent)
 
 void TcpHistoryHandler::connectToServer(const QString &host, quint16 port)
 {
-    qDebug() << "Attempting to connect to" << host << ":" << port;
+    qCDebug(lcTcp) << "Attempting to connect to" << host << ":" << port;
     socket_->connectToHostEncrypted(host, port);
 }
 
+void TcpHistoryHandler::disconnectFromServer()
+{
+    socket_->abort();
+}
+
 void TcpHistoryHandler::getHistory(const QString &email, int limit, int offset)
 {
     sendCommand(QString("GET_HISTORY %1 %2 %3")
@@ -135,55 +87,189 @@ void TcpHistoryHandler::getHistoryByEventTypeAndDateRange(const QString &email,
 void TcpHistoryHandler::sendCommand(const QString &cmd)
 {
     if (socket_->state() != QAbstractSocket::ConnectedState) {
-        qDebug() << "Socket not connected, cannot send command:" << cmd;
+        qCWarning(lcTcp) << "Socket not connected, cannot send command:" << cmd;
         emit errorOccurred("Socket not connected");
         return;
     }
     
-    qDebug() << "Sending command:" << cmd;
+    qCDebug(lcTcp) << "Sending command:" << cmd;
     QByteArray line = cmd.toUtf8() + "\n";
     qint64 written = socket_->write(line);
     if (written == -1) {
-        qDebug() << "Failed to write command to socket";
+        qCWarning(lcTcp) << "Failed to write command to socket";
         emit errorOccurred("Failed to send command");
     } else {
+        wireReader_.addBytesOut(written);
         socket_->flush();
+        pendingCommands_.enqueue({MetricsRegistry::tcpTiming(cmd), MetricsRegistry::start()});
     }
 }
 
 void TcpHistoryHandler::onEncrypted()
 {
-    qDebug() << "SSL connection established successfully";
+    qCDebug(lcTcp) << "SSL connection established successfully";
+    MetricsRegistry::finish(MetricsRegistry::TlsHandshake, std::exchange(handshakeStartUs_, 0));
+
+    // 지원하는 wire 형식/압축을 알린다. 응답(또는 시간 초과) 후에 connected() 를 보내
+    // 첫 요청부터 협상된 형식을 쓰도록 한다. 모르는 명령으로 거절하면 JSON/무압축 유지
+    binaryWire_      = false;
+    helloPending_    = true;
+    helloUnanswered_ = true;
+    wireReader_.reset();
+    QString hello = QString("HELLO wire=%1").arg(HistoryWire::Name);
+    if (compressMinBytes_ > 0)
+        hello += QString(" compress=%1 compress_min=%2").arg(WireCompression::Name).arg(compressMinBytes_);
+    sendCommand(hello);
+    QTimer::singleShot(2000, this, &TcpHistoryHandler::onHelloTimeout);
+}
+
+void TcpHistoryHandler::onHelloTimeout()
+{
+    if (!helloPending_) return;
+    qCDebug(lcTcp) << "HELLO not answered, using JSON history responses";
+    // 응답은 늦게라도 올 수 있다 (helloUnanswered_ 유지, finishResponse 에서 걸러냄)
+    helloPending_ = false;
     emit connected();
 }
 
 void TcpHistoryHandler::onReadyRead()
 {
-    // 서버가 보내는 JSON 전체를 라인 단위로 받는다 가정
-    while (socket_->canReadLine()) {
-        QByteArray line = socket_->readLine().trimmed();
-        qDebug() << "Received data:" << line;
-        
-        if (line.isEmpty()) continue;
-        
-        QJsonParseError err;
-        QJsonDocument doc = QJsonDocument::fromJson(line, &err);
-        if (err.error == QJsonParseError::NoError && doc.isObject()) {
-            qDebug() << "Valid JSON received, emitting historyDataReady";
-            emit historyDataReady(doc.object());
-        } else {
-            qDebug() << "JSON parse error:" << err.errorString();
-            emit errorOccurred(tr("Invalid JSON response: %1").arg(err.errorString()));
+    // 응답 전체(한 줄)를 기다리지 않고 도착한 바이트를 바로 디코더에 넣는다
+    QByteArray data = wireReader_.read(socket_->readAll());
+    if (wireReader_.hasError()) {
+        qCWarning(lcTcp) << "History wire frame error:" << wireReader_.errorString();
+        emit errorOccurred(tr("Invalid history response: %1").arg(wireReader_.errorString()));
+        socket_->abort();
+        return;
+    }
+    const char *p = data.constData();
+    qsizetype left = data.size();
+
+    while (left > 0) {
+        if (resyncing_) {
+            const char *nl = static_cast<const char *>(memchr(p, '\n', size_t(left)));
+            if (!nl) return;
+            left -= (nl - p) + 1;
+            p = nl + 1;
+            resyncing_ = false;
+            continue;
+        }
+
+        if (!decoder_) {
+            // 응답 사이의 줄바꿈/공백은 건너뛰고 첫 바이트로 형식 판별
+            if (*p == '\n' || *p == '\r' || *p == ' ' || *p == '\t') {
+                ++p;
+                --left;
+                continue;
+            }
+            decoder_ = (*p == HistoryWire::Magic0) ? static_cast<HistoryDecoder *>(&wireDecoder_)
+                                                   : static_cast<HistoryDecoder *>(&jsonDecoder_);
+            decoder_->reset();
+            decodeUs_ = 0;
+        }
+
+        // 디코더 안에서 보낸 시간만 더한다 (소켓 대기/신호 처리는 제외)
+        const qint64 feedStartUs = MetricsRegistry::start();
+        qsizetype used = decoder_->feed(p, left);
+        if (feedStartUs != 0)
+            decodeUs_ += MetricsRegistry::nowUs() - feedStartUs;
+        p += used;
+        left -= used;
+
+        QList<HistoryRecord> records = decoder_->takeRecords();
+        if (!records.isEmpty()) {
+            emit historyRecordsReady(records, firstBatch_);
+            firstBatch_ = false;
+        }
+
+        if (decoder_->hasError()) {
+            qCWarning(lcTcp) << "History response decode error:" << decoder_->errorString();
+            emit errorOccurred(tr("Invalid history response: %1").arg(decoder_->errorString()));
+            if (decoder_ == &wireDecoder_) {
+                // 바이너리 본문에는 줄바꿈이 아무 데나 올 수 있어 응답 경계를 다시 찾을 수 없다.
+                // 프레임 오류처럼 연결을 끊는다 (onDisconnected 가 상태를 정리)
+                socket_->abort();
+                return;
+            }
+            if (!pendingCommands_.isEmpty())
+                pendingCommands_.dequeue();   // 이 응답은 측정에서 뺀다
+            decoder_    = nullptr;
+            firstBatch_ = true;
+            resyncing_  = true;
+            continue;
+        }
+
+        if (decoder_->isComplete() && finishResponse()) {
+            // 압축이 협상되면 HELLO 응답 뒤의 바이트부터 프레임으로 해석
+            data = wireReader_.enableFraming(p, left);
+            p = data.constData();
+            left = data.size();
         }
     }
 }
 
-void TcpHistoryHandler::onSslErrors(const QList<QSslError> &errors)
+bool TcpHistoryHandler::finishResponse()
 {
-    qDebug() << "SSL errors occurred:";
-    for (const auto& error : errors) {
-        qDebug() << "  -" << error.errorString();
+    const QJsonObject header = decoder_->header();
+    const int count = decoder_->recordCount();
+    const bool bin1 = decoder_ == &wireDecoder_;
+    decoder_    = nullptr;
+    firstBatch_ = true;
+
+    // 시간 초과 전이면 연결 후 첫 응답이 HELLO 응답이다. 시간 초과 뒤에는 이미 히스토리를
+    // 요청했으므로 응답 내용으로 늦게 온 HELLO 응답인지 가린다
+    const bool helloReply = helloPending_ || (helloUnanswered_ && isHelloReply(header));
+    if (helloUnanswered_ && !helloReply && !pendingCommands_.isEmpty()) {
+        // 서버가 HELLO 를 무시했다. HELLO 의 측정 항목을 버려 이 응답과 짝이 맞게 한다
+        pendingCommands_.dequeue();
+    }
+    const bool lateHello = helloReply && !helloPending_;
+    helloPending_    = false;
+    helloUnanswered_ = false;
+
+    if (!pendingCommands_.isEmpty()) {
+        const PendingCommand sent = pendingCommands_.dequeue();
+        MetricsRegistry::finish(sent.timing, sent.startUs);
+    }
+
+    if (helloReply) {
+        // 늦게 왔더라도 서버는 이후 응답에 협상한 형식/압축을 쓰므로 그대로 따른다
+        binaryWire_ = header.value("wire").toString() == QLatin1String(HistoryWire::Name);
+        const bool compressed = compressMinBytes_ > 0 &&
+            header.value("compress").toString() == QLatin1String(WireCompression::Name);
+        qCDebug(lcTcp) << "History wire format:" << (binaryWire_ ? HistoryWire::Name : "json")
+                 << "compression:" << (compressed ? WireCompression::Name : "none")
+                 << (lateHello ? "(late HELLO reply)" : "");
+        if (!lateHello)
+            emit connected();
+        return compressed;
     }
+
+    if (decodeUs_ > 0)
+        MetricsRegistry::recordUs(bin1 ? MetricsRegistry::HistoryDecodeBin1
+                                       : MetricsRegistry::HistoryDecodeJson, decodeUs_);
+
+    const WireStats &st = wireReader_.stats();
+    qCDebug(lcTcp) << "History response received, records:" << count
+             << "wire bytes:" << st.wireBytesIn << "payload bytes:" << st.payloadBytesIn
+             << "inflate ms:" << st.inflateNs / 1e6;
+    emit historyFinished(header, count);
+    return false;
+}
+
+bool TcpHistoryHandler::isHelloReply(const QJsonObject &header)
+{
+    // 지원 서버는 wire 를 돌려주고, 예전 서버는 모르는 명령으로 거절한다
+    const QString message = header.value("message").toString();
+    return header.contains("wire")
+        || message == QLatin1String("HELLO")
+        || message == QLatin1String("Unknown command");
+}
+
+void TcpHistoryHandler::onSslErrors(const QList<QSslError> &errors)
+{
+    for (const auto& error : errors)
+        qCWarning(lcTcp) << "Ignoring SSL error:" << error.errorString();
     // 인증서 문제 무시(필요 시 정책 변경)
     socket_->ignoreSslErrors();
 }
@@ -192,7 +278,7 @@ void TcpHistoryHandler::onSocketError(QAbstractSocket::SocketError error)
 {
     Q_UNUSED(error);
     QString errorMsg = QString("Socket error: %1").arg(socket_->errorString());
-    qDebug() << errorMsg;
+    qCWarning(lcTcp) << errorMsg;
     
     // 연결 관련 오류인 경우 connectionFailed 시그널 발생
     if (error == QAbstractSocket::ConnectionRefusedError ||
@@ -207,36 +293,14 @@ void TcpHistoryHandler::onSocketError(QAbstractSocket::SocketError error)
 
 void TcpHistoryHandler::onDisconnected()
 {
-    qDebug() << "Socket disconnected";
-}
-
-QString TcpHistoryHandler::findCertificateFile(const QString &filename)
-{
-    // 여러 경로에서 인증서 파일을 찾아봅니다
-    QStringList searchPaths = {
-        filename,                    // 원본 경로
-        "./" + filename,            // 현재 디렉토리
-        "../" + filename,           // 상위 디렉토리
-        "../../" + filename,        // 상위의 상위 디렉토리
-        "resources/certs/" + QFileInfo(filename).fileName(),  // resources/certs 디렉토리
-        QCoreApplication::applicationDirPath() + "/" + filename,  // 실행 파일 디렉토리
-        QDir::currentPath() + "/" + filename  // 현재 작업 디렉토리
-    };
-    
-    for (const QString &path : searchPaths) {
-        QFile file(path);
-        if (file.exists()) {
-            qDebug() << "인증서 파일 발견:" << path;
-            return path;
-        }
-    }
-    
-    qDebug() << "다음 경로들에서 인증서 파일을 찾을 수 없습니다:";
-    for (const QString &path : searchPaths) {
-        qDebug() << "  -" << path;
-    }
-    
-    return QString(); // 빈 문자열 반환
+    qCDebug(lcTcp) << "Socket disconnected";
+    // 받다 만 응답은 버린다
+    decoder_      = nullptr;
+    firstBatch_   = true;
+    resyncing_    = false;
+    helloPending_    = false;
+    helloUnanswered_ = false;
+    pendingCommands_.clear();
 }
 
 bool TcpHistoryHandler::isConnected() const
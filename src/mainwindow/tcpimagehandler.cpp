@@ -1,58 +1,19 @@
 // tcpimagehandler.cpp
 #include "mainwindow/tcpimagehandler.h"
+#include "mainwindow/metricsregistry.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/tlscontext.h"
 
-#include <QFile>
-#include <QDebug>
-#include <QSslCertificate>
-#include <QSslKey>
+#include <QDataStream>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QtNetwork/QSslConfiguration>
-#include <QCoreApplication>
-#include <QDir>
-#include <QFileInfo>
+#include <utility>
 
 TcpImageHandler::TcpImageHandler(QObject *parent)
     : QObject(parent),
     socket_(new QSslSocket(this))
 {
-    // 1) client private key 로드
-    QString keyPath = findCertificateFile("client.key.pem");
-    if (!keyPath.isEmpty()) {
-        QFile keyFile(keyPath);
-        if (keyFile.open(QIODevice::ReadOnly)) {
-            QByteArray keyData = keyFile.readAll();
-            QSslKey key(keyData, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
-            socket_->setPrivateKey(key);
-            qDebug() << "클라이언트 개인키 로드 성공:" << keyPath;
-        }
-    }
-
-    // 2) client certificate 로드
-    QString certPath = findCertificateFile("client.cert.pem");
-    if (!certPath.isEmpty()) {
-        QFile certFile(certPath);
-        if (certFile.open(QIODevice::ReadOnly)) {
-            QByteArray certData = certFile.readAll();
-            QSslCertificate cert(certData, QSsl::Pem);
-            socket_->setLocalCertificate(cert);
-            qDebug() << "클라이언트 인증서 로드 성공:" << certPath;
-        }
-    }
-
-    // 3) CA certificate 로드해서 SSL config 에 추가
-    QString caPath = findCertificateFile("ca.cert.pem");
-    if (!caPath.isEmpty()) {
-        QFile caFile(caPath);
-        if (caFile.open(QIODevice::ReadOnly)) {
-            QByteArray caData = caFile.readAll();
-            auto caCerts = QSslCertificate::fromData(caData, QSsl::Pem);
-            QSslConfiguration cfg = socket_->sslConfiguration();
-            cfg.setCaCertificates(caCerts);
-            socket_->setSslConfiguration(cfg);
-            qDebug() << "CA 인증서 로드 성공:" << caPath;
-        }
-    }
+    socket_->setSslConfiguration(TlsContext::clientConfiguration());
 
     connect(socket_, &QSslSocket::encrypted,        this, &TcpImageHandler::onEncrypted);
     connect(socket_, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors), this, &TcpImageHandler::onSslErrors);
@@ -63,15 +24,14 @@ TcpImageHandler::TcpImageHandler(QObject *parent)
     // 에러 처리 추가
     connect(socket_, QOverload<QAbstractSocket::SocketError>::of(&QSslSocket::errorOccurred),
             this, [this](QAbstractSocket::SocketError error) {
-                qDebug() << "[TcpImageHandler] Socket 에러 발생:" << error << socket_->errorString();
+                qCWarning(lcImage) << "소켓 오류:" << error << socket_->errorString();
                 emit errorOccurred(QString("Socket error: %1").arg(socket_->errorString()));
             });
 }
 
 void TcpImageHandler::connectToServerThenRequestImage(const QString &host, quint16 port, const QString &imagePath) {
-    qDebug() << "[TcpImageHandler] connectToServerThenRequestImage 호출됨";
-    qDebug() << "[TcpImageHandler] Host:" << host << "Port:" << port << "Path:" << imagePath;
-    
+    qCDebug(lcImage) << "이미지 요청:" << imagePath << "from" << host << port;
+
     host_ = host;
     port_ = port;
     currentPath_ = imagePath;
@@ -79,46 +39,39 @@ void TcpImageHandler::connectToServerThenRequestImage(const QString &host, quint
     buffer_.clear();
     expectedSize_ = 0;
     headerParsed_ = false;
+    handshakeStartUs_ = 0;
+    requestStartUs_ = 0;
 
-    qDebug() << "[TcpImageHandler] 기존 연결 중단 후 새 연결 시도...";
     socket_->abort();
     socket_->connectToHostEncrypted(host_, port_);
-    qDebug() << "[TcpImageHandler] connectToHostEncrypted 호출 완료";
 }
 
 void TcpImageHandler::onConnected() {
-    qDebug() << "[TcpImageHandler] TCP connected, starting SSL handshake";
+    handshakeStartUs_ = MetricsRegistry::start();
 }
 
 void TcpImageHandler::onEncrypted() {
-    qDebug() << "[TcpImageHandler] SSL/TLS handshake complete";
+    MetricsRegistry::finish(MetricsRegistry::TlsHandshake, std::exchange(handshakeStartUs_, 0));
     sendGetImageRequest();
 }
 
 void TcpImageHandler::sendGetImageRequest() {
-    qDebug() << "[TcpImageHandler] sendGetImageRequest 호출됨";
-    qDebug() << "[TcpImageHandler] Socket 상태:" << socket_->state();
-    
     if (socket_->state() != QAbstractSocket::ConnectedState) {
-        qDebug() << "[TcpImageHandler] 서버에 연결되지 않음, 에러 발생";
+        qCWarning(lcImage) << "서버에 연결되지 않아 요청을 보내지 못함:" << currentPath_;
         emit errorOccurred("Not connected to server");
         return;
     }
 
     QByteArray cmd = "GET_IMAGE " + currentPath_.toUtf8() + "\n";
-    qDebug() << "[TcpImageHandler] 전송할 명령:" << cmd;
-    
-    qint64 written = socket_->write(cmd);
+    requestStartUs_ = MetricsRegistry::start();
+    socket_->write(cmd);
     socket_->flush();
-
-    qDebug() << "[TcpImageHandler] GET_IMAGE 명령 전송 완료, 전송된 바이트:" << written;
-    qDebug() << "[TcpImageHandler] 요청한 이미지 경로:" << currentPath_;
 }
 
 void TcpImageHandler::onSslErrors(const QList<QSslError>& errs) {
     socket_->ignoreSslErrors();
     for (const auto &e : errs) {
-        qWarning() << "[TcpImageHandler] Ignored SSL error:" << e.errorString();
+        qCWarning(lcImage) << "SSL 오류 무시:" << e.errorString();
     }
 }
 
@@ -129,31 +82,19 @@ void TcpImageHandler::onReadyRead() {
         stream.setByteOrder(QDataStream::BigEndian);
         stream >> expectedSize_;
         headerParsed_ = true;
-        qDebug() << "[TcpImageHandler] Expecting image size:" << expectedSize_;
     }
 
     buffer_.append(socket_->readAll());
 
     if (headerParsed_ && buffer_.size() >= expectedSize_) {
-        qDebug() << "[TcpImageHandler] Received full image data, size:" << buffer_.size();
-
-        QFile file("C:/test_received_image.jpg");
-        if (file.open(QIODevice::WriteOnly)) {
-            file.write(buffer_);
-            file.close();
-            qDebug() << "파일로 이미지 저장 성공! 경로: C:/test_received_image.jpg";
-        } else {
-            qDebug() << "파일 저장 실패!";
-        }
-
+        qCDebug(lcImage) << "이미지 수신 완료:" << currentPath_ << buffer_.size() << "bytes";
+        MetricsRegistry::finish(MetricsRegistry::TcpGetImage, std::exchange(requestStartUs_, 0));
         emit imageDataReady(currentPath_, buffer_);
         socket_->disconnectFromHost();
     }
 }
 
 void TcpImageHandler::onDisconnected() {
-    qDebug() << "[TcpImageHandler] Disconnected. Final buffer size:" << buffer_.size();
-
     if (!headerParsed_ && buffer_.startsWith('{')) {
         QJsonDocument doc = QJsonDocument::fromJson(buffer_);
         if (doc.isObject()) {
@@ -161,46 +102,8 @@ void TcpImageHandler::onDisconnected() {
             emit errorOccurred(msg.isEmpty() ? "Unknown server error" : msg);
         }
     } else if (!buffer_.isEmpty()) {
+        MetricsRegistry::finish(MetricsRegistry::TcpGetImage, std::exchange(requestStartUs_, 0));
         emit imageDataReady(currentPath_, buffer_);
     }
 }
 
-QString TcpImageHandler::findCertificateFile(const QString &filename)
-{
-    // 여러 경로에서 인증서 파일을 찾아봅니다
-    QStringList searchPaths = {
-        QString(":/certs/%1").arg(filename),  // 리소스 경로 우선
-        filename,                    // 원본 경로
-        "./" + filename,            // 현재 디렉토리
-        "../" + filename,           // 상위 디렉토리
-        "../../" + filename,        // 상위의 상위 디렉토리
-        "resources/certs/" + QFileInfo(filename).fileName(),  // resources/certs 디렉토리
-        QCoreApplication::applicationDirPath() + "/" + filename,  // 실행 파일 디렉토리
-        QDir::currentPath() + "/" + filename  // 현재 작업 디렉토리
-    };
-    
-    for (const QString &path : searchPaths) {
-        if (path.startsWith(":/")) {
-            // 리소스 파일인 경우
-            QFile file(path);
-            if (file.exists()) {
-                qDebug() << "인증서 파일 발견 (리소스):" << path;
-                return path;
-            }
-        } else {
-            // 일반 파일인 경우
-            QFile file(path);
-            if (file.exists()) {
-                qDebug() << "인증서 파일 발견:" << path;
-                return path;
-            }
-        }
-    }
-    
-    qDebug() << "다음 경로들에서 인증서 파일을 찾을 수 없습니다:";
-    for (const QString &path : searchPaths) {
-        qDebug() << "  -" << path;
-    }
-    
-    return QString(); // 빈 문자열 반환
-}
@@ -0,0 +1,103 @@
+// tlscontext.cpp
+#include "mainwindow/tlscontext.h"
+#include "mainwindow/logging.h"
+#include "mainwindow/startuptrace.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrent>
+
+namespace {
+
+QByteArray readCertificateFile(const QString &filename)
+{
+    const QString path = TlsContext::findCertificateFile(filename);
+    if (path.isEmpty())
+        return QByteArray();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcConfig) << "인증서 파일 열기 실패:" << path << file.errorString();
+        return QByteArray();
+    }
+    qCDebug(lcConfig) << "인증서 파일 로드:" << path;
+    return file.readAll();
+}
+
+TlsContext::Material loadMaterial()
+{
+    TlsContext::Material m;
+
+    const QByteArray key = readCertificateFile("client.key.pem");
+    if (!key.isEmpty())
+        m.privateKey = QSslKey(key, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+
+    const QByteArray cert = readCertificateFile("client.cert.pem");
+    if (!cert.isEmpty())
+        m.localCertificate = QSslCertificate(cert, QSsl::Pem);
+
+    const QByteArray ca = readCertificateFile("ca.cert.pem");
+    if (!ca.isEmpty())
+        m.caCertificates = QSslCertificate::fromData(ca, QSsl::Pem);
+
+    return m;
+}
+
+} // namespace
+
+const TlsContext::Material &TlsContext::material()
+{
+    static const Material m = loadMaterial();
+    return m;
+}
+
+QSslConfiguration TlsContext::clientConfiguration()
+{
+    // 인증서 파일은 처음 한 번만 읽고 이후 연결은 같은 설정을 복사해 쓴다
+    static const QSslConfiguration config = [] {
+        QSslConfiguration cfg = QSslConfiguration::defaultConfiguration();
+        const Material &m = material();
+        if (!m.privateKey.isNull())
+            cfg.setPrivateKey(m.privateKey);
+        if (!m.localCertificate.isNull())
+            cfg.setLocalCertificate(m.localCertificate);
+        if (!m.caCertificates.isEmpty())
+            cfg.setCaCertificates(m.caCertificates);
+        return cfg;
+    }();
+    return config;
+}
+
+QFuture<void> TlsContext::preload()
+{
+    return QtConcurrent::run([] {
+        clientConfiguration();
+        StartupTrace::mark("tls.ready");
+    });
+}
+
+QString TlsContext::findCertificateFile(const QString &filename)
+{
+    const QString base = QFileInfo(filename).fileName();
+    const QStringList searchPaths = {
+        ":/certs/" + filename,                           // 리소스 경로 우선
+        filename,                                        // 원본 경로
+        "../" + filename,                                // 상위 디렉토리
+        "../../" + filename,                             // 상위의 상위 디렉토리
+        "../../../" + filename,
+        "resources/certs/" + base,                       // resources/certs 디렉토리
+        "../../../resources/certs/" + base,              // 빌드 디렉토리에서 본 프로젝트 루트
+        "../../../../resources/certs/" + base,
+        QCoreApplication::applicationDirPath() + "/" + filename,  // 실행 파일 디렉토리
+        QDir::currentPath() + "/" + filename             // 현재 작업 디렉토리
+    };
+
+    for (const QString &path : searchPaths) {
+        if (QFile::exists(path))
+            return path;
+    }
+
+    qCWarning(lcConfig) << "인증서 파일을 찾을 수 없습니다:" << filename << "검색 경로:" << searchPaths;
+    return QString();
+}
@@ -1,4 +1,5 @@
 #include "mainwindow/topbarwidget.h"
+#include "mainwindow/iconcache.h"
 #include <QLabel>
 #include <QFont>
 #include <QFontDatabase>
@@ -107,106 +108,61 @@ void TopBarWidget::setActiveButton(TopBarButton button)
 
 void TopBarWidget::updateButtonStates()
 {
-    // 카메라 버튼
-    QPixmap cameraPixmap;
-    if (m_activeButton == TopBarButton::Camera) {
-        cameraPixmap = QPixmap(":/images/camera_orange.png");
-        qDebug() << "카메라 오렌지 이미지 로드:" << (!cameraPixmap.isNull() ? "성공" : "실패");
-        if (cameraPixmap.isNull()) {
-            // Fallback: 절대 경로 시도
-            cameraPixmap = QPixmap("../../resources/images/camera_orange.png");
-            qDebug() << "카메라 오렌지 절대경로 시도:" << (!cameraPixmap.isNull() ? "성공" : "실패");
-        }
-    } else {
-        cameraPixmap = QPixmap(":/images/camera.png");
-        qDebug() << "카메라 일반 이미지 로드:" << (!cameraPixmap.isNull() ? "성공" : "실패");
-        if (cameraPixmap.isNull()) {
-            cameraPixmap = QPixmap("../../resources/images/camera.png");
-            qDebug() << "카메라 일반 절대경로 시도:" << (!cameraPixmap.isNull() ? "성공" : "실패");
-        }
-    }
+    // 상태별 이미지와 크기별 축소본은 IconCache 에서 가져온다 (리사이즈마다 다시 읽지 않음)
+    const bool cameraActive = m_activeButton == TopBarButton::Camera;
+    applyIcon(cameraIcon,
+              cameraActive ? ":/images/camera_orange.png" : ":/images/camera.png",
+              cameraActive ? "../../resources/images/camera_orange.png" : "../../resources/images/camera.png",
+              "CAM", cameraActive);
+
+    const bool docActive = m_activeButton == TopBarButton::Document;
+    applyIcon(docIcon,
+              docActive ? ":/images/Document_orange.png" : ":/images/Document.png",
+              docActive ? "resources/images/Document_orange.png" : "resources/images/Document.png",
+              "DOC", docActive);
+
+    applyIcon(loginStatus, ":/images/Profile.png", "resources/images/Profile.png", "USER", false);
     
+    qDebug() << "버튼 상태 업데이트 완료";
+}
+
+void TopBarWidget::applyIcon(QLabel *label, const QString &resource, const QString &fallbackPath,
+                             const QString &fallbackText, bool active)
+{
+    QString path = resource;
+    if (IconCache::pixmap(path).isNull())
+        path = fallbackPath;   // 리소스가 없으면 실행 위치 기준 파일
+
     // 이미지 로드 실패 시 텍스트 fallback
-    if (cameraPixmap.isNull()) {
-        cameraIcon->clear();
-        cameraIcon->setText("CAM");
-        cameraIcon->setStyleSheet(m_activeButton == TopBarButton::Camera ? 
+    if (IconCache::pixmap(path).isNull()) {
+        label->clear();
+        label->setText(fallbackText);
+        label->setStyleSheet(active ?
             "background-color: #F37321; color: white; font-weight: bold; border-radius: 8px;" : 
             "background-color: #FFFFFF; color: black; font-weight: bold; border-radius: 8px; border: 1px solid #ccc;");
-        cameraIcon->setAlignment(Qt::AlignCenter);
-    } else {
-        // 버튼 크기에 비례한 아이콘 크기 계산 (버튼 크기의 100%)
-        double w_unit = m_parentWidth / 24.0;
-        double h_unit = m_parentHeight / 24.0;
-        int iconPixelSize = qMin(w_unit * 1.4 * 1.0, h_unit * 1.4 * 1.0);
-        
-        // 이미지 크기를 동적으로 조정하여 비율 유지
-        QPixmap scaledPixmap = cameraPixmap.scaled(iconPixelSize, iconPixelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        cameraIcon->setPixmap(scaledPixmap);
-        cameraIcon->setScaledContents(false);
-        cameraIcon->setAlignment(Qt::AlignCenter);
-        cameraIcon->setStyleSheet("border-radius: 8px;");
+        label->setAlignment(Qt::AlignCenter);
+        return;
     }
-    
-    // 문서 버튼
-    QPixmap docPixmap;
-    if (m_activeButton == TopBarButton::Document) {
-        docPixmap = QPixmap(":/images/Document_orange.png");
-        if (docPixmap.isNull()) docPixmap = QPixmap("resources/images/Document_orange.png");
-    } else {
-        docPixmap = QPixmap(":/images/Document.png");
-        if (docPixmap.isNull()) docPixmap = QPixmap("resources/images/Document.png");
-    }
-    
-    if (docPixmap.isNull()) {
-        docIcon->clear();
-        docIcon->setText("DOC");
-        docIcon->setStyleSheet(m_activeButton == TopBarButton::Document ? 
-            "background-color: #F37321; color: white; font-weight: bold; border-radius: 8px;" : 
-            "background-color: #FFFFFF; color: black; font-weight: bold; border-radius: 8px; border: 1px solid #ccc;");
-        docIcon->setAlignment(Qt::AlignCenter);
-    } else {
-        // 버튼 크기에 비례한 아이콘 크기 계산 (버튼 크기의 100%)
-        double w_unit = m_parentWidth / 24.0;
-        double h_unit = m_parentHeight / 24.0;
-        int iconPixelSize = qMin(w_unit * 1.4 * 1.0, h_unit * 1.4 * 1.0);
-        
-        QPixmap scaledPixmap = docPixmap.scaled(iconPixelSize, iconPixelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        docIcon->setPixmap(scaledPixmap);
-        docIcon->setScaledContents(false);
-        docIcon->setAlignment(Qt::AlignCenter);
-        docIcon->setStyleSheet("border-radius: 8px;");
-    }
-    
 
-    
-    // 프로필 버튼
-    QPixmap profilePixmap = QPixmap(":/images/Profile.png");
-    if (profilePixmap.isNull()) profilePixmap = QPixmap("resources/images/Profile.png");
-    
-    if (profilePixmap.isNull()) {
-        loginStatus->clear();
-        loginStatus->setText("USER");
-        loginStatus->setStyleSheet("background-color: #FFFFFF; color: black; font-weight: bold; border-radius: 8px; border: 1px solid #ccc;");
-        loginStatus->setAlignment(Qt::AlignCenter);
-    } else {
-        // 버튼 크기에 비례한 아이콘 크기 계산 (버튼 크기의 100%)
-        double w_unit = m_parentWidth / 24.0;
-        double h_unit = m_parentHeight / 24.0;
-        int iconPixelSize = qMin(w_unit * 1.4 * 1.0, h_unit * 1.4 * 1.0);
-        
-        QPixmap scaledPixmap = profilePixmap.scaled(iconPixelSize, iconPixelSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        loginStatus->setPixmap(scaledPixmap);
-        loginStatus->setScaledContents(false);
-        loginStatus->setAlignment(Qt::AlignCenter);
-        loginStatus->setStyleSheet("border-radius: 8px;");
-    }
-    
-    qDebug() << "버튼 상태 업데이트 완료";
+    // 버튼 크기에 비례한 아이콘 크기 계산 (버튼 크기의 100%)
+    double w_unit = m_parentWidth / 24.0;
+    double h_unit = m_parentHeight / 24.0;
+    int iconPixelSize = qMin(w_unit * 1.4, h_unit * 1.4);
+
+    label->setPixmap(IconCache::scaled(path, QSize(iconPixelSize, iconPixelSize)));
+    label->setScaledContents(false);
+    label->setAlignment(Qt::AlignCenter);
+    const QString iconStyle = QStringLiteral("border-radius: 8px;");
+    if (label->styleSheet() != iconStyle)
+        label->setStyleSheet(iconStyle);
 }
 
 void TopBarWidget::updateLayout(int w, int h)
 {
+    // 같은 크기로 다시 불리면 폰트/아이콘을 다시 만들 필요가 없다
+    if (w == m_parentWidth && h == m_parentHeight)
+        return;
+
     qDebug() << "TopBarWidget 레이아웃 업데이트: " << w << "x" << h;
     
     m_parentWidth = w;
@@ -0,0 +1,147 @@
+// topicrouter.cpp
+#include "mainwindow/topicrouter.h"
+
+struct TopicRouter::Node
+{
+    QHash<QString, Node *> children;   // 일반 단계
+    Node      *plus = nullptr;         // '+'
+    QList<int> hashRoutes;             // 이 단계 뒤의 '#'
+    QList<int> routes;                 // 여기서 끝나는 필터
+
+    ~Node()
+    {
+        qDeleteAll(children);
+        delete plus;
+    }
+
+    bool isEmpty() const
+    {
+        return children.isEmpty() && !plus && hashRoutes.isEmpty() && routes.isEmpty();
+    }
+};
+
+TopicRouter::TopicRouter()
+    : root_(std::make_unique<Node>())
+{
+}
+
+TopicRouter::~TopicRouter() = default;
+
+bool TopicRouter::isValidFilter(const QString &filter)
+{
+    if (filter.isEmpty())
+        return false;
+    const QStringList levels = filter.split('/');
+    for (int i = 0; i < levels.size(); ++i) {
+        const QString &level = levels.at(i);
+        if (level.contains('#') && (level != "#" || i != levels.size() - 1))
+            return false;
+        if (level.contains('+') && level != "+")
+            return false;
+    }
+    return true;
+}
+
+bool TopicRouter::addRoute(const QString &filter, int route)
+{
+    if (!isValidFilter(filter))
+        return false;
+
+    Node *node = root_.get();
+    const QStringList levels = filter.split('/');
+    for (const QString &level : levels) {
+        if (level == "#") {
+            node->hashRoutes.append(route);
+            ++routeCount_;
+            return true;
+        }
+        if (level == "+") {
+            if (!node->plus)
+                node->plus = new Node;
+            node = node->plus;
+            continue;
+        }
+        Node *&child = node->children[level];
+        if (!child)
+            child = new Node;
+        node = child;
+    }
+    node->routes.append(route);
+    ++routeCount_;
+    return true;
+}
+
+bool TopicRouter::removeFrom(Node *node, int route)
+{
+    bool removed = node->routes.removeAll(route) > 0;
+    removed |= node->hashRoutes.removeAll(route) > 0;
+
+    if (node->plus) {
+        removed |= removeFrom(node->plus, route);
+        if (node->plus->isEmpty()) {
+            delete node->plus;
+            node->plus = nullptr;
+        }
+    }
+    for (auto it = node->children.begin(); it != node->children.end();) {
+        removed |= removeFrom(it.value(), route);
+        if (it.value()->isEmpty()) {
+            delete it.value();
+            it = node->children.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+void TopicRouter::removeRoute(int route)
+{
+    if (removeFrom(root_.get(), route))
+        --routeCount_;
+}
+
+void TopicRouter::match(QStringView topic, QList<TopicMatch> &out) const
+{
+    if (topic.isEmpty() || routeCount_ == 0)
+        return;
+
+    QList<QStringView> levels;
+    levels.reserve(8);
+    for (QStringView level : topic.tokenize(u'/'))
+        levels.append(level);
+
+    QStringList captures;
+    matchLevel(root_.get(), levels, 0, captures, out);
+}
+
+void TopicRouter::matchLevel(const Node *node, const QList<QStringView> &levels, int index,
+                             QStringList &captures, QList<TopicMatch> &out) const
+{
+    // '$' 로 시작하는 시스템 토픽은 첫 단계 와일드카드와 맞지 않는다 (MQTT 규칙)
+    const bool systemTopic = (index == 0 && levels.first().startsWith(u'$'));
+
+    // "a/#" 는 "a" 자신과도 일치
+    if (!systemTopic) {
+        for (int route : node->hashRoutes)
+            out.append({route, captures});
+    }
+
+    if (index == levels.size()) {
+        for (int route : node->routes)
+            out.append({route, captures});
+        return;
+    }
+
+    // 조회용 키는 복사 없이 원본 토픽을 가리킨다
+    const QStringView level = levels.at(index);
+    const QString key = QString::fromRawData(level.data(), level.size());
+    if (const auto it = node->children.constFind(key); it != node->children.constEnd())
+        matchLevel(it.value(), levels, index + 1, captures, out);
+
+    if (node->plus && !systemTopic) {
+        captures.append(level.toString());
+        matchLevel(node->plus, levels, index + 1, captures, out);
+        captures.removeLast();
+    }
+}
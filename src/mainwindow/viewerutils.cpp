@@ -0,0 +1,22 @@
+#include "mainwindow/viewerutils.h"
+#include <QShortcut>
+#include <QWidget>
+
+const QRegularExpression &htmlTagRegex()
+{
+    static const QRegularExpression re("<[^>]*>");
+    return re;
+}
+
+void addNavigationShortcuts(QWidget *view, const std::function<void(int step)> &navigate)
+{
+    const std::pair<Qt::Key, int> keys[] = {
+        {Qt::Key_Left, -1}, {Qt::Key_Up, -1}, {Qt::Key_PageUp, -1},
+        {Qt::Key_Right, 1}, {Qt::Key_Down, 1}, {Qt::Key_PageDown, 1},
+    };
+    for (const auto &[key, step] : keys) {
+        auto *shortcut = new QShortcut(QKeySequence(key), view);
+        QObject::connect(shortcut, &QShortcut::activated, view,
+                         [navigate, step = step]() { navigate(step); });
+    }
+}
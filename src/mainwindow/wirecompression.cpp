@@ -0,0 +1,86 @@
+// wirecompression.cpp
+#include "mainwindow/wirecompression.h"
+#include "mainwindow/metricsregistry.h"
+#include <QElapsedTimer>
+#include <QtEndian>
+
+void WireFrameReader::reset()
+{
+    buffer_.clear();
+    framed_ = false;
+    error_.clear();
+}
+
+QByteArray WireFrameReader::enableFraming(const char *pending, qsizetype size)
+{
+    framed_ = true;
+    // read() 에서 평문으로 집계했던 몫을 되돌리고 프레임으로 다시 해석
+    stats_.payloadBytesIn -= quint64(size);
+    return unframe(pending, size);
+}
+
+void WireFrameReader::addBytesOut(qint64 n)
+{
+    if (n <= 0)
+        return;
+    stats_.bytesOut += quint64(n);
+    MetricsRegistry::add(MetricsRegistry::WireBytesOut, quint64(n));
+}
+
+QByteArray WireFrameReader::read(const QByteArray &wire)
+{
+    stats_.wireBytesIn += quint64(wire.size());
+    MetricsRegistry::add(MetricsRegistry::WireBytesIn, quint64(wire.size()));
+    if (!framed_) {
+        stats_.payloadBytesIn += quint64(wire.size());
+        return wire;
+    }
+    return unframe(wire.constData(), wire.size());
+}
+
+QByteArray WireFrameReader::unframe(const char *data, qsizetype size)
+{
+    QByteArray out;
+    if (hasError())
+        return out;
+
+    buffer_.append(data, size);
+    qsizetype pos = 0;
+    while (buffer_.size() - pos >= WireCompression::HeaderSize) {
+        const char type = buffer_.at(pos);
+        const quint32 len = qFromBigEndian<quint32>(buffer_.constData() + pos + 1);
+        if (buffer_.size() - pos - WireCompression::HeaderSize < qsizetype(len))
+            break;
+
+        const char *payload = buffer_.constData() + pos + WireCompression::HeaderSize;
+        if (type == WireCompression::RawFrame) {
+            out.append(payload, len);
+            ++stats_.rawFrames;
+        } else if (type == WireCompression::DeflateFrame) {
+            QElapsedTimer timer;
+            timer.start();
+            const QByteArray plain = qUncompress(reinterpret_cast<const uchar *>(payload), qsizetype(len));
+            const qint64 inflateNs = timer.nsecsElapsed();
+            stats_.inflateNs += inflateNs;
+            MetricsRegistry::recordUs(MetricsRegistry::WireInflate, inflateNs / 1000);
+            MetricsRegistry::add(MetricsRegistry::WireDeflatedBytes, len);
+            MetricsRegistry::add(MetricsRegistry::WireInflatedBytes, quint64(plain.size()));
+            if (plain.isEmpty() && len > 4) {
+                error_ = QStringLiteral("압축 해제 실패");
+                buffer_.clear();
+                return out;
+            }
+            out.append(plain);
+            ++stats_.compressedFrames;
+        } else {
+            error_ = QStringLiteral("알 수 없는 프레임 형식: 0x%1")
+                         .arg(quint8(type), 2, 16, QLatin1Char('0'));
+            buffer_.clear();
+            return out;
+        }
+        pos += WireCompression::HeaderSize + len;
+    }
+    buffer_.remove(0, pos);
+    stats_.payloadBytesIn += quint64(out.size());
+    return out;
+}
@@ -0,0 +1,183 @@
+// ziparchivewriter.cpp
+#include "mainwindow/ziparchivewriter.h"
+#include <QtEndian>
+#include <array>
+
+namespace {
+
+constexpr quint32 kLocalHeaderSig   = 0x04034b50;
+constexpr quint32 kCentralHeaderSig = 0x02014b50;
+constexpr quint32 kEndOfCentralSig  = 0x06054b50;
+constexpr quint16 kVersion          = 20;       // 2.0
+constexpr quint16 kFlagUtf8Name     = 1 << 11;  // 파일명 UTF-8 (한글 파일명)
+constexpr quint64 kMaxOffset        = 0xFFFFFFFFull;
+
+void put16(QByteArray &out, quint16 v)
+{
+    char b[2];
+    qToLittleEndian(v, b);
+    out.append(b, 2);
+}
+
+void put32(QByteArray &out, quint32 v)
+{
+    char b[4];
+    qToLittleEndian(v, b);
+    out.append(b, 4);
+}
+
+// ZIP 은 MS-DOS 형식 시각을 쓴다 (1980년 이전은 표현 불가)
+void toDosDateTime(const QDateTime &dt, quint16 &time, quint16 &date)
+{
+    const QDate d = dt.date();
+    const QTime t = dt.time();
+    if (!dt.isValid() || d.year() < 1980) {
+        time = 0;
+        date = (1 << 5) | 1;   // 1980-01-01
+        return;
+    }
+    time = quint16((t.hour() << 11) | (t.minute() << 5) | (t.second() / 2));
+    date = quint16(((d.year() - 1980) << 9) | (d.month() << 5) | d.day());
+}
+
+} // namespace
+
+quint32 ZipArchiveWriter::crc32(const char *data, qsizetype size)
+{
+    static const std::array<quint32, 256> table = []() {
+        std::array<quint32, 256> t{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (qsizetype i = 0; i < size; ++i)
+        crc = table[(crc ^ quint8(data[i])) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+ZipArchiveWriter::ZipArchiveWriter(const QString &path)
+    : file_(path)
+{
+}
+
+bool ZipArchiveWriter::open()
+{
+    if (!file_.open(QIODevice::WriteOnly)) {
+        error_ = file_.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ZipArchiveWriter::writeBytes(const QByteArray &bytes)
+{
+    if (file_.write(bytes) != bytes.size()) {
+        error_ = file_.errorString();
+        return false;
+    }
+    offset_ += quint64(bytes.size());
+    return true;
+}
+
+bool ZipArchiveWriter::addFile(const QString &name, const QByteArray &data, const QDateTime &modified)
+{
+    if (!error_.isEmpty())
+        return false;
+    if (entries_.size() >= 0xFFFF
+        || offset_ + quint64(data.size()) + 30 + quint64(name.size()) * 4 > kMaxOffset) {
+        error_ = QStringLiteral("ZIP 크기 제한(4GB/65535개)을 넘었습니다");
+        return false;
+    }
+
+    Entry e;
+    e.name   = name.toUtf8();
+    e.crc    = crc32(data.constData(), data.size());
+    e.size   = quint32(data.size());
+    e.offset = quint32(offset_);
+    toDosDateTime(modified, e.dosTime, e.dosDate);
+
+    QByteArray header;
+    header.reserve(30 + e.name.size());
+    put32(header, kLocalHeaderSig);
+    put16(header, kVersion);
+    put16(header, kFlagUtf8Name);
+    put16(header, 0);               // stored
+    put16(header, e.dosTime);
+    put16(header, e.dosDate);
+    put32(header, e.crc);
+    put32(header, e.size);          // 압축 크기
+    put32(header, e.size);          // 원본 크기
+    put16(header, quint16(e.name.size()));
+    put16(header, 0);               // extra 길이
+    header.append(e.name);
+
+    if (!writeBytes(header) || !writeBytes(data))
+        return false;
+    entries_.append(e);
+    return true;
+}
+
+bool ZipArchiveWriter::finish()
+{
+    if (!error_.isEmpty()) {
+        abort();
+        return false;
+    }
+
+    const quint64 centralStart = offset_;
+    QByteArray central;
+    for (const Entry &e : std::as_const(entries_)) {
+        put32(central, kCentralHeaderSig);
+        put16(central, kVersion);   // made by
+        put16(central, kVersion);   // needed
+        put16(central, kFlagUtf8Name);
+        put16(central, 0);
+        put16(central, e.dosTime);
+        put16(central, e.dosDate);
+        put32(central, e.crc);
+        put32(central, e.size);
+        put32(central, e.size);
+        put16(central, quint16(e.name.size()));
+        put16(central, 0);          // extra
+        put16(central, 0);          // comment
+        put16(central, 0);          // disk
+        put16(central, 0);          // internal attr
+        put32(central, 0);          // external attr
+        put32(central, e.offset);
+        central.append(e.name);
+    }
+    if (centralStart + quint64(central.size()) > kMaxOffset) {
+        error_ = QStringLiteral("ZIP 크기 제한(4GB/65535개)을 넘었습니다");
+        abort();
+        return false;
+    }
+
+    const quint32 centralSize = quint32(central.size());
+    put32(central, kEndOfCentralSig);
+    put16(central, 0);
+    put16(central, 0);
+    put16(central, quint16(entries_.size()));
+    put16(central, quint16(entries_.size()));
+    put32(central, centralSize);
+    put32(central, quint32(centralStart));
+    put16(central, 0);                               // comment
+
+    if (!writeBytes(central) || !file_.commit()) {
+        if (error_.isEmpty())
+            error_ = file_.errorString();
+        return false;
+    }
+    return true;
+}
+
+void ZipArchiveWriter::abort()
+{
+    file_.cancelWriting();
+    file_.commit();   // cancelWriting 후 commit 은 임시 파일만 지운다
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+QuadQT MQTT 수신 부하 테스트용 발행기
+지정한 속도(기본 10,000건/초)로 알림 payload 를 발행해 클라이언트 수신 처리량을 확인합니다.
+클라이언트는 5초마다 "[MQTT] 수신 N 건/초, 최대 묶음, 버림" 로그를 남깁니다.
+
+사용법:
+    pip install paho-mqtt
+    python3 mqtt_burst_publisher.py --host 127.0.0.1 --topic alert --rate 10000 --seconds 10
+
+이미지 없는 경보 확인:
+    python3 mqtt_burst_publisher.py --rate 5 --seconds 2 --no-image
+    이미지 경로가 없는 payload 도 히스토리 표(기본 조회)의 맨 위에 나타나야 합니다.
+"""
+
+import argparse
+import json
+import sys
+import time
+from datetime import datetime
+
+try:
+    import paho.mqtt.client as mqtt
+except ImportError:
+    print("paho-mqtt 가 필요합니다: pip install paho-mqtt")
+    sys.exit(1)
+
+
+def make_payload(seq, with_image=True):
+    # include/mainwindow/mqttevent.h 의 decode 가 읽는 키
+    event = seq % 3
+    now = datetime.now()
+    stamp = now.strftime("%Y%m%d_%H%M%S")
+    payload = {
+        "id": 1_000_000 + seq,
+        "event": event,
+        "timestamp": now.isoformat(timespec="seconds"),
+        "plate": f"{seq % 100:02d}가{seq % 10000:04d}",
+    }
+    if with_image:
+        payload["image"] = f"/images/event_{event}_{stamp}_{seq}.jpg"
+    if event == 1:
+        payload["speed"] = 40 + seq % 60
+    return json.dumps(payload).encode("utf-8")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="QuadQT MQTT 부하 발행기")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--topic", default="alert")
+    parser.add_argument("--rate", type=int, default=10000, help="초당 발행 건수")
+    parser.add_argument("--seconds", type=int, default=10, help="발행 시간(초)")
+    parser.add_argument("--qos", type=int, default=0, choices=(0, 1, 2))
+    parser.add_argument("--no-image", action="store_true",
+                        help="이미지 경로 없이 발행 (시각은 timestamp 로만 전달)")
+    args = parser.parse_args()
+
+    client = mqtt.Client()
+    client.connect(args.host, args.port)
+    client.loop_start()
+
+    total = args.rate * args.seconds
+    interval = 1.0 / args.rate
+    batch = max(1, args.rate // 100)   # 10ms 단위로 몰아서 발행
+    start = time.perf_counter()
+
+    print(f"[부하] {args.host}:{args.port} '{args.topic}' 에 {args.rate}건/초로 {total}건 발행")
+    for seq in range(total):
+        client.publish(args.topic, make_payload(seq, not args.no_image), qos=args.qos)
+        if (seq + 1) % batch == 0:
+            # 목표 속도보다 앞서 있으면 대기
+            ahead = start + (seq + 1) * interval - time.perf_counter()
+            if ahead > 0:
+                time.sleep(ahead)
+
+    elapsed = time.perf_counter() - start
+    client.loop_stop()
+    client.disconnect()
+    print(f"[부하] 완료: {total}건 / {elapsed:.2f}초 = {total / elapsed:.0f}건/초")
+
+
+if __name__ == "__main__":
+    main()
@@ -10,6 +10,227 @@ import threading
 import json
 import re
 import os
+import struct
+import sys
+import time
+import zlib
+from datetime import datetime, timedelta
+
+# 바이너리 히스토리 wire 형식 (include/mainwindow/historywire.h 참고)
+WIRE_NAME = "bin1"
+WIRE_MAGIC = b"\xb1H"
+TAG_DICT, TAG_ROW, TAG_END = 0x01, 0x02, 0x03
+FLAG_SPEED, FLAG_TIMESTAMP, FLAG_RAW_DATE = 0x01, 0x02, 0x04
+DATE_FORMAT = "%Y-%m-%d %H:%M:%S"
+# --json-only: bin1 을 제안받아도 JSON 으로 응답 (클라이언트 디코드 시간 비교용)
+OFFER_WIRE = True
+# --history-rows N: 서버가 가진 히스토리 건수 (CSV 내보내기 페이지 확인용)
+HISTORY_ROWS = 5000
+
+# 응답 압축 (include/mainwindow/wirecompression.h 참고)
+COMPRESS_NAME = "deflate"
+FRAME_RAW, FRAME_DEFLATE = b"R", b"Z"
+EPOCH = datetime(1970, 1, 1)
+
+
+def put_varint(out, value):
+    while True:
+        b = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return
+
+
+def get_varint(buf, pos):
+    result = shift = 0
+    while True:
+        b = buf[pos]
+        pos += 1
+        result |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return result, pos
+        shift += 7
+
+
+def zigzag(value):
+    return (value << 1) ^ (value >> 63)
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def put_bytes(out, data):
+    put_varint(out, len(data))
+    out += data
+
+
+def encode_history_binary(rows, code=200, message="History retrieved successfully"):
+    """히스토리 레코드를 bin1 프레임으로 인코딩"""
+    out = bytearray(WIRE_MAGIC)
+    prefixes = {}
+    prev_id = prev_ts = 0
+
+    def put_path(body, path):
+        path = path or ""
+        cut = path.rfind("/") + 1
+        prefix, suffix = path[:cut], path[cut:]
+        if not prefix:
+            put_varint(body, 0)
+        else:
+            if prefix not in prefixes:
+                prefixes[prefix] = len(prefixes) + 1
+                out.append(TAG_DICT)
+                put_varint(out, prefixes[prefix])
+                put_bytes(out, prefix.encode("utf-8"))
+            put_varint(body, prefixes[prefix])
+        put_bytes(body, suffix.encode("utf-8"))
+
+    for row in rows:
+        body = bytearray()
+        put_varint(body, zigzag(row["id"] - prev_id))
+        prev_id = row["id"]
+        event_type = row.get("event_type")
+        body.append(0xFF if event_type is None or event_type < 0 else event_type)
+
+        flags = 0
+        ts = None
+        date = row.get("date") or ""
+        try:
+            ts = int((datetime.strptime(date, DATE_FORMAT) - EPOCH).total_seconds())
+            flags |= FLAG_TIMESTAMP
+        except ValueError:
+            if date:
+                flags |= FLAG_RAW_DATE
+        speed = row.get("speed")
+        if isinstance(speed, (int, float)):
+            flags |= FLAG_SPEED
+        body.append(flags)
+
+        if flags & FLAG_TIMESTAMP:
+            put_varint(body, zigzag(ts - prev_ts))
+            prev_ts = ts
+        elif flags & FLAG_RAW_DATE:
+            put_bytes(body, date.encode("utf-8"))
+        if flags & FLAG_SPEED:
+            put_varint(body, int(round(speed * 100)))
+
+        put_path(body, row.get("image_path"))
+        put_path(body, row.get("start_snapshot"))
+        put_path(body, row.get("end_snapshot"))
+        put_bytes(body, (row.get("plate_number") or "").encode("utf-8"))
+
+        out.append(TAG_ROW)
+        put_bytes(out, body)
+
+    out.append(TAG_END)
+    put_varint(out, code)
+    put_bytes(out, message.encode("utf-8"))
+    return bytes(out)
+
+
+def decode_history_binary(buf):
+    """encode_history_binary 의 역변환 (클라이언트 HistoryWireDecoder 와 같은 동작)"""
+    assert buf[:2] == WIRE_MAGIC
+    pos = 2
+    prefixes = [""]
+    rows = []
+    prev_id = prev_ts = 0
+
+    def get_str(pos):
+        n, pos = get_varint(buf, pos)
+        return buf[pos:pos + n].decode("utf-8"), pos + n
+
+    def get_path(pos):
+        dict_id, pos = get_varint(buf, pos)
+        suffix, pos = get_str(pos)
+        return prefixes[dict_id] + suffix, pos
+
+    while True:
+        tag = buf[pos]
+        pos += 1
+        if tag == TAG_DICT:
+            _, pos = get_varint(buf, pos)
+            prefix, pos = get_str(pos)
+            prefixes.append(prefix)
+        elif tag == TAG_ROW:
+            _, pos = get_varint(buf, pos)
+            row = {}
+            delta, pos = get_varint(buf, pos)
+            prev_id += unzigzag(delta)
+            row["id"] = prev_id
+            event_type, flags = buf[pos], buf[pos + 1]
+            pos += 2
+            row["event_type"] = -1 if event_type == 0xFF else event_type
+            if flags & FLAG_TIMESTAMP:
+                delta, pos = get_varint(buf, pos)
+                prev_ts += unzigzag(delta)
+                row["date"] = (EPOCH + timedelta(seconds=prev_ts)).strftime(DATE_FORMAT)
+            elif flags & FLAG_RAW_DATE:
+                row["date"], pos = get_str(pos)
+            if flags & FLAG_SPEED:
+                centi, pos = get_varint(buf, pos)
+                row["speed"] = centi / 100.0
+            row["image_path"], pos = get_path(pos)
+            row["start_snapshot"], pos = get_path(pos)
+            row["end_snapshot"], pos = get_path(pos)
+            row["plate_number"], pos = get_str(pos)
+            rows.append(row)
+        elif tag == TAG_END:
+            code, pos = get_varint(buf, pos)
+            message, pos = get_str(pos)
+            return {"status": "success" if code == 200 else "error",
+                    "code": code, "message": message, "data": rows}
+        else:
+            raise ValueError(f"unknown tag {tag:#x}")
+
+
+def frame_response(payload, min_bytes):
+    """압축 협상된 세션의 응답 프레임. 작거나 이득이 없으면 원본 그대로"""
+    if len(payload) >= min_bytes:
+        t0 = time.perf_counter()
+        body = struct.pack(">I", len(payload)) + zlib.compress(payload, 6)
+        elapsed = (time.perf_counter() - t0) * 1000
+        if len(body) < len(payload):
+            print(f"[압축] {len(payload)} -> {len(body)} bytes ({elapsed:.2f} ms)")
+            return FRAME_DEFLATE + struct.pack(">I", len(body)) + body
+    return FRAME_RAW + struct.pack(">I", len(payload)) + payload
+
+
+def unframe_response(frame):
+    kind, size = frame[:1], struct.unpack(">I", frame[1:5])[0]
+    body = frame[5:5 + size]
+    return zlib.decompress(body[4:]) if kind == FRAME_DEFLATE else body
+
+
+def make_history_rows(count, event_type=None):
+    """테스트용 히스토리 레코드 생성 (실제 서버와 같은 키/경로 형태)"""
+    kinds = ["parking", "speed", "pedestrian"]
+    base = datetime(2025, 7, 2, 15, 30, 0)
+    rows = []
+    for i in range(count):
+        et = event_type if event_type is not None else i % 3
+        when = base - timedelta(seconds=37 * i)
+        stamp = when.strftime("%Y%m%d_%H%M%S")
+        row = {
+            "id": count - i,
+            "event_type": et,
+            "date": when.strftime(DATE_FORMAT),
+            "image_path": f"/home/pi/quad/snapshots/{kinds[et]}/{stamp}_{i:05d}.jpg",
+            "plate_number": f"{12 + i % 80}가{1000 + i % 9000}",
+            "speed": round(40 + (i % 50) * 0.7, 2) if et == 1 else None,
+            "start_snapshot": None,
+            "end_snapshot": None,
+        }
+        if et == 0:
+            later = (when + timedelta(minutes=1)).strftime("%Y-%m-%d_%H-%M-%S")
+            row["start_snapshot"] = f"/home/pi/quad/snapshots/parking/start/{stamp}.jpg"
+            row["end_snapshot"] = f"/home/pi/quad/snapshots/parking/end/{stamp}_{later}.jpg"
+        rows.append(row)
+    return rows
 
 class SSLLoginServer:
     def __init__(self, host='127.0.0.1', port=8080):
@@ -108,18 +329,40 @@ class SSLLoginServer:
     
     def handle_client(self, client_socket, address):
         """클라이언트 요청 처리"""
+        session = {"wire": "json", "compress_min": None}
+        pending = b""
         try:
             while True:
-                data = client_socket.recv(1024).decode('utf-8').strip()
-                if not data:
+                chunk = client_socket.recv(1024)
+                if not chunk:
                     break
-                
-                print(f"[수신] {address}: {data}")
-                response = self.process_command(data)
-                
-                if response:
-                    client_socket.send(response.encode('utf-8'))
-                    print(f"[송신] {address}: {response}")
+                pending += chunk
+
+                # 명령은 줄 단위
+                while b"\n" in pending:
+                    line, pending = pending.split(b"\n", 1)
+                    data = line.decode('utf-8').strip()
+                    if not data:
+                        continue
+
+                    print(f"[수신] {address}: {data}")
+                    response = self.process_command(data, session)
+
+                    if not response:
+                        continue
+                    if isinstance(response, bytes):
+                        print(f"[송신] {address}: <binary {len(response)} bytes>")
+                    else:
+                        print(f"[송신] {address}: {response[:200]}")
+                        response = (response + "\n").encode('utf-8')
+
+                    if session["compress_min"] is not None:
+                        response = frame_response(response, session["compress_min"])
+                    client_socket.sendall(response)
+
+                    # HELLO 응답 자체는 평문, 그 다음 응답부터 프레임 적용
+                    if "compress_next" in session:
+                        session["compress_min"] = session.pop("compress_next")
                     
         except Exception as e:
             print(f"[오류] 클라이언트 처리 실패 {address}: {e}")
@@ -127,23 +370,29 @@ class SSLLoginServer:
             client_socket.close()
             print(f"[연결] 종료: {address}")
     
-    def process_command(self, command):
+    def process_command(self, command, session=None):
         parts = command.split()
         if len(parts) < 1:
             return self.error_response(400, "Invalid command format")
+        if session is None:
+            session = {"wire": "json", "compress_min": None}
         
         cmd = parts[0].upper()
         
-        if cmd == "REGISTER":
+        if cmd == "HELLO":
+            return self.handle_hello(parts[1:], session)
+        elif cmd == "REGISTER":
             return self.handle_register(parts[1:])
         elif cmd == "LOGIN":
             return self.handle_login(parts[1:])
         elif cmd == "RESET_PASSWORD":
             return self.handle_reset_password(parts[1:])
-        elif cmd == "GET_HISTORY":
-            return self.handle_get_history(parts[1:])
+        elif cmd.startswith("GET_HISTORY"):
+            return self.handle_get_history(cmd, parts[1:], session)
         elif cmd == "ADD_HISTORY":
             return self.handle_add_history(parts[1:])
+        elif cmd == "GET_IMAGE":
+            return self.handle_get_image(parts[1:])
         elif cmd == "GET_FRAME":
             return self.handle_get_frame()
         elif cmd == "CHANGE_FRAME":
@@ -153,6 +402,18 @@ class SSLLoginServer:
         else:
             return self.error_response(400, "Unknown command")
     
+    def handle_hello(self, args, session):
+        """클라이언트 지원 기능 협상 (wire=bin1)"""
+        options = dict(a.split("=", 1) for a in args if "=" in a)
+        wanted = options.get("wire", "").split(",")
+        session["wire"] = WIRE_NAME if OFFER_WIRE and WIRE_NAME in wanted else "json"
+        response = json.loads(self.success_response(200, "HELLO"))
+        response["wire"] = session["wire"]
+        if COMPRESS_NAME in options.get("compress", "").split(","):
+            session["compress_next"] = max(0, int(options.get("compress_min", 512)))
+            response["compress"] = COMPRESS_NAME
+        return json.dumps(response)
+
     def handle_register(self, args):
         """사용자 등록 처리"""
         if len(args) != 2:
@@ -200,19 +461,41 @@ class SSLLoginServer:
         print(f"[비밀번호] 재설정: {email}")
         return self.success_response(200, "Password reset successful")
     
-    def handle_get_history(self, args):
-        """히스토리 조회 처리 (테스트용 더미 데이터)"""
-        history_data = {
-            "histories": [
-                {"id": 1, "date": "2024-01-01", "event": "Login", "user": args[0] if args else "test@example.com"},
-                {"id": 2, "date": "2024-01-02", "event": "Logout", "user": args[0] if args else "test@example.com"}
-            ]
-        }
-        response = self.success_response(200, "History retrieved successfully")
-        response_dict = json.loads(response)
-        response_dict.update(history_data)
-        return json.dumps(response_dict)
+    def handle_get_history(self, cmd, args, session):
+        """히스토리 조회 처리 (테스트용 더미 데이터)
+        GET_HISTORY email limit offset
+        GET_HISTORY_BY_EVENT_TYPE email type limit offset
+        GET_HISTORY_BY_DATE_RANGE email start end limit offset
+        GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE email type start end limit offset
+        """
+        try:
+            event_type = int(args[1]) if "EVENT_TYPE" in cmd else None
+            limit, offset = int(args[-2]), int(args[-1])
+        except (IndexError, ValueError):
+            return self.error_response(400, "Invalid history arguments")
+
+        # 전체 HISTORY_ROWS 건 중 한 페이지 (id 가 페이지와 관계없이 같도록 전체 기준으로 만든다)
+        rows = make_history_rows(HISTORY_ROWS, event_type)[offset:offset + limit]
+        message = "History retrieved successfully"
+        if session.get("wire") == WIRE_NAME:
+            return encode_history_binary(rows, 200, message)
+
+        response_dict = json.loads(self.success_response(200, message))
+        response_dict["data"] = rows
+        return json.dumps(response_dict, ensure_ascii=False)
     
+    def handle_get_image(self, args):
+        """이미지 조회 처리 (테스트용 더미 JPEG)
+        GET_IMAGE path -> u64 big-endian 크기 + 데이터.
+        연결을 끊지 않으므로 한 연결에서 여러 요청을 이어 보낼 수 있다.
+        """
+        if len(args) != 1:
+            return self.error_response(400, "Image path is missing")
+        seed = zlib.crc32(args[0].encode("utf-8"))
+        body = bytes((seed + i) & 0xFF for i in range(48 * 1024))
+        data = b"\xff\xd8\xff\xe0" + body + b"\xff\xd9"
+        return struct.pack(">Q", len(data)) + data
+
     def handle_add_history(self, args):
         """히스토리 추가 처리"""
         print(f"[히스토리] 추가: {' '.join(args)}")
@@ -270,6 +553,40 @@ class SSLLoginServer:
         }
         return json.dumps(response)
 
+def bench_wire(rows=10000):
+    """JSON / bin1 형식과 압축 프레임의 전송 바이트 비교.
+    디코딩 시간은 재지 않는다: 여기 디코더는 인코더 검증용 Python 구현이라
+    클라이언트(C++ HistoryWireDecoder)의 성능과 무관하다.
+    클라이언트의 실제 디코드 시간은 진단 페이지(F12)의 "히스토리 응답 디코드" 행에서
+    형식별로 비교한다 (--json-only 로 서버를 띄우면 JSON 쪽 값이 쌓인다)."""
+    data = make_history_rows(rows)
+    as_json = (json.dumps({"status": "success", "code": 200,
+                           "message": "History retrieved successfully",
+                           "data": data}, ensure_ascii=False) + "\n").encode("utf-8")
+    as_bin = encode_history_binary(data)
+
+    # 왕복 확인 (바이너리에는 null 이 없어 빈 문자열/키 없음으로 돌아온다)
+    for src, got in zip(data, decode_history_binary(as_bin)["data"]):
+        for key, value in src.items():
+            assert got.get(key) == value or (value is None and not got.get(key)), (key, src, got)
+
+    print(f"rows: {rows}")
+    print(f"json : {len(as_json):>9} bytes")
+    print(f"bin1 : {len(as_bin):>9} bytes  ({len(as_bin) / len(as_json):.0%} of json)")
+
+    # 압축 프레임 (HELLO compress=deflate)
+    for name, payload in (("json", as_json), ("bin1", as_bin)):
+        frame = frame_response(payload, 0)
+        assert unframe_response(frame) == payload
+        print(f"{name}+deflate: {len(frame):>9} bytes  ({len(frame) / len(as_json):.0%} of json)")
+
+
 if __name__ == "__main__":
-    server = SSLLoginServer()
-    server.start()
\ No newline at end of file
+    if len(sys.argv) > 1 and sys.argv[1] == "--bench-wire":
+        bench_wire(int(sys.argv[2]) if len(sys.argv) > 2 else 10000)
+    else:
+        OFFER_WIRE = "--json-only" not in sys.argv
+        if "--history-rows" in sys.argv:
+            HISTORY_ROWS = int(sys.argv[sys.argv.index("--history-rows") + 1])
+        server = SSLLoginServer()
+        server.start()
\ No newline at end of file
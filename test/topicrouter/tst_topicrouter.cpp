@@ -0,0 +1,158 @@
+// tst_topicrouter.cpp
+#include "mainwindow/topicrouter.h"
+#include <QtTest>
+#include <algorithm>
+
+namespace {
+
+// 일치한 경로 id (정렬)
+QList<int> routesFor(const TopicRouter &router, const QString &topic)
+{
+    QList<TopicMatch> matches;
+    router.match(topic, matches);
+    QList<int> routes;
+    for (const TopicMatch &m : std::as_const(matches))
+        routes.append(m.route);
+    std::sort(routes.begin(), routes.end());
+    return routes;
+}
+
+} // namespace
+
+class TestTopicRouter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void validFilter_data();
+    void validFilter();
+    void match_data();
+    void match();
+    void captures();
+    void multipleRoutes();
+    void removeRoute();
+};
+
+void TestTopicRouter::validFilter_data()
+{
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("plain")        << "alert"                     << true;
+    QTest::newRow("plus")         << "site/+/camera"             << true;
+    QTest::newRow("hash")         << "site/#"                    << true;
+    QTest::newRow("hash only")    << "#"                         << true;
+    QTest::newRow("plus only")    << "+"                         << true;
+    QTest::newRow("camera event") << "site/+/camera/+/event/#"   << true;
+    QTest::newRow("empty")        << ""                          << false;
+    QTest::newRow("hash middle")  << "site/#/camera"             << false;
+    QTest::newRow("hash partial") << "site/cam#"                 << false;
+    QTest::newRow("plus partial") << "site/cam+"                 << false;
+}
+
+void TestTopicRouter::validFilter()
+{
+    QFETCH(QString, filter);
+    QFETCH(bool, valid);
+
+    QCOMPARE(TopicRouter::isValidFilter(filter), valid);
+    TopicRouter router;
+    QCOMPARE(router.addRoute(filter, 1), valid);
+    QCOMPARE(router.isEmpty(), !valid);
+}
+
+void TestTopicRouter::match_data()
+{
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<QString>("topic");
+    QTest::addColumn<bool>("matches");
+
+    // '+' 는 정확히 한 단계
+    QTest::newRow("+ one level")        << "a/+/c"   << "a/b/c"     << true;
+    QTest::newRow("+ empty level")      << "a/+/c"   << "a//c"      << true;
+    QTest::newRow("+ not two levels")   << "a/+/c"   << "a/b/x/c"   << false;
+    QTest::newRow("+ not zero levels")  << "a/+/c"   << "a/c"       << false;
+    QTest::newRow("+ last level")       << "a/+"     << "a/b"       << true;
+    QTest::newRow("+ not parent")       << "a/+"     << "a"         << false;
+
+    // '#' 는 나머지 전부, 부모 단계 자신도 포함
+    QTest::newRow("# one level")        << "a/#"     << "a/b"       << true;
+    QTest::newRow("# many levels")      << "a/#"     << "a/b/c/d"   << true;
+    QTest::newRow("# parent level")     << "a/#"     << "a"         << true;
+    QTest::newRow("# not sibling")      << "a/#"     << "ab"        << false;
+    QTest::newRow("# other root")       << "a/#"     << "b/a"       << false;
+    QTest::newRow("# alone")            << "#"       << "x/y/z"     << true;
+    QTest::newRow("+/# parent")         << "a/+/#"   << "a/b"       << true;
+
+    // 일반 단계는 대소문자까지 정확히
+    QTest::newRow("exact")              << "alert"   << "alert"     << true;
+    QTest::newRow("case sensitive")     << "alert"   << "Alert"     << false;
+    QTest::newRow("longer topic")       << "alert"   << "alert/1"   << false;
+
+    // '$' 로 시작하는 토픽은 첫 단계 와일드카드와 맞지 않는다
+    QTest::newRow("$ vs #")             << "#"       << "$SYS/broker" << false;
+    QTest::newRow("$ vs +/#")           << "+/#"     << "$SYS/broker" << false;
+    QTest::newRow("$ vs +/broker")      << "+/broker" << "$SYS/broker" << false;
+    QTest::newRow("$ explicit")         << "$SYS/#"  << "$SYS/broker" << true;
+    QTest::newRow("$ explicit +")       << "$SYS/+"  << "$SYS/broker" << true;
+    QTest::newRow("$ not first level")  << "a/#"     << "a/$b"      << true;
+}
+
+void TestTopicRouter::match()
+{
+    QFETCH(QString, filter);
+    QFETCH(QString, topic);
+    QFETCH(bool, matches);
+
+    TopicRouter router;
+    QVERIFY(router.addRoute(filter, 7));
+    QCOMPARE(routesFor(router, topic), matches ? QList<int>{7} : QList<int>{});
+}
+
+void TestTopicRouter::captures()
+{
+    TopicRouter router;
+    QVERIFY(router.addRoute("site/+/camera/+/event/#", 1));
+
+    QList<TopicMatch> matches;
+    router.match(u"site/s1/camera/cam07/event/2/extra", matches);
+    QCOMPARE(matches.size(), 1);
+    QCOMPARE(matches.first().route, 1);
+    QCOMPARE(matches.first().captures, (QStringList{"s1", "cam07"}));
+}
+
+void TestTopicRouter::multipleRoutes()
+{
+    TopicRouter router;
+    QVERIFY(router.addRoute("site/+/camera/+/event/#", 1));
+    QVERIFY(router.addRoute("site/s1/#", 2));
+    QVERIFY(router.addRoute("site/+/camera/cam07/event/1", 3));
+    QVERIFY(router.addRoute("#", 4));
+    QVERIFY(router.addRoute("alert", 5));
+
+    QCOMPARE(routesFor(router, "site/s1/camera/cam07/event/1"), (QList<int>{1, 2, 3, 4}));
+    QCOMPARE(routesFor(router, "site/s2/camera/cam07/event/2"), (QList<int>{1, 4}));
+    QCOMPARE(routesFor(router, "alert"), (QList<int>{4, 5}));
+}
+
+void TestTopicRouter::removeRoute()
+{
+    TopicRouter router;
+    QVERIFY(router.addRoute("site/+/camera/#", 1));
+    QVERIFY(router.addRoute("site/s1/camera/#", 2));
+
+    router.removeRoute(1);
+    QCOMPARE(routesFor(router, "site/s1/camera/cam01"), QList<int>{2});
+    QVERIFY(!router.isEmpty());
+
+    router.removeRoute(2);
+    QVERIFY(routesFor(router, "site/s1/camera/cam01").isEmpty());
+    QVERIFY(router.isEmpty());
+
+    // 없는 경로를 지워도 상태가 바뀌지 않는다
+    router.removeRoute(3);
+    QVERIFY(router.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestTopicRouter)
+#include "tst_topicrouter.moc"
@@ -0,0 +1,16 @@
+# TopicRouter 토픽 필터 일치 규칙 단위 테스트 (Qt Core 만 사용)
+#   qmake tst_topicrouter.pro && make && ./tst_topicrouter
+QT      += testlib
+QT      -= gui
+CONFIG  += c++17 console testcase
+CONFIG  -= app_bundle
+TARGET   = tst_topicrouter
+
+INCLUDEPATH += ../../include
+
+SOURCES += \
+    tst_topicrouter.cpp \
+    ../../src/mainwindow/topicrouter.cpp
+
+HEADERS += \
+    ../../include/mainwindow/topicrouter.h